@@ -0,0 +1,25 @@
+; disassembler: every addressing type, entries, externs, unnamed labels and data
+
+.entry START
+.entry VALUES
+.extern OUTSIDE
+.extern HELPER
+
+START:	mov	#-12, VALUES
+	cmp	r1, *r2
+	add	OUTSIDE, r3
+	sub	*r4, NEXT
+NEXT:	lea	TEXT, *r5
+	clr	OUTSIDE
+	not	r6
+	inc	*r7
+	jmp	*r1
+	bne	NEXT
+	red	r0
+	prn	#511
+	jsr	HELPER
+	rts
+	stop
+
+TEXT:	.string "ok!"
+VALUES:	.data 1, -1, 16383, -16384
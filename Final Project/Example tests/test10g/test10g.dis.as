@@ -0,0 +1,22 @@
+; The source of test10g, decoded from its object.
+.entry START
+.entry VALUES
+.extern OUTSIDE
+.extern HELPER
+START:	mov #-12, VALUES
+	cmp r1, *r2
+	add OUTSIDE, r3
+	sub *r4, L0111
+L0111:	lea L0132, *r5
+	clr OUTSIDE
+	not r6
+	inc *r7
+	jmp *r1
+	bne L0111
+	red r0
+	prn #511
+	jsr HELPER
+	rts
+	stop
+L0132:	.data 111, 107, 33, 0
+VALUES:	.data 1, -1, 16383, -16384
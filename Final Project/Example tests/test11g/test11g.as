@@ -0,0 +1,20 @@
+; --peephole: instructions that do nothing, an entry on a removed one, externs
+
+.entry MAIN
+.entry SKIP
+.extern OUT
+
+MAIN:	mov	r1, r1
+	cmp	#3, r2
+	inc	r4
+	dec	r4
+	jmp	SKIP
+SKIP:	mov	*r2, *r2
+	add	OUT, r3
+	cmp	r3, COUNT
+	bne	MAIN
+	mov	COUNT, OUT
+	jsr	OUT
+	stop
+
+COUNT:	.data 7
@@ -0,0 +1,23 @@
+; --dce: blocks that can not be reached, with extern references in them
+
+.entry MAIN
+.entry KEEP
+.extern LOG
+.extern LOST
+
+MAIN:	prn	LOG
+	jsr	USED
+	jmp	END
+	prn	LOST
+	mov	LOG, r1
+UNUSED:	inc	LOST
+	rts
+USED:	dec	r2
+	rts
+KEEP:	jsr	LOG
+	rts
+END:	stop
+	clr	LOG
+	stop
+
+DATA:	.data 3
@@ -0,0 +1,18 @@
+; --thread-jumps with --dce and --peephole: jump chains, one ends at an extern
+
+.entry MAIN
+.extern FAR
+
+MAIN:	cmp	r1, r2
+	bne	B1
+	jsr	J1
+	jmp	J2
+B1:	bne	B2
+	mov	r3, r3
+B2:	prn	r1
+	stop
+J1:	jmp	SUB
+J2:	jmp	J3
+J3:	jmp	FAR
+SUB:	inc	r1
+	rts
@@ -0,0 +1,19 @@
+; binary object: entries, externs, both kinds of labels and data
+
+.entry MAIN
+.entry LIST
+.extern PRINT
+.extern W
+
+MAIN:	mov	LIST, r3
+	add	#5, *r3
+	jsr	PRINT
+	cmp	W, STR
+	bne	END
+	lea	STR, r6
+	prn	#-7
+END:	stop
+
+STR:	.string "abc"
+LIST:	.data 6, -9, 15
+	.data 22
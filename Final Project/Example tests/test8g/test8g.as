@@ -0,0 +1,13 @@
+; main module of the link: calls a subroutine of test8g_lib
+
+.entry MAIN
+.entry COUNT
+.extern ADDUP
+.extern TOTAL
+
+MAIN:	jsr	ADDUP
+	prn	TOTAL
+	prn	COUNT
+	stop
+
+COUNT:	.data 4
@@ -0,0 +1,17 @@
+; library module of the link: adds the numbers of LIST into TOTAL
+
+.entry ADDUP
+.entry TOTAL
+.extern COUNT
+
+ADDUP:	mov	COUNT, r1
+	lea	LIST, r2
+	clr	TOTAL
+LOOP:	add	*r2, TOTAL
+	inc	r2
+	dec	r1
+	bne	LOOP
+	rts
+
+TOTAL:	.data 0
+LIST:	.data 5, -2, 10, 7
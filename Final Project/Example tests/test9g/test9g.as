@@ -0,0 +1,32 @@
+; simulator: a loop, a subroutine, indirect registers and self-modifying code
+
+MAIN:	mov	#5, r1
+	clr	r2
+LOOP:	add	r1, r2
+	dec	r1
+	bne	LOOP
+	prn	r2
+	sub	#20, r2
+	prn	r2
+	mov	#4, r3
+	jsr	TIMES6
+	prn	r5
+	lea	LIST, r6
+	prn	*r6
+	inc	r6
+	add	*r6, *r6
+	prn	*r6
+	lea	PATCH, r4
+	inc	r4
+	mov	#76, *r4
+PATCH:	prn	#1
+	stop
+
+TIMES6:	clr	r5
+	mov	#6, r0
+TLOOP:	add	r3, r5
+	dec	r0
+	bne	TLOOP
+	rts
+
+LIST:	.data -3, 8
@@ -0,0 +1,148 @@
+#include "headers.h"
+
+/*
+* FILE: arena.c
+*
+* This file includes the functions of the arena allocator that is owned by the assembly of one input file.
+* All the nodes of the file (macros, instructions, data and declarations) and their strings are carved one after
+* the other from big blocks of memory, so creating a node costs a few additions instead of a call to malloc,
+* and all the memory of the file is released at once when the work on the file is done.
+*
+*/
+
+/*
+* The function: arenaInit
+*
+* The function initializes an empty arena, the first block is allocated only when the first node is allocated.
+*
+* Parameters:
+*	file_arena - a pointer to the arena to initialize.
+*/
+void arenaInit(arena* file_arena)
+{
+	file_arena->blocks = NULL;
+	file_arena->spare = NULL;
+	file_arena->allocations_amount = 0;
+	file_arena->blocks_bytes = 0;
+}
+
+/*
+* The function: arenaAlloc
+*
+* The function carves a new piece of memory from the current block of the arena, and allocates a new block when
+* the current block is full. A request that is bigger than a block gets a block of its own.
+* A spare block that was kept by arenaReset is used before a new block is allocated.
+*
+* Parameters:
+*	file_arena - a pointer to the arena to allocate from.
+*	size - the amount of bytes to allocate.
+*
+* Returns:
+*	A pointer to the allocated memory, or NULL if a memory allocation failure occurred.
+*/
+void* arenaAlloc(arena* file_arena, size_t size)
+{
+	arenaBlock *block = file_arena->blocks;/*The current block of the arena*/
+	size_t block_size = ARENA_BLOCK_SIZE;/*The size of a new block*/
+	void *memory;/*The allocated memory*/
+
+	/*Round the size up, so every allocation will be aligned for any type*/
+	size = (size + sizeof(arenaAlign) - 1) / sizeof(arenaAlign) * sizeof(arenaAlign);
+
+	if(!block || block->used + size > block->size){/*If there is not enough space in the current block*/
+		if(size > block_size)
+			block_size = size;
+		if(file_arena->spare && block_size == ARENA_BLOCK_SIZE){/*Use a spare block*/
+			block = file_arena->spare;
+			file_arena->spare = block->next;
+		}
+		else{
+			block = (arenaBlock*)malloc(sizeof(arenaBlock) + block_size);
+			if(!block)
+				return NULL;
+			block->size = block_size;
+			file_arena->blocks_bytes += sizeof(arenaBlock) + block_size;
+		}
+		block->used = 0;
+		block->next = file_arena->blocks;
+		file_arena->blocks = block;
+	}
+
+	memory = (char*)(block+1) + block->used;
+	block->used += size;
+	file_arena->allocations_amount++;
+	return memory;
+}
+
+/*
+* The function: arenaStrdup
+*
+* The function copies a string into memory that is allocated from the arena, using only the length of the string.
+*
+* Parameters:
+*	file_arena - a pointer to the arena to allocate from.
+*	str - the string to copy.
+*
+* Returns:
+*	A pointer to the new copy of the string, or NULL if a memory allocation failure occurred.
+*/
+char* arenaStrdup(arena* file_arena, char* str)
+{
+	char *new_str;/*The new copy of the string*/
+
+	new_str = (char*)arenaAlloc(file_arena, strlen(str)+1);
+	if(new_str)
+		strcpy(new_str, str);
+	return new_str;
+}
+
+/*
+* The function: arenaReset
+*
+* The function releases all the nodes of the arena at once, but keeps its blocks of the regular size as spare blocks
+* for the next file, so a server that assembles many files does not allocate them again.
+*
+* Parameters:
+*	file_arena - a pointer to the arena to reset.
+*/
+void arenaReset(arena* file_arena)
+{
+	arenaBlock *temp;/*The next block*/
+
+	while(file_arena->blocks){
+		temp = file_arena->blocks->next;
+		if(file_arena->blocks->size == ARENA_BLOCK_SIZE){/*Keep the block*/
+			file_arena->blocks->next = file_arena->spare;
+			file_arena->spare = file_arena->blocks;
+		}
+		else{
+			file_arena->blocks_bytes -= sizeof(arenaBlock) + file_arena->blocks->size;
+			free(file_arena->blocks);
+		}
+		file_arena->blocks = temp;
+	}
+	file_arena->allocations_amount = 0;
+}
+
+/*
+* The function: arenaFree
+*
+* The function releases all the memory of the arena at once.
+*
+* Parameters:
+*	file_arena - a pointer to the arena to release.
+*/
+void arenaFree(arena* file_arena)
+{
+	arenaBlock *temp;/*The next block to release*/
+
+	arenaReset(file_arena);
+	while(file_arena->spare){
+		temp = file_arena->spare->next;
+		free(file_arena->spare);
+		file_arena->spare = temp;
+	}
+	arenaInit(file_arena);
+}
+
+/************************************************************************ - END OF ARENA - ************************************************************************/
@@ -4,133 +4,129 @@
 * FILE: assembler.c
 *
 * This file runs the entire project , and execute all the project files together, also known as the 'assembler'.
-* The assembler contains 4 stages: 
+* The assembler contains 4 stages (the stages 2-4 of every file are run by assembleFile, see pipeline.c):
 *	1. receive the input files from the user.
-*	2. pre_processor - create .am type file, that if there are macros in the input file, it spread them and include tham in the .am file
+*	2. pre_processor - spread the macros of the input file, the expanded source is passed to the first pass in memory (and written to an .am file with --emit-am)
 *	3. first pass - translate all the words into binary machine code, except from the labels.
 *	4. second pass - translate the labels into binary machine code, and create output files(ob,ent,ext).
 *
+* The assembler options (must appear before the files names):
+*	-j N - assemble up to N input files at the same time (see parallel.c).
+*	--emit-am - write the source after the pre processor to an .am file.
+*	--obj - write the binary object to an .obj file too (see object_file.c).
+*	--thread-jumps - retarget the jumps to jumps to the end of their chains (see optimizer.c).
+*	--dce - remove the code that can not be reached from the first instruction and the entry labels (see control_flow.c).
+*	--peephole - remove the instructions that do nothing from the code, before the labels are resolved (see optimizer.c).
+*	--stats - print the statistics of every file as one JSON object in a single line (see pipeline.c).
+*	--server - stay resident and assemble the files of the requests that are read from the standard input (see server.c),
+*		   no files names are given on the command line.
+*	--cache DIR - skip the files that did not change since they were assembled, their outputs are restored from the
+*		      build cache in the directory DIR (see cache.c).
+*	--cache-size KB - the size bound of the build cache, 65536 KB by default.
+*
 */
 
 int main(int argc, char *argv[])
 {
-	FILE *input_file;/*Pointer to the input file*/
-	short i = 1;/*The current input file number*/
-	short ic_dc_counter[2]; /*The first cell represents the number of instructions to execute in the file,
-				 *the second cell represents the number of data instructions in the file*/
+	short i = 1;/*The current argument number*/
+	assemblerOptions options = {1, FALSE, FALSE, 0, FALSE, NULL, NULL, NULL};/*The options of the assembler*/
+	buildCache cache = {NULL, CACHE_MAX_KB * 1024L, 0, 0, 0, 0, 0};/*The build cache, used only with --cache*/
+	long cache_kb;/*The size bound of the build cache from --cache-size*/
+	char server = FALSE;/*TRUE if the assembler runs as a server*/
 	char indicator;/*Represnt if there is errors ( -1 - fatal error
 							0 - error
 							1 - no error )*/
-	char *input_file_name;/*Represent file with the .as sufix*/
-	char *output_file_name;/*Represent file with the .am sufix*/
-	macroNode *macros_list;/*List of macro nodes*/
-	instructionNode *instructions_list;/*List of instructions nodes*/
-	dataNode *data_list;/*List of data nodes*/
-	declarationNode *declarations_list;/*List of declarations nodes*/
-	
+
 /************************************************************** - STAGE 1: RECEIVING THE FILE NAME - **************************************************************/
 
-	if(argc == 1){/*If there are no input files*/
-		printf("--- No files names was received. ---\n--- End of assembler. ---\n");
-		return 0;
-	}
-			
-	while(--argc > 0){/*If there are still input files left to check*/	
-		/*Reset the variables:*/
-		input_file_name = NULL;
-		output_file_name = NULL;
-		macros_list = NULL;
-		instructions_list = NULL;		
-		data_list = NULL;	
-		declarations_list = NULL;
-		
-		printf("--- Start reading file: %s ---\n",argv[i]);
-		/*Allocate memory for the input file name*/
-		input_file_name = (char*)malloc(sizeof(char) * (strlen(argv[i]+INPUT_FILE_SIZE)) );
-		if(!input_file_name){/*If there was an error in allocation*/
-			memoryError(input_file_name, argv[i]);
-			exit(EXIT_FAILURE);
+	/*Read the options that appear before the files names*/
+	while(i < argc && argv[i][0] == '-'){
+		if(!strcmp(argv[i], "--emit-am"))/*Write the .am files*/
+			options.emit_am = TRUE;
+		else if(!strcmp(argv[i], "--obj"))/*Write the .obj files*/
+			options.emit_object = TRUE;
+		else if(!strcmp(argv[i], "--thread-jumps"))/*Run the jump threading*/
+			options.optimizations |= JUMP_THREADING;
+		else if(!strcmp(argv[i], "--dce"))/*Run the dead code elimination*/
+			options.optimizations |= DEAD_CODE_ELIMINATION;
+		else if(!strcmp(argv[i], "--peephole"))/*Run the peephole optimization*/
+			options.optimizations |= PEEPHOLE_OPTIMIZATION;
+		else if(!strcmp(argv[i], "--stats"))/*Print the statistics of every file*/
+			options.print_stats = TRUE;
+		else if(!strcmp(argv[i], "--server"))/*Read the requests from the standard input*/
+			server = TRUE;
+		else if(!strcmp(argv[i], "--cache") && i+1 < argc){/*The directory of the build cache*/
+			cache.dir = argv[++i];
+			options.cache = &cache;
 		}
-		/*Allocate memory for the output file name*/
-		output_file_name = (char*)malloc(sizeof(char) * (strlen(argv[i]+OUTPUT_FILE_SIZE)) );
-		if(!output_file_name){/*If there was an error in allocation*/
-			memoryError(output_file_name, argv[i]);
-			free(input_file_name);
-			exit(EXIT_FAILURE);
+		else if(!strcmp(argv[i], "--cache-size") && i+1 < argc){/*The size bound of the build cache*/
+			if((cache_kb = atol(argv[++i])) < 1){
+				printf("--- Error: the option --cache-size must be followed by a positive number of KB. ---\n");
+				return EXIT_FAILURE;
+			}
+			cache.max_bytes = cache_kb * 1024;
 		}
-		
-		strcpy(input_file_name, argv[i]);
-		strcat(input_file_name, ".as");
-		/*Opening new input(.as) file*/
-		if(!(input_file = fopen(input_file_name, "r"))){/*If there was an error opening the input file*/
-			printf("--- Error: file %s does not exist. ---\n", input_file_name);
-			free(input_file_name);
-			free(output_file_name);
-			checkIfRemainMoreFile(argc);
-			i++;
-			continue;
+		else if(!strncmp(argv[i], "-j", 2)){/*The amount of parallel jobs*/
+			if(argv[i][2])/*The number is attached to the option: -jN*/
+				options.jobs_amount = (short)atoi(argv[i]+2);
+			else if(i+1 < argc)/*The number is the next argument: -j N*/
+				options.jobs_amount = (short)atoi(argv[++i]);
+			else
+				options.jobs_amount = 0;
+
+			if(options.jobs_amount < 1){
+				printf("--- Error: the option -j must be followed by a positive number of jobs. ---\n");
+				return EXIT_FAILURE;
+			}
 		}
-					
-		strcpy(output_file_name, argv[i]);
-		strcat(output_file_name, ".am");		
-		
-/******************************************************************* - STAGE 2: PRE-PROCESSOR - *******************************************************************/
-		
-		if(!(indicator = macrosLayout(input_file, input_file_name, output_file_name, argv[i], &macros_list))){/*If there where errors in pre processor stage*/
-			printf("--- The program didn't create .am file for: %s ---\n", argv[i]);
-			checkIfRemainMoreFile(argc);
-			free(output_file_name);
-			mainGeneralFree(input_file, input_file_name, macros_list, declarations_list, data_list, instructions_list);
-			i++;
-			continue;	
+		else{
+			printf("--- Error: unknown option %s. ---\n", argv[i]);
+			return EXIT_FAILURE;
 		}
-		if(indicator == FATAL_ERROR){/*If there was memory error in pre processor stage*/
-			printf("--- Memory error, the program will stop without reaching its end. ---\n");
-			free(output_file_name);
-			mainGeneralFree(input_file, input_file_name, macros_list, declarations_list, data_list, instructions_list);
-			exit(EXIT_FAILURE);/*Stops the program because memory errors*/
+		i++;
+	}
+
+	if(options.cache && mkdir(cache.dir, 0777) && errno != EEXIST){
+		printf("--- Error: the directory of the build cache %s could not be created. ---\n", cache.dir);
+		return EXIT_FAILURE;
+	}
+
+	if(server){/*The files names are read from the requests*/
+		if(i < argc){
+			printf("--- Error: --server reads the files names from the standard input, not from the command line. ---\n");
+			return EXIT_FAILURE;
 		}
-		
-		fclose(input_file);
-		free(input_file_name);
-		
-/******************************************************************** - STAGE 3: FIRST PASS - ********************************************************************/
-		
-		/*Opening new output file*/
-		input_file_name = output_file_name;		
-		if(!(input_file = fopen(input_file_name, "r"))){/*If there was an error opening the output file*/		
-			newFileOpenError("input_file", argv[i]);
-			mainGeneralFree(input_file, input_file_name, macros_list, declarations_list, data_list, instructions_list);
-			exit(EXIT_FAILURE);/*Stops the program because memory errors*/
+		return (runAssemblerServer(&options) == FATAL_ERROR) ? EXIT_FAILURE : 0;
+	}
+
+	if(i == argc){/*If there are no input files*/
+		printf("--- No files names was received. ---\n--- End of assembler. ---\n");
+		return 0;
+	}
+
+	if(options.jobs_amount > 1){/*If the files should be assembled in parallel*/
+		if(runParallelAssembly(argv+i, argc-i, &options) == FATAL_ERROR){
+			printf("--- End of assembler, some of the files were stopped because of memory errors. ---\n");
+			return EXIT_FAILURE;
 		}
-									
-		indicator = firstPass(input_file, input_file_name, ic_dc_counter, macros_list, &instructions_list, &data_list, &declarations_list);/*Set the values according if there was errors in first pass*/
-	
-		if(indicator == FATAL_ERROR){/*If there was memory error in first pass stage*/
-			printf("--- Memory error, the program will stop without reaching its end. ---\n");
-			mainGeneralFree(input_file, input_file_name, macros_list, declarations_list, data_list, instructions_list);
-			exit(EXIT_FAILURE);/*Stops the program because memory errors*/
+	}
+	else{
+		for(; i < argc; i++){/*If there are still input files left to check*/
+			indicator = buildFile(argv[i], &options);
+			if(indicator == FATAL_ERROR){/*If there was memory error in one of the stages*/
+				printf("--- Memory error, the program will stop without reaching its end. ---\n");
+				exit(EXIT_FAILURE);/*Stops the program because memory errors*/
+			}
+			checkIfRemainMoreFile(argc-i);
 		}
-		
-/******************************************************************** - STAGE 4: SECOND PASS - ********************************************************************/
+	}
 
-		if(!(indicator = secondPass(argv[i], input_file_name, ic_dc_counter, &instructions_list, data_list, declarations_list, indicator)))/*If there were errors in second pass stage*/
-			printf("--- The program will not create an object file for: %s ---\n", argv[i]);
-		
-		mainGeneralFree(input_file, input_file_name, macros_list, declarations_list, data_list, instructions_list);
-		
-		if(indicator == FATAL_ERROR)/*If there was memory error in second pass stage*/
-		{
-			printf("--- Memory error, the program will stop without reaching its end. ---\n");
-			exit(EXIT_FAILURE);/*Stops the program because memory errors*/
-		}
-		checkIfRemainMoreFile(argc);
-		i++;
+	if(options.cache){
+		trimBuildCache(&cache);
+		printCacheStats(&cache);
 	}
-		
 	printf("--- End of assembler, finished reading all the files. ---\n");
 	return 0;
 }
 
 /************************************************************************* - END OF MAIN - *************************************************************************/
-
@@ -0,0 +1,220 @@
+#include "headers.h"
+
+/*
+* FILE: bench.c
+*
+* This file runs the benchmark of the assembler (make bench).
+* The benchmark generates synthetic input files (see bench_generator.c), assembles them with the same stages as the
+* assembler, and reports the wall time of every stage, the lines and the words per second, and the peak memory use.
+* The messages of the assembler are not printed while the files are assembled, so they do not affect the times.
+*
+* The benchmark options (every option is followed by a number, except --dir that is followed by a directory name):
+*	--files N - the amount of generated files.
+*	--lines N - the amount of lines of every file.
+*	--macros P - the percent of the lines that call a macro.
+*	--labels N - the amount of labels of every file.
+*	--externs P - the percent of the labels that are extern.
+*	--entries P - the percent of the labels that are declared as entry.
+*	--data N - the amount of numbers of every .data line.
+*	--seed N - the seed of the generated programs.
+*	--dir D - the directory of the generated files (and of the output files), bench_files by default.
+*
+*/
+
+int main(int argc, char *argv[])
+{
+	benchWorkload workload = {BENCH_LINES, BENCH_MACRO_PERCENT, BENCH_LABELS, BENCH_EXTERN_PERCENT, BENCH_ENTRY_PERCENT, BENCH_DATA_SIZE};/*The workload of the files*/
+	long files_amount = BENCH_FILES;/*The amount of files*/
+	long seed = 1;/*The seed of the generated programs*/
+	char *dir = "bench_files";/*The directory of the generated files*/
+	char *file_name;/*The name of the current file, without the .as suffix*/
+	char valid = TRUE;/*FALSE if an option is not valid*/
+	assemblyStats stats = {{0}};/*The statistics of all the files*/
+	assemblerOptions options = {1, FALSE, FALSE, 0, FALSE, NULL, NULL, NULL};/*The options of the assembler*/
+	long lines_amount = 0;/*The amount of lines of all the files*/
+	long lines;/*The amount of lines of the current file*/
+	short errors_amount = 0;/*The amount of files with errors*/
+	char indicator;/*The result of the assembly of the current file*/
+	int saved_stdout;/*The console, while the messages of the assembler are not printed*/
+	int i;/*Counter*/
+
+	/*Read the options*/
+	for(i = 1; i < argc && valid; i += 2){
+		if(i+1 == argc)
+			valid = FALSE;
+		else if(!strcmp(argv[i], "--files"))
+			valid = readBenchNumber(argv[i+1], 1, SHRT_MAX, &files_amount);
+		else if(!strcmp(argv[i], "--lines"))
+			valid = readBenchNumber(argv[i+1], 1, LONG_MAX, &workload.lines_amount);
+		else if(!strcmp(argv[i], "--macros"))
+			valid = readBenchNumber(argv[i+1], 0, 100, &workload.macro_percent);
+		else if(!strcmp(argv[i], "--labels"))
+			valid = readBenchNumber(argv[i+1], 0, BENCH_MAX_LABELS, &workload.labels_amount);
+		else if(!strcmp(argv[i], "--externs"))
+			valid = readBenchNumber(argv[i+1], 0, 100, &workload.extern_percent);
+		else if(!strcmp(argv[i], "--entries"))
+			valid = readBenchNumber(argv[i+1], 0, 100, &workload.entry_percent);
+		else if(!strcmp(argv[i], "--data"))
+			valid = readBenchNumber(argv[i+1], 1, BENCH_MAX_DATA_SIZE, &workload.data_size);
+		else if(!strcmp(argv[i], "--seed"))
+			valid = readBenchNumber(argv[i+1], 1, LONG_MAX, &seed);
+		else if(!strcmp(argv[i], "--dir"))
+			dir = argv[i+1];
+		else
+			valid = FALSE;
+	}
+	if(!valid){
+		printf("--- Error: invalid option %s, see bench.c for the options of the benchmark. ---\n", argv[i-2]);
+		return EXIT_FAILURE;
+	}
+
+	file_name = (char*)malloc(sizeof(char) * (strlen(dir)+BENCH_NAME_SIZE));
+	if(!file_name){
+		memoryError("file_name", "benchmark");
+		return EXIT_FAILURE;
+	}
+	if(mkdir(dir, 0777) && errno != EEXIST){
+		printf("--- Error: the directory %s could not be created. ---\n", dir);
+		free(file_name);
+		return EXIT_FAILURE;
+	}
+
+	/*Generate the files*/
+	for(i = 0; i < files_amount; i++){
+		sprintf(file_name, "%s/bench%d.as", dir, i);
+		if((lines = generateBenchProgram(file_name, &workload, (unsigned long)seed + i)) == FATAL_ERROR){
+			newFileOpenError(file_name, "benchmark");
+			free(file_name);
+			return EXIT_FAILURE;
+		}
+		lines_amount += lines;
+	}
+
+	/*Assemble the files*/
+	options.stats = &stats;
+	saved_stdout = muteOutput();
+	for(i = 0; i < files_amount; i++){
+		sprintf(file_name, "%s/bench%d", dir, i);
+		indicator = assembleFile(file_name, &options);
+		if(indicator == FATAL_ERROR){
+			restoreOutput(saved_stdout);
+			printf("--- Memory error, the benchmark will stop without reaching its end. ---\n");
+			free(file_name);
+			return EXIT_FAILURE;
+		}
+		if(!indicator)
+			errors_amount++;
+	}
+	restoreOutput(saved_stdout);
+
+	printf("--- Benchmark: %ld files, %ld lines, %ld words (seed %ld) ---\n", files_amount, lines_amount, stats.code_words + stats.data_words, seed);
+	printBenchReport(&stats, lines_amount);
+	if(errors_amount)
+		printf("--- Warning: errors were found in %d of the generated files. ---\n", errors_amount);
+
+	free(file_name);
+	return 0;
+}
+
+/*********************************************************************** - END OF MAIN - ***********************************************************************/
+
+/*
+* The function: readBenchNumber
+*
+* The function reads the number of an option of the benchmark, and checks that it is in the range of the option.
+*
+* Parameters:
+*	str - the number as received from the user.
+*	min - the smallest valid number.
+*	max - the largest valid number.
+*	number - a pointer to the option, it receives the number if it is valid.
+*
+* Returns:
+*	TRUE - if the number is valid.
+*	FALSE - if the string is not a number, or the number is not in the range.
+*/
+char readBenchNumber(char* str, long min, long max, long* number)
+{
+	char *end;/*The end of the number in the string*/
+	long value = strtol(str, &end, 10);/*The number*/
+
+	if(end == str || *end || value < min || value > max)
+		return FALSE;
+	*number = value;
+	return TRUE;
+}
+
+/*
+* The function: muteOutput
+*
+* The function stops printing to the console, the output is sent to /dev/null until it is restored.
+*
+* Returns:
+*	A copy of the console, for restoring it.
+*/
+int muteOutput(void)
+{
+	int saved_stdout;/*A copy of the console*/
+	int null_file;/*The /dev/null file*/
+
+	fflush(stdout);
+	saved_stdout = dup(STDOUT_FILENO);
+	if((null_file = open("/dev/null", O_WRONLY)) >= 0){
+		dup2(null_file, STDOUT_FILENO);
+		close(null_file);
+	}
+	return saved_stdout;
+}
+
+/*
+* The function: restoreOutput
+*
+* The function prints to the console again, after muteOutput.
+*
+* Parameters:
+*	saved_stdout - the copy of the console that muteOutput returned.
+*/
+void restoreOutput(int saved_stdout)
+{
+	fflush(stdout);
+	if(saved_stdout >= 0){
+		dup2(saved_stdout, STDOUT_FILENO);
+		close(saved_stdout);
+	}
+}
+
+/*
+* The function: printBenchReport
+*
+* The function prints the time of every stage, the lines and the words per second, and the peak memory use of the benchmark.
+*
+* Parameters:
+*	stats - a pointer to the statistics of all the files.
+*	lines_amount - the amount of lines of all the files.
+*/
+void printBenchReport(assemblyStats* stats, long lines_amount)
+{
+	char *stages_names[STAGES_AMOUNT] = {"pre processor", "first pass", "second pass", "output"};/*The names of the stages*/
+	long words_amount = stats->code_words + stats->data_words;/*The amount of words of all the files*/
+	struct rusage usage;/*The resources of the benchmark*/
+	double total = 0;/*The time of all the stages*/
+	double seconds;/*The time of the current stage*/
+	int i;/*Counter*/
+
+	printf("%-16s%12s%16s%16s\n", "stage", "seconds", "lines/sec", "words/sec");
+	for(i = 0; i <= STAGES_AMOUNT; i++){
+		seconds = (i < STAGES_AMOUNT) ? stats->seconds[i] : total;
+		printf("%-16s%12.6f", (i < STAGES_AMOUNT) ? stages_names[i] : "total", seconds);
+		if(seconds > 0)
+			printf("%16.0f%16.0f\n", lines_amount / seconds, words_amount / seconds);
+		else
+			printf("%16s%16s\n", "-", "-");
+		if(i < STAGES_AMOUNT)
+			total += seconds;
+	}
+
+	getrusage(RUSAGE_SELF, &usage);
+	printf("peak RSS: %ld KB\n", usage.ru_maxrss);
+}
+
+/******************************************************************** - END OF BENCHMARK - ********************************************************************/
@@ -0,0 +1,243 @@
+#include "headers.h"
+
+/*
+* FILE: bench_generator.c
+*
+* This file includes the generator of the synthetic programs of the benchmark.
+* A synthetic program is a valid input file, that is built from a workload: the amount of lines, the percent of the lines
+* that call a macro, the amount of labels, the percent of the label operands that refer to an extern label, the percent
+* of the labels that are declared as entry, and the amount of numbers in every .data line.
+* The program is generated from a seed, so the same workload always gives the same program, and it is kept inside the
+* memory of the machine (the generator stops adding lines before the words pass the last memory cell).
+*
+*/
+
+/*
+* The function: benchRandom
+*
+* The function returns the next number of a simple pseudo random generator (xorshift), that gives the same numbers on every system.
+*
+* Parameters:
+*	state - a pointer to the state of the generator, it must not be 0.
+*	range - the amount of possible numbers.
+*
+* Returns:
+*	A number from 0 to range-1.
+*/
+long benchRandom(unsigned long* state, long range)
+{
+	*state ^= (*state << 13) & 0xFFFFFFFFUL;
+	*state ^= *state >> 17;
+	*state ^= (*state << 5) & 0xFFFFFFFFUL;
+	return (long)(*state % (unsigned long)range);
+}
+
+/*
+* The function: writeBenchOperand
+*
+* The function writes a random operand of the given addressing type to the line.
+*
+* Parameters:
+*	line - the line, the operand is added to its end.
+*	type - the addressing type of the operand.
+*	workload - a pointer to the workload of the program.
+*	externs_amount - the amount of extern labels of the program.
+*	state - a pointer to the state of the random generator.
+*/
+void writeBenchOperand(char* line, short type, benchWorkload* workload, int externs_amount, unsigned long* state)
+{
+	line += strlen(line);
+
+	if(type == IMMEDIATE_ADDRESSING)/*The assembler does not accept #0, so the values are from -500 to 500 without 0*/
+		sprintf(line, "#%s%ld", benchRandom(state, 2) ? "-" : "", benchRandom(state, 500) + 1);
+	else if(type == DIRECT_ADDRESSING){
+		if(externs_amount && benchRandom(state, 100) < workload->extern_percent)
+			sprintf(line, "X%ld", benchRandom(state, externs_amount));
+		else
+			sprintf(line, "L%ld", benchRandom(state, workload->labels_amount));
+	}
+	else if(type == INDIRECT_REGISTER_ADDRESSING)
+		sprintf(line, "*r%ld", benchRandom(state, REGISTERS_AMOUNT));
+	else
+		sprintf(line, "r%ld", benchRandom(state, REGISTERS_AMOUNT));
+}
+
+/*
+* The function: writeBenchInstruction
+*
+* The function writes a random instruction line, with operands that match the opcode.
+*
+* Parameters:
+*	line - the buffer of the line, the instruction is added to its end.
+*	workload - a pointer to the workload of the program.
+*	externs_amount - the amount of extern labels of the program.
+*	use_labels - FALSE if the operands must not refer to labels.
+*	state - a pointer to the state of the random generator.
+*
+* Returns:
+*	The amount of words of the instruction.
+*/
+short writeBenchInstruction(char* line, benchWorkload* workload, int externs_amount, char use_labels, unsigned long* state)
+{
+	short opcode = (short)benchRandom(state, OPCODES_AMOUNT);/*The opcode of the instruction*/
+	short source_type, target_type;/*The addressing types of the operands*/
+
+	use_labels = use_labels && workload->labels_amount;
+	if(!use_labels && opcode == LEA)/*lea needs a label*/
+		opcode = MOV;
+
+	sprintf(line + strlen(line), "\t%s", getOpcodeName(opcode));
+	if(opcode == RTS || opcode == STOP){
+		strcat(line, "\n");
+		return 1;
+	}
+
+	/*The target operand: any type for cmp and prn, a label or an indirect register for the jumps, and not an immediate value for the others*/
+	if(opcode == CMP || opcode == PRN)
+		target_type = (short)benchRandom(state, 4);
+	else if(opcode == JMP || opcode == BNE || opcode == JSR)
+		target_type = benchRandom(state, 2) ? DIRECT_ADDRESSING : INDIRECT_REGISTER_ADDRESSING;
+	else
+		target_type = DIRECT_ADDRESSING + (short)benchRandom(state, 3);
+	if(!use_labels && target_type == DIRECT_ADDRESSING)
+		target_type = INDIRECT_REGISTER_ADDRESSING;
+
+	if(opcode > LEA){
+		strcat(line, " ");
+		writeBenchOperand(line, target_type, workload, externs_amount, state);
+		strcat(line, "\n");
+		return 2;
+	}
+
+	/*The source operand: any type, and only a label for lea*/
+	source_type = (opcode == LEA) ? DIRECT_ADDRESSING : (short)benchRandom(state, 4);
+	if(!use_labels && source_type == DIRECT_ADDRESSING)
+		source_type = IMMEDIATE_ADDRESSING;
+
+	strcat(line, " ");
+	writeBenchOperand(line, source_type, workload, externs_amount, state);
+	strcat(line, ", ");
+	writeBenchOperand(line, target_type, workload, externs_amount, state);
+	strcat(line, "\n");
+
+	/*Two register operands share one word*/
+	if(source_type >= INDIRECT_REGISTER_ADDRESSING && target_type >= INDIRECT_REGISTER_ADDRESSING)
+		return 2;
+	return 3;
+}
+
+/*
+* The function: writeBenchData
+*
+* The function writes a random .data or .string line.
+*
+* Parameters:
+*	line - the buffer of the line, the data is added to its end.
+*	workload - a pointer to the workload of the program.
+*	state - a pointer to the state of the random generator.
+*
+* Returns:
+*	The amount of words of the data.
+*/
+short writeBenchData(char* line, benchWorkload* workload, unsigned long* state)
+{
+	short length;/*The amount of numbers or characters*/
+	short i;/*Counter*/
+
+	if(!benchRandom(state, 4)){/*A quarter of the data lines are strings*/
+		length = 1 + (short)benchRandom(state, BENCH_MAX_DATA_SIZE);
+		strcat(line, "\t.string \"");
+		for(i = 0; i < length; i++)
+			sprintf(line + strlen(line), "%c", (char)('a' + benchRandom(state, 26)));
+		strcat(line, "\"\n");
+		return length + 1;
+	}
+
+	strcat(line, "\t.data ");
+	for(i = 0; i < workload->data_size; i++)
+		sprintf(line + strlen(line), "%s%ld", i ? ", " : "", benchRandom(state, 1999) - 999);
+	strcat(line, "\n");
+	return workload->data_size;
+}
+
+/*
+* The function: generateBenchProgram
+*
+* The function writes a synthetic program of the given workload to a file.
+* The program starts with the extern declarations and the macros definitions, its body is a mix of instructions, data
+* lines and macro calls, where the labels are defined evenly, and it ends with the entry declarations.
+*
+* Parameters:
+*	file_name - the name of the file, with the .as suffix.
+*	workload - a pointer to the workload of the program.
+*	seed - the seed of the random generator, it must not be 0.
+*
+* Returns:
+*	The amount of lines of the program, or FATAL_ERROR if the file could not be created.
+*/
+long generateBenchProgram(char* file_name, benchWorkload* workload, unsigned long seed)
+{
+	FILE *file;/*The new file*/
+	char line[MAX_LENGTH_OF_LINE * 2];/*The current line*/
+	unsigned long state = seed;/*The state of the random generator*/
+	int externs_amount = (int)((long)workload->labels_amount * workload->extern_percent / 100);/*The amount of extern labels*/
+	int macros_amount = workload->macro_percent ? BENCH_MACROS_AMOUNT : 0;/*The amount of macros*/
+	short macro_words[BENCH_MACROS_AMOUNT];/*The amount of words of the commands of every macro*/
+	int next_label = 0;/*The next label that is not defined yet*/
+	long words = 0;/*The amount of words of the program*/
+	long lines = 0;/*The amount of lines of the program*/
+	long body_lines;/*The amount of lines of the body of the program*/
+	long i;/*Counter*/
+	int j, k;/*Counters*/
+
+	if(!(file = fopen(file_name, "w")))
+		return FATAL_ERROR;
+
+	for(i = 0; i < externs_amount; i++, lines++)
+		fprintf(file, ".extern X%ld\n", i);
+
+	for(j = 0; j < macros_amount; j++){
+		fprintf(file, "macr mc%d\n", j);
+		macro_words[j] = 0;
+		for(k = 0; k < BENCH_MACRO_LENGTH; k++){
+			line[0] = '\0';
+			macro_words[j] += writeBenchInstruction(line, workload, externs_amount, FALSE, &state);
+			fputs(line, file);
+		}
+		fprintf(file, "endmacr\n");
+		lines += BENCH_MACRO_LENGTH + 2;
+	}
+
+	body_lines = workload->lines_amount - lines - workload->labels_amount * workload->entry_percent / 100;
+	/*The words of the longest line and of the labels that are not defined yet must still fit in the memory*/
+	for(i = 0; i < body_lines && words + BENCH_MAX_LINE_WORDS + (workload->labels_amount - next_label) <= BENCH_WORDS_LIMIT; i++, lines++){
+		line[0] = '\0';
+		if(macros_amount && benchRandom(&state, 100) < workload->macro_percent){/*A macro call can not have a label*/
+			j = (int)benchRandom(&state, macros_amount);
+			sprintf(line, "mc%d\n", j);
+			words += macro_words[j];
+		}
+		else{
+			/*The labels are defined evenly over the body of the program*/
+			if(next_label < workload->labels_amount && i * workload->labels_amount >= (long)next_label * body_lines)
+				sprintf(line, "L%d:", next_label++);
+			if(benchRandom(&state, 100) < BENCH_DATA_PERCENT)
+				words += writeBenchData(line, workload, &state);
+			else
+				words += writeBenchInstruction(line, workload, externs_amount, TRUE, &state);
+		}
+		fputs(line, file);
+	}
+
+	/*The labels that were not defined in the body (when the words limit was reached) are defined here*/
+	for(; next_label < workload->labels_amount; next_label++, lines++)
+		fprintf(file, "L%d:\t.data %d\n", next_label, next_label);
+
+	for(j = 0; j < workload->labels_amount * workload->entry_percent / 100; j++, lines++)
+		fprintf(file, ".entry L%ld\n", j * 100 / workload->entry_percent);
+
+	fclose(file);
+	return lines;
+}
+
+/****************************************************************** - END OF BENCHMARK GENERATOR - ****************************************************************/
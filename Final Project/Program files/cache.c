@@ -0,0 +1,610 @@
+#include "headers.h"
+
+/*
+* FILE: cache.c
+*
+* This file includes the build cache of the assembler (--cache DIR), that skips the input files that did not change.
+* The key of a file is the SHA-256 hash of the version of the assembler, the options that change the outputs, the file
+* name and the bytes of the source. Every entry of the cache is a directory named by its key, that holds:
+*	result - the result of the assembly ('1' if the output files were created, '0' if errors were found), and the time
+*		 of the last use of the entry.
+*	messages - the messages that the assembler printed for the file.
+*	output.ob, output.ent, output.ext, output.am, output.obj - the output files that the assembly created.
+* When the key of a file is found, its messages are printed again and its output files are restored (an output file that
+* is already equal to the entry is left in place, so its time is not changed), and the pipeline is skipped.
+* Otherwise the file is assembled and a new entry is stored. At the end of the run the least recently used entries are
+* removed while the cache is bigger than its size bound.
+*
+*/
+
+/*
+* The function: buildFile
+*
+* The function assembles one input file through the build cache, or with assembleFile when there is no cache.
+*
+* Parameters:
+*	file_name - the name of the input file as received from the user (without the .as suffix).
+*	options - the options of the assembler.
+*
+* Returns:
+*	-1 (FATAL_ERROR) - if there was a memory error or a file opening error, the work on the file was stopped.
+*	0 (FALSE) - if errors were found in the input file.
+*	1 (TRUE) - if the output files were created.
+*/
+char buildFile(char* file_name, assemblerOptions* options)
+{
+	buildCache *cache = options->cache;/*The build cache*/
+	char key[SHA256_HEX_SIZE];/*The key of the file*/
+	char *entry_dir;/*The directory of the entry of the file*/
+	char indicator;/*The result of the assembly*/
+
+	if(!cache)
+		return assembleFile(file_name, options);
+
+	if((indicator = hashSourceFile(file_name, options, key)) != TRUE){
+		if(indicator == FATAL_ERROR){
+			memoryError("cache key", file_name);
+			return FATAL_ERROR;
+		}
+		return assembleFile(file_name, options);/*The input file can not be read, the pipeline prints the error*/
+	}
+	if(!(entry_dir = cachePath(cache->dir, key))){
+		memoryError("cache entry", file_name);
+		return FATAL_ERROR;
+	}
+
+	if((indicator = restoreCacheEntry(entry_dir, file_name, options)) != FATAL_ERROR){
+		cache->hits++;
+		free(entry_dir);
+		return indicator;
+	}
+
+	cache->misses++;
+	indicator = assembleAndStore(entry_dir, key, file_name, options);
+	free(entry_dir);
+	return indicator;
+}
+
+/*
+* The function: hashSourceFile
+*
+* The function calculates the key of an input file in the build cache.
+*
+* Parameters:
+*	file_name - the name of the input file as received from the user (without the .as suffix).
+*	options - the options of the assembler.
+*	key - a buffer of SHA256_HEX_SIZE characters, it receives the key.
+*
+* Returns:
+*	TRUE - if the key was calculated.
+*	FALSE - if the input file can not be read.
+*	FATAL_ERROR - if a memory allocation failure occurred.
+*/
+char hashSourceFile(char* file_name, assemblerOptions* options, char* key)
+{
+	sha256Context context;/*The state of the hash*/
+	sourceFile input_file;/*The reader of the input file*/
+	char *input_file_name;/*The name of the input file with the .as suffix*/
+	char indicator;/*The result of reading the file*/
+
+	if(!(input_file_name = (char*)malloc(sizeof(char) * (strlen(file_name)+INPUT_FILE_SIZE))))
+		return FATAL_ERROR;
+	strcpy(input_file_name, file_name);
+	strcat(input_file_name, ".as");
+	indicator = sourceOpen(&input_file, input_file_name);
+	free(input_file_name);
+	if(indicator != TRUE)
+		return indicator;
+
+	/*Every part of the key ends with '\0', so the parts can not be mixed*/
+	sha256Init(&context);
+	sha256Update(&context, (unsigned char*)ASSEMBLER_VERSION, strlen(ASSEMBLER_VERSION)+1);
+	sha256Update(&context, (unsigned char*)(options->emit_am ? "emit-am" : ""), options->emit_am ? strlen("emit-am")+1 : 1);
+	sha256Update(&context, (unsigned char*)(options->emit_object ? "obj" : ""), options->emit_object ? strlen("obj")+1 : 1);
+	sha256Update(&context, (unsigned char*)(options->optimizations & JUMP_THREADING ? "thread-jumps" : ""), options->optimizations & JUMP_THREADING ? strlen("thread-jumps")+1 : 1);
+	sha256Update(&context, (unsigned char*)(options->optimizations & DEAD_CODE_ELIMINATION ? "dce" : ""), options->optimizations & DEAD_CODE_ELIMINATION ? strlen("dce")+1 : 1);
+	sha256Update(&context, (unsigned char*)(options->optimizations & PEEPHOLE_OPTIMIZATION ? "peephole" : ""), options->optimizations & PEEPHOLE_OPTIMIZATION ? strlen("peephole")+1 : 1);
+	sha256Update(&context, (unsigned char*)file_name, strlen(file_name)+1);
+	sha256Update(&context, (unsigned char*)input_file.text, input_file.length);
+	sha256Final(&context, key);
+
+	sourceClose(&input_file);
+	return TRUE;
+}
+
+/*
+* The function: restoreCacheEntry
+*
+* The function restores the output files of an entry, and prints the messages of the entry.
+*
+* Parameters:
+*	entry_dir - the directory of the entry.
+*	file_name - the name of the input file as received from the user (without the .as suffix).
+*	options - the options of the assembler.
+*
+* Returns:
+*	The result of the assembly that is kept in the entry (TRUE or FALSE), or FATAL_ERROR if the entry was not found
+*	or could not be restored.
+*/
+char restoreCacheEntry(char* entry_dir, char* file_name, assemblerOptions* options)
+{
+	char *suffixes[CACHE_OUTPUTS_AMOUNT] = {".ob", ".ent", ".ext", ".am", ".obj"};/*The suffixes of the output files*/
+	char entry_name[CACHE_NAME_SIZE];/*The name of a file of the entry*/
+	char *path;/*The path of a file of the entry*/
+	char *output_name;/*The name of an output file*/
+	char result;/*The result of the assembly*/
+	assemblyStats no_stats = {{0}};/*The statistics of a restored file, nothing was assembled*/
+	double used;/*The last use of the entry*/
+	char indicator = TRUE;/*FATAL_ERROR if the entry could not be restored*/
+	int i;/*Counter*/
+
+	if(!(path = cachePath(entry_dir, "result")))
+		return FATAL_ERROR;
+	if(!readCacheResult(path, &result, &used)){/*There is no such entry*/
+		free(path);
+		return FATAL_ERROR;
+	}
+	writeCacheResult(path, result);/*The entry was used now*/
+	free(path);
+
+	if(!(output_name = (char*)malloc(sizeof(char) * (strlen(file_name)+EXT_FILE_SIZE))))
+		return FATAL_ERROR;
+	for(i = 0; i < CACHE_OUTPUTS_AMOUNT && indicator == TRUE; i++){
+		if(!isCacheOutput(i, options))/*The .am and .obj files are not touched without their options*/
+			continue;
+		sprintf(entry_name, "output%s", suffixes[i]);
+		sprintf(output_name, "%s%s", file_name, suffixes[i]);
+		if(!(path = cachePath(entry_dir, entry_name)))
+			indicator = FATAL_ERROR;
+		else if(access(path, F_OK))/*The assembly did not create this output file*/
+			remove(output_name);
+		else if(!copyCacheFile(path, output_name))
+			indicator = FATAL_ERROR;
+		free(path);
+	}
+	free(output_name);
+	if(indicator == FATAL_ERROR)
+		return FATAL_ERROR;
+
+	if(!(path = cachePath(entry_dir, "messages")))
+		return FATAL_ERROR;
+	printCacheFile(path);
+	free(path);
+	if(options->print_stats)
+		printAssemblyStats(file_name, &no_stats, result, TRUE);
+	return result;
+}
+
+/*
+* The function: assembleAndStore
+*
+* The function assembles an input file while its messages are written to a new entry, and stores the output files in
+* the entry. The entry is built in a temporary directory, and it is renamed to its key only when it is complete.
+* An entry that is already there and is not valid (its result file is missing or broken) is replaced by the new one.
+* The old output files of the input file are removed first, so the entry holds only what the assembly created.
+*
+* Parameters:
+*	entry_dir - the directory of the entry.
+*	key - the key of the file.
+*	file_name - the name of the input file as received from the user (without the .as suffix).
+*	options - the options of the assembler.
+*
+* Returns:
+*	The result of the assembly, as returned by assembleFile.
+*/
+char assembleAndStore(char* entry_dir, char* key, char* file_name, assemblerOptions* options)
+{
+	char *suffixes[CACHE_OUTPUTS_AMOUNT] = {".ob", ".ent", ".ext", ".am", ".obj"};/*The suffixes of the output files*/
+	char temp_key[SHA256_HEX_SIZE + NUMBER_DIGITS_SIZE + 5];/*The name of the temporary directory of the entry*/
+	char entry_name[CACHE_NAME_SIZE];/*The name of a file of the entry*/
+	char *temp_dir;/*The temporary directory of the entry*/
+	char *path;/*The path of a file of the entry*/
+	char *output_name;/*The name of an output file*/
+	assemblyStats stats = {{0}};/*The statistics of the file*/
+	assemblerOptions request = *options;/*The options of the assembly, the statistics are printed after the messages*/
+	char indicator;/*The result of the assembly*/
+	int messages_fd;/*The messages file of the entry*/
+	int saved_stdout;/*The console, while the messages are written to the entry*/
+	char stored;/*TRUE if the entry was stored*/
+	char result;/*The result of an entry that is already stored*/
+	double used;/*The last use of an entry that is already stored*/
+	int i;/*Counter*/
+
+	sprintf(temp_key, "%s.%ld.tmp", key, (long)getpid());
+	if(!(temp_dir = cachePath(options->cache->dir, temp_key)) || !(output_name = (char*)malloc(sizeof(char) * (strlen(file_name)+EXT_FILE_SIZE)))){
+		free(temp_dir);
+		memoryError("cache entry", file_name);
+		return FATAL_ERROR;
+	}
+	if(!(path = cachePath(temp_dir, "messages"))){
+		free(temp_dir);
+		free(output_name);
+		memoryError("cache entry", file_name);
+		return FATAL_ERROR;
+	}
+
+	for(i = 0; i < CACHE_OUTPUTS_AMOUNT; i++){
+		if(isCacheOutput(i, options)){
+			sprintf(output_name, "%s%s", file_name, suffixes[i]);
+			remove(output_name);
+		}
+	}
+
+	/*If the entry can not be created the file is still assembled, without the cache*/
+	messages_fd = -1;
+	if(!mkdir(temp_dir, 0777))
+		messages_fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if(messages_fd < 0){
+		rmdir(temp_dir);
+		free(path);
+		free(temp_dir);
+		free(output_name);
+		return assembleFile(file_name, options);
+	}
+
+	fflush(stdout);
+	saved_stdout = dup(STDOUT_FILENO);
+	dup2(messages_fd, STDOUT_FILENO);
+	close(messages_fd);
+	request.print_stats = FALSE;
+	request.stats = &stats;
+	indicator = assembleFile(file_name, &request);
+	fflush(stdout);
+	dup2(saved_stdout, STDOUT_FILENO);
+	close(saved_stdout);
+
+	printCacheFile(path);
+	free(path);
+	if(indicator != FATAL_ERROR){
+		if(options->print_stats)
+			printAssemblyStats(file_name, &stats, indicator, FALSE);
+		if(options->stats)
+			addAssemblyStats(options->stats, &stats);
+	}
+
+	/*Store the output files and the result, and move the complete entry to its place (an entry that is not complete is removed)*/
+	stored = (indicator != FATAL_ERROR);
+	for(i = 0; i < CACHE_OUTPUTS_AMOUNT && stored; i++){
+		sprintf(entry_name, "output%s", suffixes[i]);
+		sprintf(output_name, "%s%s", file_name, suffixes[i]);
+		if(isCacheOutput(i, options) && !access(output_name, F_OK)){
+			stored = (path = cachePath(temp_dir, entry_name)) && copyCacheFile(output_name, path);
+			free(path);
+		}
+	}
+	if(stored && (stored = ((path = cachePath(temp_dir, "result")) != NULL))){
+		stored = writeCacheResult(path, indicator);
+		free(path);
+	}
+	if(stored && rename(temp_dir, entry_dir)){
+		stored = FALSE;
+		if((path = cachePath(entry_dir, "result"))){
+			if(!readCacheResult(path, &result, &used)){/*The entry is not valid, so it would miss forever*/
+				removeCacheEntry(entry_dir);
+				stored = !rename(temp_dir, entry_dir);
+			}
+			free(path);
+		}
+	}
+	if(!stored)
+		removeCacheEntry(temp_dir);
+	free(temp_dir);
+	free(output_name);
+	return indicator;
+}
+
+/*
+* The function: isCacheOutput
+*
+* The function checks if an output file belongs to the entries of the current options: the .am file only with
+* --emit-am and the .obj file only with --obj, the other output files always.
+*
+* Parameters:
+*	output - the index of the output file in the output files of an entry.
+*	options - the options of the assembler.
+*
+* Returns:
+*	TRUE - if the output file is created with these options.
+*	FALSE - otherwise.
+*/
+char isCacheOutput(short output, assemblerOptions* options)
+{
+	if(output == CACHE_AM_OUTPUT)
+		return options->emit_am;
+	if(output == CACHE_OBJECT_OUTPUT)
+		return options->emit_object;
+	return TRUE;
+}
+
+/*
+* The function: readCacheResult
+*
+* The function reads the result file of an entry.
+*
+* Parameters:
+*	path - the path of the result file.
+*	result - a pointer that receives the result of the assembly (TRUE or FALSE).
+*	used - a pointer that receives the time of the last use of the entry.
+*
+* Returns:
+*	TRUE - if the result file was read.
+*	FALSE - if the file does not exist or it is not valid.
+*/
+char readCacheResult(char* path, char* result, double* used)
+{
+	FILE *result_file;/*The result file*/
+	int value;/*The result as written in the file*/
+	int items;/*The amount of items that were read*/
+
+	if(!(result_file = fopen(path, "r")))
+		return FALSE;
+	items = fscanf(result_file, "%d %lf", &value, used);
+	fclose(result_file);
+	if(items != 2 || (value != TRUE && value != FALSE))
+		return FALSE;
+	*result = (char)value;
+	return TRUE;
+}
+
+/*
+* The function: writeCacheResult
+*
+* The function writes the result file of an entry, with the current time as the time of the last use of the entry.
+* The time is kept in the file and not as the time of the file, since the times of the files have only whole seconds.
+* The file is written under a temporary name and renamed over the old one, so a process that reads the entry at the
+* same time never sees a file that is only partly written.
+*
+* Parameters:
+*	path - the path of the result file.
+*	result - the result of the assembly (TRUE or FALSE).
+*
+* Returns:
+*	TRUE - if the file was written.
+*	FALSE - if the file could not be written.
+*/
+char writeCacheResult(char* path, char result)
+{
+	FILE *result_file;/*The result file*/
+	struct timespec now;/*The current time*/
+	char *temp_path;/*The temporary name of the result file*/
+	char written;/*TRUE if the file was written*/
+
+	if(!(temp_path = (char*)malloc(sizeof(char) * (strlen(path) + NUMBER_DIGITS_SIZE + 6))))
+		return FALSE;
+	sprintf(temp_path, "%s.%ld.tmp", path, (long)getpid());
+	if(!(result_file = fopen(temp_path, "w"))){
+		free(temp_path);
+		return FALSE;
+	}
+	clock_gettime(CLOCK_REALTIME, &now);
+	fprintf(result_file, "%d %ld.%06ld\n", result ? TRUE : FALSE, (long)now.tv_sec, (long)(now.tv_nsec / 1000));
+	written = !fclose(result_file) && !rename(temp_path, path);
+	if(!written)
+		remove(temp_path);
+	free(temp_path);
+	return written;
+}
+
+/*
+* The function: cachePath
+*
+* The function allocates the path of a file or a directory inside the cache.
+*
+* Parameters:
+*	dir - the directory.
+*	name - the name of the file or the directory inside dir.
+*
+* Returns:
+*	The path "dir/name", or NULL if a memory allocation failure occurred.
+*/
+char* cachePath(char* dir, char* name)
+{
+	char *path;/*The new path*/
+
+	path = (char*)malloc(sizeof(char) * (strlen(dir) + strlen(name) + 2));
+	if(path)
+		sprintf(path, "%s/%s", dir, name);
+	return path;
+}
+
+/*
+* The function: copyCacheFile
+*
+* The function copies a file, unless the target file is already equal to it.
+*
+* Parameters:
+*	from - the name of the file to copy.
+*	to - the name of the copy.
+*
+* Returns:
+*	TRUE - if the target file is equal to the source file.
+*	FALSE - if one of the files could not be opened or written.
+*/
+char copyCacheFile(char* from, char* to)
+{
+	char buffer[BUFSIZ];/*A buffer for the content of the source file*/
+	char target_buffer[BUFSIZ];/*A buffer for the content of the target file*/
+	size_t length;/*The amount of characters that was read to the buffer*/
+	FILE *source, *target;/*The files*/
+	char equal = TRUE;/*TRUE as long as the target file is equal to the source file*/
+
+	if(!(source = fopen(from, "rb")))
+		return FALSE;
+
+	/*Compare the files first, an equal target file is left in place*/
+	if((target = fopen(to, "rb"))){
+		while(equal && (length = fread(buffer, sizeof(char), BUFSIZ, source)) > 0)
+			equal = (fread(target_buffer, sizeof(char), BUFSIZ, target) == length && !memcmp(buffer, target_buffer, length));
+		equal = equal && fgetc(target) == EOF;
+		fclose(target);
+		if(equal){
+			fclose(source);
+			return TRUE;
+		}
+		rewind(source);
+	}
+
+	if(!(target = fopen(to, "wb"))){
+		fclose(source);
+		return FALSE;
+	}
+	while((length = fread(buffer, sizeof(char), BUFSIZ, source)) > 0)
+		fwrite(buffer, sizeof(char), length, target);
+	fclose(source);
+	return !fclose(target);
+}
+
+/*
+* The function: printCacheFile
+*
+* The function prints the content of a file of the cache to the console.
+*
+* Parameters:
+*	path - the path of the file.
+*/
+void printCacheFile(char* path)
+{
+	char buffer[BUFSIZ];/*A buffer for copying the file*/
+	size_t length;/*The amount of characters that was read to the buffer*/
+	FILE *file;/*The file*/
+
+	if(!(file = fopen(path, "rb")))
+		return;
+	while((length = fread(buffer, sizeof(char), BUFSIZ, file)) > 0)
+		fwrite(buffer, sizeof(char), length, stdout);
+	fclose(file);
+}
+
+/*
+* The function: removeCacheEntry
+*
+* The function removes the files of an entry and its directory, including a temporary result file that a stopped
+* process left behind.
+*
+* Parameters:
+*	entry_dir - the directory of the entry.
+*/
+void removeCacheEntry(char* entry_dir)
+{
+	DIR *dir;/*The directory of the entry*/
+	struct dirent *item;/*The current item of the directory*/
+	char *path;/*The path of the current file*/
+
+	if((dir = opendir(entry_dir))){
+		while((item = readdir(dir))){
+			if(!strcmp(item->d_name, ".") || !strcmp(item->d_name, ".."))
+				continue;
+			if((path = cachePath(entry_dir, item->d_name))){
+				remove(path);
+				free(path);
+			}
+		}
+		closedir(dir);
+	}
+	rmdir(entry_dir);
+}
+
+/*
+* The function: compareCacheEntries
+*
+* The function compares the last use of two entries, for sorting the entries from the least recently used (qsort).
+*
+* Parameters:
+*	first - a pointer to the first entry.
+*	second - a pointer to the second entry.
+*
+* Returns:
+*	A negative number if the first entry was used before the second, a positive number if after it, or 0.
+*/
+int compareCacheEntries(const void* first, const void* second)
+{
+	double first_used = ((cacheEntry*)first)->used;/*The last use of the first entry*/
+	double second_used = ((cacheEntry*)second)->used;/*The last use of the second entry*/
+
+	return (first_used > second_used) - (first_used < second_used);
+}
+
+/*
+* The function: trimBuildCache
+*
+* The function measures the entries of the cache, and removes the least recently used entries while the cache is bigger
+* than its size bound.
+*
+* Parameters:
+*	cache - a pointer to the build cache, its amount of entries and bytes are updated.
+*/
+void trimBuildCache(buildCache* cache)
+{
+	char *names[CACHE_OUTPUTS_AMOUNT+2] = {"result", "messages", "output.ob", "output.ent", "output.ext", "output.am", "output.obj"};/*The files of an entry*/
+	DIR *dir;/*The directory of the cache*/
+	struct dirent *item;/*The current item of the directory*/
+	struct stat file_stat;/*The information of a file of an entry*/
+	cacheEntry *entries = NULL;/*The entries of the cache*/
+	cacheEntry *temp_entries;/*The entries array after reallocation*/
+	int entries_amount = 0;/*The amount of entries*/
+	int entries_size = 0;/*The allocated size of the entries array*/
+	char *entry_dir, *path;/*The paths of an entry and of its files*/
+	char result;/*The result of an entry*/
+	long total = 0;/*The size of all the entries*/
+	int i, j;/*Counters*/
+
+	if(!(dir = opendir(cache->dir)))
+		return;
+	while((item = readdir(dir))){
+		if(strlen(item->d_name) != SHA256_HEX_SIZE-1)/*The temporary entries are skipped*/
+			continue;
+		if(entries_amount == entries_size){
+			entries_size = entries_size ? entries_size*2 : CACHE_ENTRIES_SIZE;
+			if(!(temp_entries = (cacheEntry*)realloc(entries, sizeof(cacheEntry) * entries_size)))
+				break;
+			entries = temp_entries;
+		}
+		strcpy(entries[entries_amount].key, item->d_name);
+		entries[entries_amount].bytes = 0;
+		entries[entries_amount].used = 0;
+		if(!(entry_dir = cachePath(cache->dir, item->d_name)))
+			break;
+		for(j = 0; j < CACHE_OUTPUTS_AMOUNT+2; j++){
+			if((path = cachePath(entry_dir, names[j])) && !stat(path, &file_stat)){
+				entries[entries_amount].bytes += (long)file_stat.st_size;
+				if(!j && !readCacheResult(path, &result, &entries[entries_amount].used))
+					entries[entries_amount].used = 0;/*An entry that is not valid is removed first*/
+			}
+			free(path);
+		}
+		free(entry_dir);
+		total += entries[entries_amount].bytes;
+		entries_amount++;
+	}
+	closedir(dir);
+
+	qsort(entries, entries_amount, sizeof(cacheEntry), compareCacheEntries);
+	for(i = 0; i < entries_amount && total > cache->max_bytes; i++){
+		if((entry_dir = cachePath(cache->dir, entries[i].key))){
+			removeCacheEntry(entry_dir);
+			free(entry_dir);
+		}
+		total -= entries[i].bytes;
+		cache->evictions++;
+	}
+
+	cache->entries_amount = entries_amount - i;
+	cache->bytes = total;
+	free(entries);
+}
+
+/*
+* The function: printCacheStats
+*
+* The function prints the statistics of the build cache.
+*
+* Parameters:
+*	cache - a pointer to the build cache.
+*/
+void printCacheStats(buildCache* cache)
+{
+	printf("--- Build cache: %ld hits, %ld misses, %ld evicted, %ld entries, %ld of %ld KB used ---\n", cache->hits, cache->misses,
+		cache->evictions, cache->entries_amount, (cache->bytes + 1023) / 1024, cache->max_bytes / 1024);
+}
+
+/*********************************************************************** - END OF CACHE - ************************************************************************/
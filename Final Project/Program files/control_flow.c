@@ -0,0 +1,219 @@
+#include "headers.h"
+
+/*
+* FILE: control_flow.c
+*
+* This file builds the control flow graph of the code of a file, from the code stream of the optimizer (see optimizer.c).
+* The code is split into basic blocks: straight line code that is entered only at its first instruction and left only at
+* its last one. A block starts at the first instruction, at an instruction where a label is defined, and after jmp, bne,
+* jsr, rts and stop. Every block has up to two successors:
+*	jmp L		- the block of L.
+*	bne L, jsr L	- the block of L, and the next block (jsr returns to it).
+*	rts, stop	- none.
+*	other		- the next block.
+* A jump to an extern label, or to a label that is not in the code, has no successor in the code. A jump to the address
+* in a register (jmp *rX) may go to any block, so the block is marked as indirect.
+*
+* The reachable blocks are the blocks that the run may get to from the first instruction, from the entry labels (that other
+* files may jump to), and from the labels of the code that instructions use as data (their words may be read or written,
+* so they are kept). If a reachable block is indirect all the blocks are reachable.
+*
+*/
+
+/*
+* The function: buildControlFlow
+*
+* The function splits the instructions of a code stream that were not removed into basic blocks, and finds their successors.
+*
+* Parameters:
+*	flow - a pointer to the control flow graph.
+*	stream - a pointer to the code stream.
+*	file_arena - a pointer to the arena that the tables of the graph are allocated from.
+*
+* Returns:
+*	TRUE - if the graph was built.
+*	FATAL_ERROR - if a memory allocation failure occurred.
+*/
+char buildControlFlow(controlFlow* flow, codeStream* stream, arena* file_arena)
+{
+	codeInstruction *instruction;/*The current instruction*/
+	basicBlock *block = NULL;/*The current block*/
+	int previous_end = 0;/*The index of the word after the previous instruction that was not removed*/
+	int i;/*The index of the current instruction*/
+
+	flow->blocks_amount = 0;
+	flow->blocks = (basicBlock*)arenaAlloc(file_arena, sizeof(basicBlock) * (stream->instructions_amount+1));
+	flow->block_of = (int*)arenaAlloc(file_arena, sizeof(int) * (stream->instructions_amount+1));
+	if(!flow->blocks || !flow->block_of){
+		memoryError("control flow graph", "optimizer");
+		return FATAL_ERROR;
+	}
+
+	for(i = nextLiveInstruction(stream, 0); i < stream->instructions_amount; i = nextLiveInstruction(stream, i+1)){
+		instruction = &stream->instructions[i];
+		/*The labels of the removed instructions before it are defined at it too*/
+		if(!block || isBlockEnd(&stream->instructions[block->last]) || isLabeled(stream, previous_end, instruction->start)){
+			block = &flow->blocks[flow->blocks_amount++];
+			block->first = i;
+			block->successors[0] = block->successors[1] = NO_BLOCK;
+			block->indirect = block->reachable = FALSE;
+		}
+		block->last = i;
+		flow->block_of[i] = flow->blocks_amount - 1;
+		previous_end = instruction->start + instruction->length;
+	}
+	flow->block_of[stream->instructions_amount] = NO_BLOCK;/*A jump to the end of the code leaves it*/
+
+	for(i = 0; i < flow->blocks_amount; i++)
+		findSuccessors(flow, stream, i);
+	return TRUE;
+}
+
+/*
+* The function: isBlockEnd
+*
+* The function checks if an instruction ends its basic block.
+*
+* Parameters:
+*	instruction - a pointer to the instruction.
+*
+* Returns:
+*	TRUE - if the instruction is jmp, bne, jsr, rts or stop.
+*	FALSE - otherwise.
+*/
+char isBlockEnd(codeInstruction* instruction)
+{
+	return instruction->opcode == JMP || instruction->opcode == BNE || instruction->opcode == JSR ||
+		instruction->opcode == RTS || instruction->opcode == STOP;
+}
+
+/*
+* The function: findSuccessors
+*
+* The function finds the successors of a basic block by its last instruction.
+*
+* Parameters:
+*	flow - a pointer to the control flow graph.
+*	stream - a pointer to the code stream.
+*	index - the index of the block.
+*/
+void findSuccessors(controlFlow* flow, codeStream* stream, int index)
+{
+	basicBlock *block = &flow->blocks[index];/*The block*/
+	codeInstruction *last = &stream->instructions[block->last];/*The last instruction of the block*/
+	short amount = 0;/*The amount of successors that were found*/
+	int target;/*The instruction that the jump goes to*/
+
+	if(last->opcode == JMP || last->opcode == BNE || last->opcode == JSR){
+		if(last->types[1] == INDIRECT_REGISTER_ADDRESSING)
+			block->indirect = TRUE;
+		else if((target = jumpTarget(stream, last)) != NO_INSTRUCTION)
+			block->successors[amount++] = flow->block_of[nextLiveInstruction(stream, target)];
+	}
+	if(last->opcode != JMP && last->opcode != RTS && last->opcode != STOP && index+1 < flow->blocks_amount)
+		block->successors[amount] = index+1;
+}
+
+/*
+* The function: labelBlock
+*
+* The function returns the basic block that starts at a label of the code.
+*
+* Parameters:
+*	flow - a pointer to the control flow graph.
+*	stream - a pointer to the code stream.
+*	record - a pointer to the record of the label.
+*
+* Returns:
+*	The index of the block, or NO_BLOCK if the label is not a label of the code or it is at the end of the code.
+*/
+int labelBlock(controlFlow* flow, codeStream* stream, symbol* record)
+{
+	int index = record->address - FIRST_MEMORY_CELL;/*The index of the word of the label*/
+
+	if(record->is_extern || record->defined_type != CODE || index < 0 || index > stream->image->code.words_amount ||
+			stream->instruction_at[index] == NO_INSTRUCTION)
+		return NO_BLOCK;
+	return flow->block_of[nextLiveInstruction(stream, stream->instruction_at[index])];
+}
+
+/*
+* The function: markReachableBlocks
+*
+* The function marks the basic blocks that the run may get to, from the first instruction, the entry labels and the
+* labels of the code that are used as data.
+*
+* Parameters:
+*	flow - a pointer to the control flow graph.
+*	stream - a pointer to the code stream.
+*	file_arena - a pointer to the arena that the stack of the search is allocated from.
+*
+* Returns:
+*	TRUE - if the blocks were marked.
+*	FATAL_ERROR - if a memory allocation failure occurred.
+*/
+char markReachableBlocks(controlFlow* flow, codeStream* stream, arena* file_arena)
+{
+	codeInstruction *instruction;/*The current instruction*/
+	basicBlock *block;/*The current block*/
+	int *stack;/*The blocks that were reached and their successors were not visited yet*/
+	int stack_used = 0;/*The amount of blocks in the stack*/
+	int i, fixup_index;/*Counter and the fixup of an operand*/
+	short operand;/*The current operand*/
+
+	if(!flow->blocks_amount)
+		return TRUE;
+	if(!(stack = (int*)arenaAlloc(file_arena, sizeof(int) * flow->blocks_amount))){
+		memoryError("control flow stack", "optimizer");
+		return FATAL_ERROR;
+	}
+
+	pushReachableBlock(flow, stack, &stack_used, 0);
+	for(i = 0; i < stream->symbols->symbols_amount; i++){
+		if(stream->symbols->symbols[i].is_entry)
+			pushReachableBlock(flow, stack, &stack_used, labelBlock(flow, stream, &stream->symbols->symbols[i]));
+	}
+	/*A label of the code in an operand that is not the target of a jump*/
+	for(i = nextLiveInstruction(stream, 0); i < stream->instructions_amount; i = nextLiveInstruction(stream, i+1)){
+		instruction = &stream->instructions[i];
+		for(operand = 0; operand < 2; operand++){
+			if(instruction->types[operand] != DIRECT_ADDRESSING || (operand && (instruction->opcode == JMP || instruction->opcode == BNE || instruction->opcode == JSR)))
+				continue;
+			if((fixup_index = stream->fixup_at[operandWord(instruction, operand)]) != NO_FIXUP)
+				pushReachableBlock(flow, stack, &stack_used, labelBlock(flow, stream, &stream->symbols->symbols[stream->image->fixups[fixup_index].symbol]));
+		}
+	}
+
+	while(stack_used){
+		block = &flow->blocks[stack[--stack_used]];
+		if(block->indirect){/*Any block may be reached*/
+			for(i = 0; i < flow->blocks_amount; i++)
+				flow->blocks[i].reachable = TRUE;
+			return TRUE;
+		}
+		pushReachableBlock(flow, stack, &stack_used, block->successors[0]);
+		pushReachableBlock(flow, stack, &stack_used, block->successors[1]);
+	}
+	return TRUE;
+}
+
+/*
+* The function: pushReachableBlock
+*
+* The function marks a basic block as reachable, and pushes it to the stack of the search if it was not reached before.
+*
+* Parameters:
+*	flow - a pointer to the control flow graph.
+*	stack - the stack of the search.
+*	stack_used - a pointer to the amount of blocks in the stack.
+*	index - the index of the block, or NO_BLOCK.
+*/
+void pushReachableBlock(controlFlow* flow, int* stack, int* stack_used, int index)
+{
+	if(index == NO_BLOCK || flow->blocks[index].reachable)
+		return;
+	flow->blocks[index].reachable = TRUE;
+	stack[(*stack_used)++] = index;
+}
+
+/****************************************************************** - END OF CONTROL FLOW GRAPH - *******************************************************************/
@@ -0,0 +1,406 @@
+#include "headers.h"
+
+/*
+* FILE: disassembler.c
+*
+* This file is the disassembler program, that decodes the words of an object back to the source of the instructions.
+* Usage (the files names are without the suffix):
+*	./disassembler [--no-symbols] file1 file2 ...
+* The object of every file is read from its binary object file (.obj) if it exists, and otherwise from its text object
+* files, and its source is written to file.dis.as: the .entry and .extern lines, an instruction in every line of the
+* code, and .data lines of the data. The source assembles again to the same object (./assembler file.dis).
+*
+* The words are decoded with the fields that the encoder uses (the opcode, the addressing types, the registers and the
+* 'A', 'R' and 'E' bits) and the operands rules of the opcodes, so the decoding is a single linear pass over the code:
+* every instruction is decoded to a record at its address, and the records are written in a second pass over them.
+* The names of the labels are taken from the entries and the externs of the object (the .ent and .ext files), unless
+* --no-symbols is given. A label operand with no name gets the name L and its address (L0123), and an extern reference
+* with no name gets the name X and its address.
+*
+*/
+
+/* The prefix of an operand, for every addressing type */
+static char *operand_prefixes[] = {"#", "", "*r", "r"};
+
+int main(int argc, char *argv[])
+{
+	char use_symbols = TRUE;/*FALSE if the names of the object should be ignored*/
+	char indicator = TRUE;/*FALSE if one of the files failed*/
+	int i = 1;/*The current argument number*/
+
+	if(i < argc && !strcmp(argv[i], "--no-symbols")){
+		use_symbols = FALSE;
+		i++;
+	}
+	if(i == argc){
+		printf("--- Usage: disassembler [--no-symbols] file1 file2 ... ---\n");
+		return EXIT_FAILURE;
+	}
+
+	for(; i < argc; i++){
+		if(disassembleFile(argv[i], use_symbols) != TRUE)
+			indicator = FALSE;
+	}
+	return indicator ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*
+* The function: disassembleFile
+*
+* The function reads the object of a file, decodes it, and writes its source to file.dis.as.
+*
+* Parameters:
+*	file_name - the name of the object files without the suffix.
+*	use_symbols - TRUE to take the names of the labels from the entries and the externs of the object.
+*
+* Returns:
+*	TRUE - if the source was written.
+*	FALSE - if the object does not exist or it is not valid.
+*	FATAL_ERROR - if a memory allocation failure occurred or the file could not be created.
+*/
+char disassembleFile(char* file_name, char use_symbols)
+{
+	disassembly *dis;/*The decoded object*/
+	char *source_file_name;/*The name of the source file*/
+	char indicator;/*The result of the disassembly*/
+
+	if(!(dis = (disassembly*)malloc(sizeof(disassembly)))){
+		memoryError("disassembly", file_name);
+		return FATAL_ERROR;
+	}
+	if((indicator = loadObject(&dis->object, file_name)) != TRUE){
+		free(dis);
+		return indicator;
+	}
+	namePoolInit(&dis->names);
+	arenaInit(&dis->names_arena);
+	dis->extern_names = NULL;
+
+	if((indicator = decodeDisassembly(dis, use_symbols)) == FATAL_ERROR)
+		memoryError("disassembly", file_name);
+	else if(!indicator)
+		printf("--- Error: the object of %s does not fit in the memory. ---\n", file_name);
+	else if(!(source_file_name = (char*)malloc(sizeof(char) * (strlen(file_name)+EXT_FILE_SIZE+strlen(DISASSEMBLY_SUFFIX))))){
+		memoryError("dis_file", file_name);
+		indicator = FATAL_ERROR;
+	}
+	else{
+		strcpy(source_file_name, file_name);
+		strcat(source_file_name, DISASSEMBLY_SUFFIX);
+		if((indicator = writeDisassembly(dis, file_name, source_file_name)) != TRUE){
+			newFileOpenError("dis_file", file_name);
+			indicator = FATAL_ERROR;
+		}
+		else{
+			printf("--- Disassembled %s into %s: %d instructions, %d data words, %d labels", file_name, source_file_name,
+				dis->instructions_amount, dis->data_end - dis->code_end, dis->labels_amount);
+			if(dis->invalid_words)
+				printf(", %d words of the code are not valid instructions", dis->invalid_words);
+			printf(". ---\n");
+		}
+		free(source_file_name);
+	}
+
+	freeObjectImage(&dis->object);
+	freeNamePool(&dis->names);
+	arenaFree(&dis->names_arena);
+	free(dis->extern_names);
+	free(dis);
+	return indicator;
+}
+
+/*
+* The function: decodeDisassembly
+*
+* The function decodes the code of the object to a record of every instruction, in a single pass from its first word,
+* and gives a name to every address that a label operand refers to and to every extern reference.
+*
+* Parameters:
+*	dis - a pointer to the disassembly, with its object.
+*	use_symbols - TRUE to take the names of the labels from the entries and the externs of the object.
+*
+* Returns:
+*	TRUE - if the object was decoded.
+*	FALSE - if the object does not fit in the memory.
+*	FATAL_ERROR - if a memory allocation failure occurred.
+*/
+char decodeDisassembly(disassembly* dis, char use_symbols)
+{
+	disassembledInstruction *instruction;/*The record of the current instruction*/
+	short address, operand_address;/*The address of the current instruction and of the word of its current operand*/
+	short i;/*Counter*/
+
+	dis->code_end = (short)(FIRST_MEMORY_CELL + readObjectField(&dis->object, OBJECT_CODE_WORDS_FIELD, 2));
+	if(dis->code_end + (long)readObjectField(&dis->object, OBJECT_DATA_WORDS_FIELD, 2) > MEMORY_SIZE)
+		return FALSE;
+	dis->data_end = (short)(dis->code_end + readObjectField(&dis->object, OBJECT_DATA_WORDS_FIELD, 2));
+	dis->instructions_amount = dis->labels_amount = dis->invalid_words = dis->extern_names_amount = 0;
+	memset(dis->labels, 0, sizeof(dis->labels));
+	memset(dis->externs, 0, sizeof(dis->externs));
+	memset(dis->referenced, FALSE, sizeof(dis->referenced));
+
+	if(use_symbols && addDisassemblySymbols(dis) != TRUE)
+		return FATAL_ERROR;
+
+	for(address = FIRST_MEMORY_CELL; address < dis->code_end; address += instruction->length){
+		instruction = &dis->instructions[address];
+		instruction->length = 1;
+		if(!decodeFirstWord(getObjectWord(&dis->object, address - FIRST_MEMORY_CELL), &instruction->opcode, instruction->types))
+			instruction->opcode = NO_OPCODE;
+		for(i = 0; i < 2 && instruction->opcode != NO_OPCODE; i++){
+			if(instruction->types[i] == NO_TYPE)
+				continue;
+			instruction->operand_addresses[i] = operand_address = address + operandWordOffset(instruction->types, i);
+			if(operand_address >= dis->code_end ||
+					!(instruction->are[i] = decodeOperandWord(getObjectWord(&dis->object, operand_address - FIRST_MEMORY_CELL), instruction->types[i], i, &instruction->values[i])) ||
+					(instruction->are[i] == (1 << R_ADDRESSING_METHOD) && (instruction->values[i] < FIRST_MEMORY_CELL || instruction->values[i] >= dis->data_end)))
+				instruction->opcode = NO_OPCODE;/*A label outside the object can not be written as a label*/
+		}
+		if(instruction->opcode == NO_OPCODE){
+			dis->invalid_words++;
+			continue;
+		}
+		instruction->length = instructionLength(instruction->types);
+		dis->instructions_amount++;
+
+		for(i = 0; i < 2; i++){
+			if(instruction->types[i] != DIRECT_ADDRESSING)
+				continue;
+			if(instruction->are[i] == (1 << R_ADDRESSING_METHOD))
+				dis->referenced[instruction->values[i]] = TRUE;
+			else if(!dis->externs[instruction->operand_addresses[i]] &&
+					(!(dis->externs[instruction->operand_addresses[i]] = newDisassemblyName(dis, 'X', instruction->operand_addresses[i])) ||
+					!addExternName(dis, dis->externs[instruction->operand_addresses[i]])))
+				return FATAL_ERROR;
+		}
+	}
+
+	/*Every address that a label operand refers to needs a label*/
+	for(address = FIRST_MEMORY_CELL; address < dis->data_end; address++){
+		if(dis->referenced[address] && !dis->labels[address] && !(dis->labels[address] = newDisassemblyName(dis, 'L', address)))
+			return FATAL_ERROR;
+		if(dis->labels[address])
+			dis->labels_amount++;
+	}
+	return TRUE;
+}
+
+/*
+* The function: addDisassemblySymbols
+*
+* The function takes the names of the labels from the entries of the object, and the names of the extern references
+* from its externs. An entry at the address of another entry, and a record outside the object, are ignored.
+*
+* Parameters:
+*	dis - a pointer to the disassembly, with its object.
+*
+* Returns:
+*	TRUE - if the names were added.
+*	FATAL_ERROR - if a memory allocation failure occurred.
+*/
+char addDisassemblySymbols(disassembly* dis)
+{
+	char error_str[ERROR_MESSAGE_SIZE];/*The error of the name pool*/
+	char *name;/*The name of the current record*/
+	short address;/*The address of the current record*/
+	int i, amount;/*Counter and the amount of records of the table*/
+
+	amount = (int)readObjectField(&dis->object, OBJECT_ENTRIES_FIELD, 2);
+	for(i = 0; i < amount; i++){
+		name = getObjectSymbol(&dis->object, OBJECT_ENTRIES_OFFSET_FIELD, i, &address);
+		if(address < FIRST_MEMORY_CELL || address >= dis->data_end || dis->labels[address])
+			continue;
+		if(internName(&dis->names, name, &dis->names_arena, error_str) == NO_NAME)
+			return FATAL_ERROR;
+		dis->labels[address] = name;
+	}
+
+	amount = (int)readObjectField(&dis->object, OBJECT_EXTERNS_FIELD, 2);
+	for(i = 0; i < amount; i++){
+		name = getObjectSymbol(&dis->object, OBJECT_EXTERNS_OFFSET_FIELD, i, &address);
+		if(address < FIRST_MEMORY_CELL || address >= dis->code_end)
+			continue;
+		if(findName(&dis->names, name) == NO_NAME && !addExternName(dis, name))
+			return FATAL_ERROR;
+		dis->externs[address] = name;
+	}
+	return TRUE;
+}
+
+/*
+* The function: addExternName
+*
+* The function adds a name to the names of the object and to the list of the extern names, that are written in the
+* .extern lines.
+*
+* Parameters:
+*	dis - a pointer to the disassembly.
+*	name - the extern name, it is not in the names of the object yet.
+*
+* Returns:
+*	TRUE - if the name was added.
+*	FALSE - if a memory allocation failure occurred.
+*/
+char addExternName(disassembly* dis, char* name)
+{
+	char error_str[ERROR_MESSAGE_SIZE];/*The error of the name pool*/
+	char **temp_names;/*The list after reallocation*/
+	int id;/*The id of the name*/
+
+	if((id = internName(&dis->names, name, &dis->names_arena, error_str)) == NO_NAME)
+		return FALSE;
+	if(!(dis->extern_names_amount & (dis->extern_names_amount-1))){/*The size of the list is the next power of 2*/
+		if(!(temp_names = (char**)realloc(dis->extern_names, sizeof(char*) * (dis->extern_names_amount ? dis->extern_names_amount*2 : 1))))
+			return FALSE;
+		dis->extern_names = temp_names;
+	}
+	dis->extern_names[dis->extern_names_amount++] = dis->names.names[id];
+	return TRUE;
+}
+
+/*
+* The function: newDisassemblyName
+*
+* The function makes a name for an address: a letter and the address (L0123). If the object already has this name,
+* the letter is added again until the name is new.
+*
+* Parameters:
+*	dis - a pointer to the disassembly.
+*	letter - the first letter of the name.
+*	address - the address.
+*
+* Returns:
+*	The name, it is kept in the names of the object, or NULL if a memory allocation failure occurred.
+*/
+char* newDisassemblyName(disassembly* dis, char letter, short address)
+{
+	char name[MAX_LENGTH_OF_LABEL];/*The name*/
+	char error_str[ERROR_MESSAGE_SIZE];/*The error of the name pool*/
+	short letters = 1;/*The amount of letters before the address*/
+	int id;/*The id of the name*/
+
+	do{
+		memset(name, letter, letters);
+		sprintf(name + letters, "%04d", address);
+		letters++;
+	}while(findName(&dis->names, name) != NO_NAME && letters < MAX_LENGTH_OF_LABEL - 5);
+
+	if((id = internName(&dis->names, name, &dis->names_arena, error_str)) == NO_NAME)
+		return NULL;
+	return dis->names.names[id];
+}
+
+/*
+* The function: writeDisassembly
+*
+* The function writes the source of the decoded object: the .entry and .extern lines, the instructions of the code and
+* the .data lines of the data. A word of the code that is not a valid instruction is written in a comment line.
+*
+* Parameters:
+*	dis - a pointer to the decoded object.
+*	file_name - the name of the object files.
+*	source_file_name - the name of the source file to create.
+*
+* Returns:
+*	TRUE - if the file was written.
+*	FALSE - if the file could not be created.
+*	FATAL_ERROR - if a memory allocation failure occurred.
+*/
+char writeDisassembly(disassembly* dis, char* file_name, char* source_file_name)
+{
+	outputBuffer output;/*The source file*/
+	disassembledInstruction *instruction;/*The record of the current instruction*/
+	char *name;/*The name of the current entry*/
+	short address;/*The current address*/
+	short line_words = 0;/*The amount of numbers in the current .data line*/
+	char indicator;/*The result of creating the file*/
+	int i, amount;/*Counter and the amount of entries*/
+
+	if((indicator = outputOpen(&output, source_file_name)) != TRUE)
+		return indicator;
+
+	outputString(&output, "; The source of ");
+	outputString(&output, file_name);
+	outputString(&output, ", decoded from its object.\n");
+	amount = (int)readObjectField(&dis->object, OBJECT_ENTRIES_FIELD, 2);
+	for(i = 0; i < amount; i++){
+		name = getObjectSymbol(&dis->object, OBJECT_ENTRIES_OFFSET_FIELD, i, &address);
+		if(address < FIRST_MEMORY_CELL || address >= dis->data_end || dis->labels[address] != name)
+			continue;/*The names are ignored, or the entry was not given a label*/
+		outputString(&output, ".entry ");
+		outputString(&output, dis->labels[address]);
+		outputChars(&output, "\n", 1);
+	}
+	for(i = 0; i < dis->extern_names_amount; i++){
+		outputString(&output, ".extern ");
+		outputString(&output, dis->extern_names[i]);
+		outputChars(&output, "\n", 1);
+	}
+
+	for(address = FIRST_MEMORY_CELL; address < dis->code_end; address += instruction->length){
+		instruction = &dis->instructions[address];
+		if(instruction->opcode == NO_OPCODE){
+			outputString(&output, "; ");
+			outputDecimal(&output, address, 4);
+			outputString(&output, ": the word ");
+			outputOctal(&output, (unsigned long)getObjectWord(&dis->object, address - FIRST_MEMORY_CELL), 5);
+			outputString(&output, " is not a valid instruction\n");
+			continue;
+		}
+		writeDisassemblyLabel(&output, dis->labels[address]);
+		outputString(&output, getOpcodeName(instruction->opcode));
+		for(i = 0; i < 2; i++){
+			if(instruction->types[i] == NO_TYPE)
+				continue;
+			outputString(&output, (i && instruction->types[0] != NO_TYPE) ? ", " : " ");
+			outputString(&output, operand_prefixes[instruction->types[i]]);
+			if(instruction->types[i] != DIRECT_ADDRESSING)
+				outputDecimal(&output, signedWord(instruction->values[i]), 0);
+			else
+				outputString(&output, (instruction->are[i] == (1 << R_ADDRESSING_METHOD)) ? dis->labels[instruction->values[i]] : dis->externs[instruction->operand_addresses[i]]);
+		}
+		outputChars(&output, "\n", 1);
+	}
+
+	/*A .data line starts at every label, and it has at most DISASSEMBLY_DATA_LINE numbers*/
+	for(address = dis->code_end; address < dis->data_end; address++){
+		if(dis->labels[address] || line_words == DISASSEMBLY_DATA_LINE){
+			if(line_words)
+				outputChars(&output, "\n", 1);
+			line_words = 0;
+		}
+		if(!line_words){
+			writeDisassemblyLabel(&output, dis->labels[address]);
+			outputString(&output, ".data ");
+		}
+		else
+			outputString(&output, ", ");
+		outputDecimal(&output, signedWord(getObjectWord(&dis->object, address - FIRST_MEMORY_CELL)), 0);
+		line_words++;
+	}
+	if(line_words)
+		outputChars(&output, "\n", 1);
+
+	outputClose(&output);
+	return TRUE;
+}
+
+/*
+* The function: writeDisassemblyLabel
+*
+* The function writes the start of a line: the label and a tab, or only a tab if the line has no label.
+*
+* Parameters:
+*	output - a pointer to the output buffer of the source file.
+*	label - the name of the label, or NULL.
+*/
+void writeDisassemblyLabel(outputBuffer* output, char* label)
+{
+	if(label){
+		outputString(output, label);
+		outputChars(output, ":", 1);
+	}
+	outputChars(output, "\t", 1);
+}
+
+/******************************************************************** - END OF DISASSEMBLER - *********************************************************************/
@@ -4,18 +4,18 @@
 * The function: firstPass
 *
 * The main function for managing the first pass stage. 
-* The function iterates over all the lines in the input file, determines the type of the instruction in each line, and 
+* The function iterates over all the lines of the expanded source, determines the type of the instruction in each line, and 
 * directs the handling of the instruction line to the appropriate function. 
 * Additionally, the function generates error messages for the user and updates the data that will be used later in the second pass stage of the process.
 * 
 * Parameters:
-*   input_file - Pointer to the input file to be processed.
-*   input_file_name - Name of the input file (for error reporting).
+*   expanded_source - Pointer to the lines of the source after the pre processor, to be processed.
+*   input_file_name - Name of the .as file (for error reporting, the lines keep their numbers in it).
 *   ic_dc_counter - Array that will store the final amount of instructions and data (for the second pass stage).
-*   macros_list - Pointer to the head of the linked list of macro nodes.
-*   instructions_list - Pointer to the head of the linked list of instruction nodes.
-*   data_list - Pointer to the head of the linked list of data nodes.
-*   declarations_list - Pointer to the head of the linked list of declaration nodes.
+*   macros - Pointer to the macro table of the file.
+*   image - Pointer to the memory image of the file, that receives the code and data words.
+*   symbols - Pointer to the symbol table of the file.
+*   file_arena - Pointer to the arena of the file, the names of the labels are allocated from it.
 *
 * Returns:
 *	indicator = TRUE - If the first pass stage has finished without any errors being detected.
@@ -23,53 +23,53 @@
 * 	FATAL_ERROR - If a memory allocation error occurred.
 *  
 */
-char firstPass(FILE* input_file, char* input_file_name, short* ic_dc_counter, macroNode* macros_list, instructionNode** instructions_list, dataNode** data_list, declarationNode** declarations_list)
+char firstPass(sourceLines* expanded_source, char* input_file_name, short* ic_dc_counter, macroTable* macros, memoryImage* image, symbolTable* symbols, arena* file_arena)
 {
-	short ic = FIRST_MEMORY_CELL; /* The instruction counter, initialized to start counting from the first decimal address number. */
-	short dc = 0; /* the data counter. */
-	char line[MAX_LENGTH_OF_LINE], error_str[ERROR_MESSAGE_SIZE] = { '\0' }; /* Arrays to store the line and the error messages. */ 
+	short ic, dc; /* The instruction counter (starts from the first decimal address number) and the data counter, the next free words of the images. */
+	char line[MAX_LENGTH_OF_LINE], error_str[ERROR_MESSAGE_SIZE] = { '\0' }; /* Arrays to store the line and the error messages. */
+	lineTokens tokens; /* The tokens of the current line. */
 	char instruction_type; /* A variable that will be used to direct the handling of the instruction line to the appropriate function. */ 
 	char indicator = TRUE; /* An indicator that represents the syntax correctness status in the input file. */
-	unsigned int line_num = 1; /* A counter of the current line number */
-	instructionNode *new_instruction = NULL; /* Pointer to newly created instruction node. */
-	dataNode *new_data = NULL; /* Pointer to newly created data node. */
-	declarationNode *new_declaration = NULL; /* Pointer to newly created declaration node. */
-				
-	/* Read each line from the input file. */
-	while(fgets(line, MAX_LENGTH_OF_LINE, input_file)){
+	unsigned int line_num = 0; /* The number of the current line in the input file, a line of a macro has the number of its line in the macro definition. */
+	int line_index = 0; /* The index of the next line in the expanded source. */
+
+	/* Read each line from the expanded source, the line is copied to a string and split into tokens, the tokens point into the copy. */
+	while(line_index < expanded_source->lines_amount){
+		line_num = expanded_source->lines[line_index].number;
+		viewToLine(expanded_source->lines[line_index++], line);
+		lexLine(line, &tokens);
+		ic = FIRST_MEMORY_CELL + image->code.words_amount;
+		dc = image->data.words_amount;
 		/* Checks if a label definition exists on the current line. */
-		if(strchr(line, ':')){
+		if(tokens.label != NO_TOKEN){
 			/* Sends the line to be handled by the function dedicated to label processing. */
-			new_declaration = readNewLabel(line, line_num, macros_list, dc, ic, new_declaration, declarations_list, error_str);			
-			if(!new_declaration){
+			if(readNewLabel(&tokens, line_num, macros, dc, ic, symbols, file_arena, error_str) == FATAL_ERROR){
 				memoryError(error_str, input_file_name);
 				return FATAL_ERROR;
 			}
 		}
-		/* Handle instructions, data, and declarations if no errors are found. */																								
-		if(!error_str[0] && line[0] && line[0] != '\n'){
-			instruction_type = getInstructionType(line, error_str);			
-			
+		/* Handle instructions, data, and declarations if no errors are found. */
+		if(!error_str[0] && tokens.operation != NO_TOKEN){
+			instruction_type = getInstructionType(&tokens, error_str);
+
 			/* Sends the line to be handled by the function dedicated to instruction lines. */
 			if(instruction_type == CODE){
-				new_instruction = readNewInstruction(&ic, line, new_instruction, instructions_list, line_num, error_str);
-				if(!new_instruction){
+				image->instructions_amount++;
+				if(readNewInstruction(&tokens, image, symbols, line_num, file_arena, error_str) == FATAL_ERROR){
 					memoryError(error_str, input_file_name);
 					return FATAL_ERROR;
 				}
 			}
-			/* Sends the line to be handled by the function dedicated to declaration lines. */
+			/* Sends the line to be handled by the function dedicated to declaration lines, a declaration after a label was already handled with the label. */
 			else if(instruction_type >= ENTRY){
-				new_declaration = readNewDeclaration(line, line_num, macros_list, new_declaration, declarations_list, error_str);
-				if(!new_declaration){
+				if((tokens.label == NO_TOKEN) && readNewDeclaration(&tokens, line_num, macros, symbols, file_arena, error_str) == FATAL_ERROR){
 					memoryError(error_str, input_file_name);
 					return FATAL_ERROR;
 				}
 			}
 			/* Sends the line to be handled by the function dedicated to data instruction lines. */
 			else if(instruction_type >= DATA){
-				new_data = readNewData(&dc, instruction_type, line, new_data, data_list, error_str);
-				if(!new_data){
+				if(readNewData(instruction_type, &tokens, image, error_str) == FATAL_ERROR){
 					memoryError(error_str, input_file_name);
 					return FATAL_ERROR;
 				}
@@ -80,11 +80,10 @@ char firstPass(FILE* input_file, char* input_file_name, short* ic_dc_counter, ma
 			indicator = 0;
 			generalError(input_file_name, line_num, error_str);
 			error_str[0] = '\0';
-		}					
-		line_num++; /* advances the line counter. */		
+		}
 	}
 	/* Updates the data counter to the final decimal address. */
-	if(!UpdateDataCounter(*data_list, *declarations_list, ic_dc_counter, ic, dc)){
+	if(!UpdateDataCounter(image, symbols, ic_dc_counter)){
 		indicator = 0;
 		generalError(input_file_name, line_num, "The system cannot proceed due to insufficient available memory.");	
 	}
@@ -95,135 +94,120 @@ char firstPass(FILE* input_file, char* input_file_name, short* ic_dc_counter, ma
 /*
 * The function: UpdateDataCounter
 *
-* The function updates the data counter to the final decimal address of the linked lists of data and declaration.
+* The function checks that the data image, that is placed after the code image, fits in the memory, and updates the 
+* data counter of the labels in the symbol table to the final decimal address.
 * In addition, the function updates the array that stores the final amount of instructions and data.
 *
 * Parameters:
-*   data_list - A pointer to the head of the linked list of data nodes.
-*   declarations_list - A pointer to the head of the linked list of declaration nodes.
+*   image - A pointer to the memory image of the file.
+*   symbols - A pointer to the symbol table.
 *   ic_dc_counter - The array that will store the final amount of instructions and data.
-*   ic - Current instruction counter value.
-*   dc - Current data counter value.
 *
 * Returns:
 *   TRUE - If the amount of the final decimal address fits in the memory size.
 *	FALSE - If the amount of the decimal address is too large for the size of the memory.
 */
-char UpdateDataCounter(dataNode* data_list, declarationNode* declarations_list, short* ic_dc_counter, short ic, short dc)
+char UpdateDataCounter(memoryImage* image, symbolTable* symbols, short* ic_dc_counter)
 {
-	dataNode* temp_data = data_list; /* Temporary pointer to traverse the data nodes. */
-	declarationNode* temp_declaration = declarations_list; /* Temporary pointer to traverse the declaration nodes. */
+	short ic = FIRST_MEMORY_CELL + image->code.words_amount; /* The decimal address of the first data word. */
+	int i; /* Index for traversing the records of the symbol table. */
 	
 	/* Updates the final amount of instructions and data. */
-	ic_dc_counter[0] = ic-FIRST_MEMORY_CELL;
-	ic_dc_counter[1] = dc;
+	ic_dc_counter[0] = image->code.words_amount;
+	ic_dc_counter[1] = image->data.words_amount;
 	
-	/* Updates the decimal addresses for each data node. */
-	while(temp_data){
-		temp_data->dc += ic;
-		/* Check if the updated address exceeds the memory limit. */
-		if(temp_data->dc > MEMORY_CELLS)
-			return FALSE;
-		temp_data = temp_data->next;
-	}
-	/* Updates the decimal addresses for each declaration node, of type data or string */
-	while(temp_declaration){
-		if(temp_declaration->type == DATA || temp_declaration->type == STRING)
-			temp_declaration->decimal_address += ic;
-		temp_declaration = temp_declaration->next;
+	/* Check if the address of the last data word exceeds the memory limit. */
+	if(image->data.words_amount && (ic + image->data.words_amount - 1 > MEMORY_CELLS))
+		return FALSE;
+
+	/* Updates the decimal addresses for each label, of type data or string */
+	for(i = 0; i < symbols->symbols_amount; i++){
+		if(symbols->symbols[i].defined_type == DATA || symbols->symbols[i].defined_type == STRING)
+			symbols->symbols[i].address += ic;
 	}
 	
 	return TRUE;	
 }
 
-/***************************************************************** - INSTRUCTION NODE FUNCTIONS - *****************************************************************/
+/***************************************************************** - INSTRUCTION WORDS FUNCTIONS - ****************************************************************/
 
 /*
 * The function: readNewInstruction
 *
-* The function handles the parsing, validation, encoding, and creation of instruction nodes from a given instruction line.
+* The function handles the parsing, validation, encoding, and adding of the words of a given instruction line to the code image.
 * It orchestrates the process of extracting operands, validating them, encoding the instructions into BMC format, and 
-* creating new instruction nodes according to the instruction type and operands.
+* adding the words according to the instruction type and operands.
 *
 * Parameters:
-*   ic - A pointer to the current instruction counter, which is incremented for each new instruction.
-*   line - A string containing the instruction line.
-*   curr_instruction - A pointer to the currently last instruction node in the linked list.
-*   instructions_list - A pointer to the head of the linked list of instructions.
+*   tokens - A pointer to the tokens of the instruction line.
+*   image - A pointer to the memory image, the words are added to the end of its code image.
+*   symbols - A pointer to the symbol table, that receives a record for every label mentioned in an operand.
 *   line_num - The line number in the input file where the instruction is found.
+*   file_arena - A pointer to the arena that the names of the labels are allocated from.
 *   error_str - A pointer to a buffer where error messages will be stored.
 *
 * Returns:
-*   A pointer to the newly created `instructionNode`, or NULL if a memory allocation error occurs.
+*   TRUE - If the line was handled (an error in the line is stored in error_str).
+*   FATAL_ERROR - If a memory allocation error occurs.
 */
-instructionNode* readNewInstruction(short* ic, char* line, instructionNode* curr_instruction, instructionNode** instructions_list, unsigned int line_num, char* error_str)
+char readNewInstruction(lineTokens* tokens, memoryImage* image, symbolTable* symbols, unsigned int line_num, arena* file_arena, char* error_str)
 {
-	instructionNode *new_instruction = NULL; /* A pointer for the new instruction node. */
-	char source_operand [MAX_LENGTH_OF_LINE], target_operand [MAX_LENGTH_OF_LINE]; /* Buffers for the source and target operands. */
+	char source_operand [MAX_LENGTH_OF_LINE] = { '\0' }, target_operand [MAX_LENGTH_OF_LINE] = { '\0' }; /* Buffers for the source and target operands. */
 	short opcode, source_operand_type, target_operand_type; /* Variables to store the opcode number and the operands type. */
 	short first_word_bmc = 0, source_bmc = 0, target_bmc = 0; /* Variables to store the BMC values for the instruction and the operands. */	
 		
-	opcode = getOpcode(line); /* Retrieves the opcode number according to the opcode name in the line. */
+	opcode = getOpcode(tokens); /* Retrieves the opcode number according to the opcode name in the line. */
 			
 	/* For the first group of instructions: */
 	if(opcode <= LEA){
 		/* Extracts the source and target operands from the instruction line. */
-		if(!readTwoOperands(line, source_operand, target_operand, error_str) && curr_instruction)
-			return curr_instruction;
+		if(!readTwoOperands(tokens, source_operand, target_operand, error_str))
+			return TRUE;
 		/* Checks and gets the type of each operand. */	
 		source_operand_type = isValidSourceOperandType(opcode, source_operand, error_str);	
 		target_operand_type = isValidTargetOperandType(opcode, target_operand, error_str);
-		if(((source_operand_type == NO_TYPE) || (target_operand_type == NO_TYPE)) && curr_instruction)
-			return curr_instruction;
+		if((source_operand_type == NO_TYPE) || (target_operand_type == NO_TYPE))
+			return TRUE;
 			
 		/* Encode the first word of the instruction into BMC representation. */
 		getFirstWordBMC(opcode, source_operand_type, target_operand_type, &first_word_bmc);
-		
-		/* Creates a new instruction node for the instruction line. */		
-		new_instruction = creatInstructionNode((*ic)++, first_word_bmc, NULL, line_num, &curr_instruction, error_str);
-		if(new_instruction){
-			/* Updates the head of the linked list, in case the new instruction node is the first node in the linked list. */					
-			if(!(*instructions_list))
-				*instructions_list = new_instruction;
+		if(!addCodeWord(image, symbols, first_word_bmc, NULL, line_num, file_arena, error_str))
+			return FATAL_ERROR;
 			
-			/* Creates a BMC encoding in case both operands are of register type. */						
-			if((source_operand_type >= INDIRECT_REGISTER_ADDRESSING) && (target_operand_type >= INDIRECT_REGISTER_ADDRESSING)){
-				getSourceRegisterBMC(source_operand, &source_bmc);	
-				getTargetRegisterBMC(target_operand, &source_bmc);
-				
-				/* Creates one new instruction node. */
-				new_instruction = creatInstructionNode((*ic)++, source_bmc, source_operand, line_num, &curr_instruction, error_str);									
-			}
-			/* Creates a BMC encoding according to the type of each operand. */
-			else{				
-				if(source_operand_type == IMMEDIATE_ADDRESSING)
-					getImmediateBMC(source_operand, &source_bmc);
-					
-				if(source_operand_type >= INDIRECT_REGISTER_ADDRESSING)
-					getSourceRegisterBMC(source_operand, &source_bmc);
+		/* Creates a BMC encoding in case both operands are of register type, they share one word. */						
+		if((source_operand_type >= INDIRECT_REGISTER_ADDRESSING) && (target_operand_type >= INDIRECT_REGISTER_ADDRESSING)){
+			getSourceRegisterBMC(source_operand, &source_bmc);	
+			getTargetRegisterBMC(target_operand, &source_bmc);
 			
-				if(target_operand_type == IMMEDIATE_ADDRESSING)
-					getImmediateBMC(target_operand, &target_bmc);	
-					
-				if(target_operand_type >= INDIRECT_REGISTER_ADDRESSING)
-					getTargetRegisterBMC(target_operand, &target_bmc);
-				
-				/* Creates a new instruction node for each operand. */
-				new_instruction = creatInstructionNode((*ic)++, source_bmc, source_operand, line_num, &curr_instruction, error_str);
-				if(new_instruction)		
-					new_instruction = creatInstructionNode((*ic)++, target_bmc, target_operand, line_num, &curr_instruction, error_str);							
-			}
+			return addCodeWord(image, symbols, source_bmc, source_operand, line_num, file_arena, error_str) ? TRUE : FATAL_ERROR;
 		}
+		/* Creates a BMC encoding according to the type of each operand. */
+		if(source_operand_type == IMMEDIATE_ADDRESSING)
+			getImmediateBMC(source_operand, &source_bmc);
+			
+		if(source_operand_type >= INDIRECT_REGISTER_ADDRESSING)
+			getSourceRegisterBMC(source_operand, &source_bmc);
+	
+		if(target_operand_type == IMMEDIATE_ADDRESSING)
+			getImmediateBMC(target_operand, &target_bmc);	
+			
+		if(target_operand_type >= INDIRECT_REGISTER_ADDRESSING)
+			getTargetRegisterBMC(target_operand, &target_bmc);
+		
+		/* Adds a word for each operand. */
+		if(!addCodeWord(image, symbols, source_bmc, source_operand, line_num, file_arena, error_str) ||
+		   !addCodeWord(image, symbols, target_bmc, target_operand, line_num, file_arena, error_str))
+			return FATAL_ERROR;
 	}
 	/* For the second group of instructions: */
 	else if(opcode <= JSR){
 		/* Extracts the target operand from the line. */
-		if(!readTargetOperand(line, target_operand, error_str) && curr_instruction)
-			return curr_instruction;
+		if(!readTargetOperand(tokens, tokens->operands, target_operand, error_str))
+			return TRUE;
 		/* Checks and gets the type of the operand. */
 		target_operand_type = isValidTargetOperandType(opcode, target_operand, error_str);
-		if((target_operand_type == NO_TYPE) && curr_instruction)
-			return curr_instruction;
+		if(target_operand_type == NO_TYPE)
+			return TRUE;
 		
 		/* Encode the first word of the instruction into BMC representation. */		
 		getFirstWordBMC(opcode, NO_TYPE, target_operand_type, &first_word_bmc);
@@ -234,93 +218,62 @@ instructionNode* readNewInstruction(short* ic, char* line, instructionNode* curr
 		if(target_operand_type >= INDIRECT_REGISTER_ADDRESSING)
 			getTargetRegisterBMC(target_operand, &target_bmc);
 		
-		/* Creates a new instruction node for the instruction line. */
-		new_instruction = creatInstructionNode((*ic)++, first_word_bmc, NULL, line_num, &curr_instruction, error_str);
-		if(new_instruction){
-			/* Updates the head of the linked list, in case the new instruction node is the first node in the linked list. */
-			if(!(*instructions_list))
-				*instructions_list = new_instruction;
-			
-			/* Creates a new instruction node for the operand. */
-			new_instruction = creatInstructionNode((*ic)++, target_bmc, target_operand, line_num, &curr_instruction, error_str);
-		}	
+		/* Adds the first word of the instruction and the word of the operand. */
+		if(!addCodeWord(image, symbols, first_word_bmc, NULL, line_num, file_arena, error_str) ||
+		   !addCodeWord(image, symbols, target_bmc, target_operand, line_num, file_arena, error_str))
+			return FATAL_ERROR;
 	}
 	/* For the third group of instructions: */
 	else{
 		/* Checks if the instruction line contains operands when none are expected. */
-		if(!isWhiteSpaceString(line)){
+		if(tokens->operands < tokens->tokens_amount){
 			strcpy(error_str, "The number of operands does not match the opcode type.");
 		}
 		/* Encode the first word of the instruction into BMC representation. */
 		getFirstWordBMC(opcode, NO_TYPE, NO_TYPE, &first_word_bmc);
 		
-		/* Creates a new instruction node for the instruction line. */
-		new_instruction = creatInstructionNode((*ic)++, first_word_bmc, NULL, line_num, &curr_instruction, error_str);
-		if(new_instruction){
-			/* Updates the head of the linked list, in case the new instruction node is the first node in the linked list. */
-			if(!(*instructions_list))
-				*instructions_list = new_instruction;
-		}	
+		/* Adds the first word of the instruction. */
+		if(!addCodeWord(image, symbols, first_word_bmc, NULL, line_num, file_arena, error_str))
+			return FATAL_ERROR;
 	}	
-	return new_instruction;		
+	return TRUE;		
 }
 
 /*
-* The function: creatInstructionNode
+* The function: addCodeWord
 *
-* The function creates a new `instructionNode` with the given parameters and adds it to the end of the linked list of instructions.
+* The function adds a word to the end of the code image. A word that refers to a label can not be encoded yet,
+* so it is added empty, and a fixup with the record of the label in the symbol table is recorded for the second pass.
+* A label that was not seen yet gets an empty record, that is filled if the label is defined or declared later.
 *
 * Parameters:
-*   current_ic - The current instruction counter value to be assigned to the new node.
-*   new_bmc - The BMC value associated with the new node.
-*   label - The label name for the new instruction node, used if it's found that the operand is of a direct addressing type.
+*   image - A pointer to the memory image.
+*   symbols - A pointer to the symbol table.
+*   new_bmc - The BMC value of the word.
+*   label - The label name of the operand, used if it's found that the operand is of a direct addressing type.
 *   line_num - The line number in the input file where the label is mentioned, this will be used in case an error is found during the second pass.
-*   curr_instruction - A pointer to the currently last instruction node in the linked list.
+*   file_arena - A pointer to the arena that the name of a new record is allocated from.
 *   error_str - A pointer to a buffer where an error message will be stored if memory allocation fails.
 *
 * Returns:
-*   A pointer to the newly created `instructionNode`, or NULL if memory allocation fails.
+*   TRUE - If the word was added.
+*   FALSE - If memory allocation fails.
 */
-instructionNode* creatInstructionNode(short current_ic, short new_bmc, char* label, unsigned int line_num, instructionNode** curr_instruction, char* error_str)
+char addCodeWord(memoryImage* image, symbolTable* symbols, short new_bmc, char* label, unsigned int line_num, arena* file_arena, char* error_str)
 {	
-	instructionNode *new_instruction; /* A pointer for the new instruction node. */
-	
-	/* Allocate memory for the new instructionNode. */
-	new_instruction = (instructionNode*)malloc(sizeof(instructionNode));
-	if(!new_instruction){
-		strcpy(error_str, "new instructionNode");
-		return NULL;
-	}
-				
-	new_instruction->ic = current_ic; /* Set the current instruction counter for the new node. */
-	
+	int symbol_index; /* The index of the record of the label in the symbol table. */
+
 	/* Check if it is an absolute type encoding or an address type encoding. */
-	if(isAbsolute(new_bmc)){
-		/* The case that the word can be encoded in the first pass. */
-		new_instruction->line = 0; /* Represents that there is a BMC representation. */
-		new_instruction->type.bmc = new_bmc;
-	}
+	if(isAbsolute(new_bmc))
+		return addImageWord(&image->code, new_bmc, error_str);
+
 	/* Handles the case that the word cannot be encoded in the first pass. */
-	else{
-		new_instruction->line = line_num; /* Set the number of the line where the name of the label is mentioned. */		
-		/* Allocate memory for the name of the label instructionNode. */
-		new_instruction->type.name = (char*)malloc(sizeof(char) * MAX_LENGTH_OF_LINE);
-		if(!(new_instruction->type.name)){
-			strcpy(error_str, "new instructionNode->type.name");
-			free(new_instruction);
-			return NULL;
-		}
-		strcpy(new_instruction->type.name, label); /* Set the label for the instruction node. */
-	}		
-	new_instruction->next = NULL; /* Initialize the next pointer to NULL. */
-	
-	/* Link the new node to the end of the list, if the current node already exists. */
-	if(*curr_instruction)
-		(*curr_instruction)->next = new_instruction;
-		
-	*curr_instruction = new_instruction; /* Updates the curr_instruction node to point to the address of the new_instruction node. */
-	
-	return new_instruction;
+	if((symbol_index = addSymbol(symbols, label, file_arena, error_str)) == NO_SYMBOL)
+		return FALSE;
+	if(!addFixup(image, image->code.words_amount, symbol_index, line_num, error_str))
+		return FALSE;
+
+	return addImageWord(&image->code, 0, error_str);
 }
 
 /*
@@ -337,11 +290,8 @@ instructionNode* creatInstructionNode(short current_ic, short new_bmc, char* lab
 */
 char isAbsolute(short bmc)
 {
-	/* Calculate the bitmask for the absolute addressing method. */
-	short absolute = (short)pow(2, A_ADDRESSING_METHOD);
-	
 	/* Check if the BMC value includes the absolute addressing method bit. */
-	if(bmc & absolute)
+	if(bmc & (1 << A_ADDRESSING_METHOD))
 		return TRUE;
 	
 	return FALSE;
@@ -360,18 +310,8 @@ char isAbsolute(short bmc)
 */
 void getFirstWordBMC(short opcode, short source_operand_type, short target_operand_type, short* bmc)
 {		
-	/* Inserts the binary value of the opcode into the BMC representation. */
-	insertBinaryValueByKeyWords(opcode, bmc, OPCODE_START_POSITION);
-	
-	/* Sets the addressing method bit in the BMC representation. */
-	turnOnBit(bmc, A_ADDRESSING_METHOD);
-	
-	/* Checks if the operand exist on the command line and, if so, sets the corresponding bit in the BMC representation. */
-	if(target_operand_type != NO_TYPE)		
-		turnOnBit(bmc, TARGET_START_POSITION + target_operand_type);
-	
-	if(source_operand_type != NO_TYPE)
-		turnOnBit(bmc, SOURCE_START_POSITION + source_operand_type);
+	/* Inserts the opcode, the addressing method bit and the bits of the operands types into the BMC representation. */
+	*bmc |= encodeFirstWord(opcode, source_operand_type, target_operand_type);
 }
 
 /*
@@ -391,8 +331,7 @@ void getImmediateBMC(char* operand, short* bmc)
 	operand_value = (short)atof(operand+1);
 	
 	/* Gets the BMC representation of the immediate operand. */
-	insertBinaryValueByData(operand_value, bmc, OPERAND_START_POSITION);
-	turnOnBit(bmc, A_ADDRESSING_METHOD);	
+	*bmc |= encodeOperand(operand_value, A_ADDRESSING_METHOD);
 }
 
 /*
@@ -412,8 +351,7 @@ void getSourceRegisterBMC(char* source_register, short* bmc)
 	operand_value = (short)atoi(source_register+1);
 	
 	/* Gets the BMC representation of the source register. */
-	insertBinaryValueByKeyWords(operand_value, bmc, SOURCE_REGISTER_START_POSITION);
-	turnOnBit(bmc, A_ADDRESSING_METHOD);	
+	*bmc |= encodeRegisters(operand_value, NO_REGISTER);
 }
 
 /*
@@ -432,10 +370,8 @@ void getTargetRegisterBMC(char* target_register, short* bmc)
 	/* Convert the numeric part of the target register to a short integer. */
 	operand_value = (short)atoi(target_register+1);	
 	
-	/* Gets the BMC representation of the target register. */
-	insertBinaryValueByKeyWords(operand_value, bmc, TARGET_REGISTER_START_POSITION);
-	if(!isAbsolute(*bmc))
-		turnOnBit(bmc, A_ADDRESSING_METHOD);		
+	/* Gets the BMC representation of the target register, it may share the word with a source register. */
+	*bmc |= encodeRegisters(NO_REGISTER, operand_value);
 }
 
 /*
@@ -557,11 +493,11 @@ short getOperandAddressingType(char* operand ,char* error_str)
 	/* Check if the operand is an indirect register addressing type. */
 	if(operand[0] == '*'){
 		if(operand[1]){
-			if(isRegister(operand+1) == NO_REGISTER){
+			if(getReservedWordId(operand+1, REGISTER_WORD) == NO_REGISTER){
 				strcpy(error_str, "Invalid operand, the register name does not exist in the system.");
 				return NO_TYPE;
 			}
-			continueTo(operand, 1);
+			memmove(operand, operand+1, strlen(operand)); /* Removes the asterisk, the register is encoded like a direct register. */
 			return INDIRECT_REGISTER_ADDRESSING;
 		}
 		else{
@@ -570,7 +506,7 @@ short getOperandAddressingType(char* operand ,char* error_str)
 		}
 	}
 	/* Check if the operand is a direct register addressing type. */
-	if(isRegister(operand) != NO_REGISTER)
+	if(getReservedWordId(operand, REGISTER_WORD) != NO_REGISTER)
 		return DIRECT_REGISTER_ADDRESSING;
 	
 	 /* Validate if the operand is not used as a system keyword. */	
@@ -586,10 +522,11 @@ short getOperandAddressingType(char* operand ,char* error_str)
 /*
 * The function: readTargetOperand
 *
-* The function extracts the target operands from a given line and ensuring the correctness of the format.
+* The function extracts the target operands from the tokens of a given line and ensuring the correctness of the format.
 *
 * Parameters:
-*   line - A pointer to the string containing the line to be processed.
+*   tokens - A pointer to the tokens of the line.
+*   index - The index of the first token of the target operand.
 *   target_operand - A pointer to the buffer where the target operand will be stored.
 *   error_str - A pointer to a buffer where an error message will be stored if validation fails.
 *
@@ -597,17 +534,18 @@ short getOperandAddressingType(char* operand ,char* error_str)
 *   TRUE - If the target operand is valid.
 *	FALSE - If an error is detected.
 */
-char readTargetOperand(char* line, char* target_operand, char* error_str)
+char readTargetOperand(lineTokens* tokens, short index, char* target_operand, char* error_str)
 {
-	char* temp; /* A pointer to check if another operand exists. */
+	short i; /* An index for traversing the tokens. */
 	
-	/* Check for additional operands in the line. */
-	temp = strchr(line, ',');
-	if(temp && !isWhiteSpaceString(temp+1)){
+	/* Check for additional operands in the line, a comma that is followed by another token. */
+	for(i = index; (i < tokens->tokens_amount) && (tokens->tokens[i].type != COMMA_TOKEN); i++)
+		;
+	if(i < tokens->tokens_amount-1){
 		strcpy(error_str, "The number of operands does not match the opcode type.");
 		return FALSE;
 	}	
-	getWord(line, target_operand); /* Extract the target operand from the line. */
+	i = getTokensWord(tokens, index, target_operand); /* Extract the target operand from the line. */
 	
 	/* Validate the target operand's presence. */
 	if(!strlen(target_operand)){
@@ -615,7 +553,7 @@ char readTargetOperand(char* line, char* target_operand, char* error_str)
 		return FALSE;
 	}
 	/* Check for extra characters after the target operand. */
-	if(!isWhiteSpaceString(line)){
+	if(i < tokens->tokens_amount){
 		strcpy(error_str, "Extra characters was detected after the target operand.");
 		return FALSE;
 	}
@@ -626,10 +564,10 @@ char readTargetOperand(char* line, char* target_operand, char* error_str)
 /*
 * The function: readTwoOperands
 *
-* The function extracts the source and target operands from a given line and ensuring the correctness of the format.
+* The function extracts the source and target operands from the tokens of a given line and ensuring the correctness of the format.
 *
 * Parameters:
-*   line - A pointer to the string containing the line to be processed.
+*   tokens - A pointer to the tokens of the line.
 *   source_operand - A pointer to a buffer where the source operand will be stored.
 *   target_operand - A pointer to a buffer where the target operand will be stored.
 *   error_str - A pointer to a buffer where an error message will be stored if the operands' format is incorrect.
@@ -638,26 +576,22 @@ char readTargetOperand(char* line, char* target_operand, char* error_str)
 *   TRUE - If the operands are correctly extracted. 
 *	FALSE - If there is an error in the operands format or amount of operands.
 */
-char readTwoOperands(char* line, char* source_operand, char* target_operand, char* error_str)
+char readTwoOperands(lineTokens* tokens, char* source_operand, char* target_operand, char* error_str)
 {
-	short i = 0, j = 0; /* Indexes for traversing the strings. */
-	char *tail; /* Pointer to track the position of the comma separating the operands. */
-	
-	skipWhiteChar(line);/* Skip initial white spaces in the line */
+	short i, comma; /* Indexes for traversing the tokens. */
+	short j = 0; /* The length of the source operand. */
 	
 	/* Locate the comma that separates the two operands */	
-	tail = strchr(line, ',');
-	if(!tail){
+	for(comma = tokens->operands; (comma < tokens->tokens_amount) && (tokens->tokens[comma].type != COMMA_TOKEN); comma++)
+		;
+	if(comma == tokens->tokens_amount){
 		strcpy(error_str, "The number of operands does not match the opcode type.");
 		return FALSE;
 	}
-	 /* Extract the source operand */
-	while(line+i != tail){
-		if(isspace(line[i])){
-			i++;
-			continue;
-		}
-		source_operand[j++] = line[i++];
+	 /* Extract the source operand, the white characters between the tokens before the comma are ignored */
+	for(i = tokens->operands; i < comma; i++){
+		memcpy(source_operand+j, tokens->tokens[i].start, tokens->tokens[i].length);
+		j += tokens->tokens[i].length;
 	}
 	source_operand[j] = '\0';
 	
@@ -666,16 +600,16 @@ char readTwoOperands(char* line, char* source_operand, char* target_operand, cha
 		strcpy(error_str, "The source operand is missing.");
 		return FALSE;
 	}
-	continueTo(line, ++i); /* Skip the comma and move to the target operand */
 	
 	/* Check for additional commas (which would indicate an error) */
-	tail = strchr(line, ',');
-	if(tail){
-		strcpy(error_str, "Two commas were detected on the command line.");
-		return FALSE;
+	for(i = comma+1; i < tokens->tokens_amount; i++){
+		if(tokens->tokens[i].type == COMMA_TOKEN){
+			strcpy(error_str, "Two commas were detected on the command line.");
+			return FALSE;
+		}
 	}
-	/* Extract the target operand and validate it */
-	if(!readTargetOperand(line, target_operand, error_str))
+	/* Extract the target operand, that follows the comma, and validate it */
+	if(!readTargetOperand(tokens, comma+1, target_operand, error_str))
 		return FALSE;
 	
 	return TRUE;
@@ -684,147 +618,69 @@ char readTwoOperands(char* line, char* source_operand, char* target_operand, cha
 /*
 * The function: getOpcode
 *
-* The function extracts the opcode from a given line and returns its corresponding numerical value.
+* The function returns the numerical value of the opcode of a given line.
 *
 * Parameters:
-*   line - A pointer to the string containing the line to be processed.
+*   tokens - A pointer to the tokens of the line, the operation was already found in the reserved words table by the lexer.
 *
 * Returns:
 *   The numerical value of the opcode if found, or a negative value if the opcode is not valid.
 */
-short getOpcode(char* line)
+short getOpcode(lineTokens* tokens)
 {
-	char opcode[MAX_LENGTH_OF_LINE]; /* Array to store the extracted opcode. */
-	short opcode_num; /* Variable to store the numerical value of the opcode. */
-	
-	getWord(line, opcode); /* Extract the opcode from the line */
-	opcode_num = isOpcode(opcode); /* Determine the numerical value of the opcode */
-
-	return opcode_num;
-}
+	/* Determine the numerical value of the opcode */
+	if(!tokens->reserved || tokens->reserved->kind != OPCODE_WORD)
+		return NO_OPCODE;
 
-/*
-* The function: freeInstructionsList
-*
-* The function responsible for freeing the memory allocated for a linked list of instructionNode structures, 
-* including the dynamically allocated memory for the instruction data.
-* 
-* Parameters:
-*   instructions_list - A pointer to the head of the linked list of instructionNode structures to be freed. 
-*/
-void freeInstructionsList(instructionNode* instructions_list)
-{
-	instructionNode* temp; /* A temporary pointer to hold the next node in the list. */
-	
-	/* Iterating through the linked list until all nodes are freed. */	
-	while(instructions_list){
-		/* If line is non-zero then there is memory allocation for the mentioned label name in the instruction. */
-		if(instructions_list->line)
-			free(instructions_list->type.name);									
-		temp = instructions_list->next; /* Store the next node in the list. */
-		free(instructions_list); /* Free the current node. */
-		instructions_list = temp; /* Move to the next node in the list. */
-	}
+	return tokens->reserved->id;
 }
 
-/******************************************************************** - DATA NODE FANCTIONS - ********************************************************************/
+/******************************************************************** - DATA WORDS FUNCTIONS - *******************************************************************/
 
 /*
 * The function: readNewData
 *
-* The function handles the parsing, validation, and creation of data nodes from a given data instruction line. 
+* The function handles the parsing, validation, and adding of the words of a given data instruction line to the data image. 
 * It processes the line based on the type of data instruction (either .data or a .string), encodes the data into 
-* the BMC format, and creates new data nodes in the linked list accordingly.
+* the BMC format, and adds the words to the end of the data image.
 *
 * Parameters:
-*   dc - A pointer to the current data counter value, which will be incremented as new data nodes are created.
 *   type - A short value indicating the type of data (either DATA or STRING).
-*   line -  A string containing the data instruction line.
-*   curr_data - A pointer to the currently last data node in the linked list.
-*   data_list - A pointer to the head of the linked list of data nodes.
+*   tokens - A pointer to the tokens of the data instruction line.
+*   image - A pointer to the memory image, the words are added to the end of its data image.
 *   error_str - A pointer to a buffer where an error message will be stored.
 *
 * Returns:
-*   A pointer to the newly created data node if successful, or NULL if memory allocation fails.
+*   TRUE - If the line was handled (an error in the line is stored in error_str).
+*   FATAL_ERROR - If memory allocation fails.
 */
-dataNode* readNewData(short* dc, short type, char* line, dataNode* curr_data, dataNode** data_list, char* error_str)
+char readNewData(short type, lineTokens* tokens, memoryImage* image, char* error_str)
 {
-	dataNode* new_data; /* Pointer to the newly created data node. */
 	short data_arr[MAX_LENGTH_OF_LINE] = {0}; /* Buffer for storing the parsed data elements. */
-	short length; /* Length of the parsed data elements array. */
-	short i = 0; /* Index for iterating through the data elements array. */
-	
-	skipWord(line);	/* Skips the data instruction word in the line. */
+	short length = 0; /* Length of the parsed data elements array. */
+	short i; /* Index for iterating through the data elements array. */
 	
 	/* Reads and parses the data instruction line according to the specified type. */
 	if(type == DATA)
-		length = readNumbers(line, data_arr, error_str);
+		length = readNumbers(tokens, data_arr, error_str);
 	if(type == STRING)
-		length = readString(line, data_arr, error_str);
+		length = readString(tokens, data_arr, error_str);
 	
-	/* If no data was processed. */	
-	if((length == 0) && curr_data)
-		return curr_data;
-	
-	/* Iterates through the parsed data elements and creates new data nodes. */
-	while(i < length){
-		new_data = creatDataNode((*dc)++, data_arr[i++], &curr_data, error_str);
-		if(!new_data)
-			return NULL;
-		
-		/* Updates the head of the linked list if the new data node is the first node. */
-		if(!(*data_list))
-			*data_list = new_data;
-
+	/* Adds the parsed data elements to the data image, nothing is added if an error was found. */
+	for(i = 0; i < length; i++){
+		if(!addImageWord(&image->data, data_arr[i], error_str))
+			return FATAL_ERROR;
 	}
-	return new_data;
-}
-
-/*
-* The function: creatDataNode
-*
-* The function creates a new data node, initializes it with the given data counter and binary machine code values, and links the new data node to the end of the linked list.
-*
-* Parameters:
-*   current_dc - The current data counter value.
-*   new_bmc - The binary machine code value to be stored in the new data node.
-*   curr_data - A pointer to the currently last data node in the linked list.
-*   error_str - A pointer to a buffer where an error message will be stored if memory allocation fails.
-*
-* Returns:
-*   A pointer to the newly created data node if successful, or NULL if memory allocation fails.
-*/
-dataNode* creatDataNode(short current_dc, short new_bmc, dataNode** curr_data, char* error_str)
-{	
-	dataNode *new_data; /* Pointer to the newly created data node. */
-	
-	/* Allocate memory for the new data node. */
-	new_data = (dataNode*)malloc(sizeof(dataNode));
-	if(!new_data){
-		strcpy(error_str, "new dataNode");
-		return NULL;
-	}
-	/* Initialize the new data node with the given data counter and binary machine code. */			
-	new_data->dc = current_dc;
-	new_data->bmc = new_bmc;			
-	new_data->next = NULL;
-	
-	/* Link the new node to the end of the linked list. */
-	if(*curr_data)
-		(*curr_data)->next = new_data;
-		
-	*curr_data = new_data; /* Updates the curr_data node to point to the address of the new_data node. */
-		
-	return new_data;
+	return TRUE;
 }
 
 /*
 * The function: readNumbers
 *
-* The function parses a line of text containing numbers separated by commas, checks their validity, and stores the numbers in the given list.
+* The function parses the tokens of a line containing numbers separated by commas, checks their validity, and stores the numbers in the given list.
 *
 * Parameters:
-*   line - A pointer to the string containing the line of numbers to be processed.
+*   tokens - A pointer to the tokens of the line of numbers to be processed.
 *   numbers_list - A pointer to the array where the numbers will be stored.
 *   error_str - A pointer to a buffer where an error message will be stored if a validation fails.
 *
@@ -832,20 +688,21 @@ dataNode* creatDataNode(short current_dc, short new_bmc, dataNode** curr_data, c
 *   The number of numbers stored in the numbers_list array. 
 *	FALSE - If a validation fails.
 */
-short readNumbers(char* line, short* numbers_list, char* error_str)
+short readNumbers(lineTokens* tokens, short* numbers_list, char* error_str)
 {
-	char *token; /* Pointer to the current token in the line. */
+	short i; /* Index of the current token. */
 	short length = 0; /* Counts to the number of numbers stored. */
 	double num; /* Temporary variable to store the current number being processed. */
 
 	/* Check if the line is valid according to .data instruction format. */
-	if(!dataLineCheck(line, error_str))
+	if(!dataLineCheck(tokens, error_str))
 		return FALSE;
 	
-	/* Split the line into tokens separated by commas. */		
-	token = strtok(line, ",");	
-	while(token){
-		num = atof(token);
+	/* Every number starts the operands or follows a comma, like atof the words after it until the next comma are ignored. */
+	for(i = tokens->operands; i < tokens->tokens_amount; i++){
+		if((i > tokens->operands) && (tokens->tokens[i-1].type != COMMA_TOKEN))
+			continue;
+		num = (tokens->tokens[i].type == NUMBER_TOKEN) ? tokens->tokens[i].value : 0;
 		
 		/* Check if the number is a non-integer. */
 		if(num != (int)num){
@@ -858,9 +715,7 @@ short readNumbers(char* line, short* numbers_list, char* error_str)
 			return FALSE;
 		}
 		/* Store the number in the numbers_list array. */
-		insertBinaryValueByData((short)num, &numbers_list[length++], 0);
-						
-		token = strtok(NULL, ",");  /* Get the next token. */
+		numbers_list[length++] = encodeData((short)num);
 	}
 
 	return length;	
@@ -872,48 +727,39 @@ short readNumbers(char* line, short* numbers_list, char* error_str)
 * The function checks if a line containing a .data instruction is valid by ensuring proper formatting of the numbers and commas.
 *
 * Parameters:
-*   line - A pointer to the string containing the line to be checked.
+*   tokens - A pointer to the tokens of the line to be checked.
 *   error_str - A pointer to a buffer where an error message will be stored if the line is not valid.
 *
 * Returns:
 *   TRUE - If the line is valid according to the .data instruction format.
 *   FALSE - If the line is not valid or contains formatting errors.
 */
-char dataLineCheck(char* line, char* error_str)
+char dataLineCheck(lineTokens* tokens, char* error_str)
 {
-	char *tail; /* Pointer to the last occurrence of a comma in the line. */
-	short i = 0; /* Index for traversing the characters in the line. */
-	short j = 0; /* Counter for consecutive commas. */
-	
-	skipWhiteChar(line); /* Skip initial white spaces in the line. */
+	short i; /* Index for traversing the tokens. */
+	token *last = &tokens->tokens[tokens->tokens_amount-1]; /* The last token of the line. */
 	
 	/* Check if the line is empty after the .data instruction. */
-	if(!line[0]){
+	if(tokens->operands == tokens->tokens_amount){
 		strcpy(error_str, "Invalid data instruction, no number was detected after the instruction name.");	
 		return FALSE;
 	}
 	/* Check if the line starts with a comma. */
-	if(line[0] == ','){
+	if(tokens->tokens[tokens->operands].type == COMMA_TOKEN){
 		strcpy(error_str, "Invalid data instruction, a comma was detected before the first number.");
 		return FALSE;
 	}
 	/* Check if the line ends with a comma. */
-	tail = strrchr(line, ',');
-	if(tail && isWhiteSpaceString(tail+1)){
+	if(last->type == COMMA_TOKEN){
 		strcpy(error_str, "Invalid data instruction, a comma was detected without a number following it.");
 		return FALSE;
 	}
-	/* Traverse the line to check for formatting issues. */		
-	while(line[i]){
-		if(line[i] == ',')
-			j++;		
-		else if(!isspace(line[i]))
-			j = 0;		
-		if(j > 1){
+	/* Traverse the tokens to check for two commas in a row. */		
+	for(i = tokens->operands+1; i < tokens->tokens_amount; i++){
+		if((tokens->tokens[i].type == COMMA_TOKEN) && (tokens->tokens[i-1].type == COMMA_TOKEN)){
 			strcpy(error_str, "Invalid data instruction, two consecutive commas were detected without a digit between them.");
 			return FALSE;
 		}
-		i++;
 	}
 	return TRUE;
 }
@@ -933,8 +779,8 @@ char dataLineCheck(char* line, char* error_str)
 */
 char checkBitException(int num, short max_bits)
 {
-	int max_value = pow(2,max_bits) -1; /* Maximum representable value. */
-	int min_value = -pow(2,max_bits); /* Minimum representable value. */
+	int max_value = (1 << max_bits) - 1; /* Maximum representable value. */
+	int min_value = -(1 << max_bits); /* Minimum representable value. */
 	
 	return ((max_value >= num) && (num >= min_value))? TRUE : FALSE;
 }
@@ -942,10 +788,10 @@ char checkBitException(int num, short max_bits)
 /*
 * The function: readString
 *
-* The function reads a string from the line, checks its validity, and stores the characters in the given list.
+* The function reads a string from the tokens of the line, checks its validity, and stores the characters in the given list.
 *
 * Parameters:
-*   line - A pointer to the string containing the line to be processed.
+*   tokens - A pointer to the tokens of the line to be processed.
 *   char_list - A pointer to an array where the characters of the string will be stored.
 *   error_str - A pointer to a buffer where an error message will be stored if a validation fails.
 *
@@ -953,19 +799,17 @@ char checkBitException(int num, short max_bits)
 *   The length of the string (including the null terminator) if successful.
 *   FALSE - If the string is not valid or an unprintable character is detected.
 */
-short readString(char* line, short* char_list, char* error_str)
+short readString(lineTokens* tokens, short* char_list, char* error_str)
 {
 	char *temp; /* Pointer to traverse the string within the line. */
 	short length = 0; /* Counter to track the length of the string being processed. */
 	
-	skipWhiteChar(line); /* Skip initial white spaces in the line. */
-	
 	/* Check if the line is a valid string. */
-	if(!stringLineCheck(line, error_str))
+	if(!stringLineCheck(tokens, error_str))
 		return FALSE;
 	
 	/* Start reading the string after the opening quotation mark. */
-	temp = line+1;
+	temp = tokens->tokens[tokens->operands].start+1;
 	while(temp[length] != '"'){
 		/* Check for unprintable characters within the string. */
 		if(!isprint(temp[length])){
@@ -984,41 +828,34 @@ short readString(char* line, short* char_list, char* error_str)
 /*
 * The function: stringLineCheck
 *
-* The function checks if a given line is correctly formatted as a string.
+* The function checks if the tokens of a given line are correctly formatted as a string.
 *
 * Parameters:
-*   line - A pointer to the string to be checked.
+*   tokens - A pointer to the tokens of the line to be checked.
 *   error_str - A pointer to a buffer where an error message will be stored if a validation fails.
 *
 * Returns:
 *   TRUE - If the line is correctly formatted as a string.
 *   FALSE - If the line is not correctly formatted.
 */
-char stringLineCheck(char* line, char* error_str)
+char stringLineCheck(lineTokens* tokens, char* error_str)
 {
-	char *tail1, *tail2; /* Pointers to track the positions of the first and the second quotation marks. */
+	token *string; /* The string token, from the first quotation mark. */
 	
 	/* Checks if the line starts with a quotation mark. */
-	if(*line != '"'){
+	if((tokens->operands == tokens->tokens_amount) || (tokens->tokens[tokens->operands].type != STRING_TOKEN)){
 		strcpy(error_str, "Invalid string instruction, a character was detected before the first quotation mark.");
 		return FALSE;
 	}
-	/* Finds the first quotation mark in the line. */
-	tail1 = strchr(line, '"');
-	if(!tail1){
-		strcpy(error_str, "Invalid string instruction, no quotation marks were detected.");
-		return FALSE;
-	}
-	tail1 = tail1+1; 
+	string = &tokens->tokens[tokens->operands];
 	
-	/* Finds the closing quotation mark in the line. */
-	tail2 = strchr(tail1, '"');
-	if(!tail2){
+	/* Checks that the string ends with the closing quotation mark. */
+	if((string->length < 2) || (string->start[string->length-1] != '"')){
 		strcpy(error_str, "Invalid string instruction, no closing quotation marks were detected.");
 		return FALSE;
 	}
 	 /* Checks if there are any characters after the closing quotation mark. */
-	if(!isWhiteSpaceString(tail2+1)){
+	if(tokens->operands+1 < tokens->tokens_amount){
 		strcpy(error_str, "Invalid string instruction, characters were detected after the second quotation mark.");
 		return FALSE;
 	}
@@ -1026,27 +863,7 @@ char stringLineCheck(char* line, char* error_str)
 	return TRUE;
 }
 
-/*
-* The function: freeDataList
-*
-* The function responsible for freeing the memory allocated for a linked list of dataNode structures.
-* 
-* Parameters:
-*   data_list - A pointer to the head of the linked list of dataNode structures to be freed.
-*/
-void freeDataList(dataNode* data_list)
-{
-	dataNode* temp; /* A temporary pointer to hold the next node in the list. */
-		
-	/* Iterating through the linked list until all nodes are freed. */
-	while(data_list){								
-		temp = data_list->next; /* Store the next node in the list. */
-		free(data_list); /* Free the current node. */
-		data_list = temp; /* Move to the next node in the list. */
-	}
-}
-
-/***************************************************************** - DECLARATION NODE FUNCTIONS - *****************************************************************/
+/******************************************************************* - DECLARATION FUNCTIONS - ********************************************************************/
 
 /*
 * The function: readNewDeclaration
@@ -1054,56 +871,48 @@ void freeDataList(dataNode* data_list)
 * The main function to handle the process of creating a new declaration label. (e.g. entery and external)
 *
 * Parameters:
-*   line - A pointer to the string containing the line to be processed.
+*   tokens - A pointer to the tokens of the line to be processed.
 *   line_num - The number of the line being processed.
-*   macros_list - A pointer to the head of the linked list of macro nodes.
-*   curr_declaration - A pointer to the currently last declaration node in the linked list.
-*   declarations_list - A pointer to the head of the linked list of declaration nodes.
+*   macros - A pointer to the macro table of the file.
+*   symbols - A pointer to the symbol table.
+*   file_arena - A pointer to the arena that the name of a new label is allocated from.
 *   error_str - A pointer to a buffer where an error message will be stored if a validation fails or memory allocation fails.
 *
 * Returns:
-*   A pointer to the newly created declaration node if successful, or NULL if memory allocation fails.
+*   TRUE - If the declaration was recorded in the symbol table.
+*   FALSE - If an error was found in the declaration line.
+*   FATAL_ERROR - If a memory allocation failure occurred.
 */
-declarationNode* readNewDeclaration(char* line, unsigned int line_num, macroNode* macros_list, declarationNode* curr_declaration, declarationNode** declarations_list, char* error_str)
+char readNewDeclaration(lineTokens* tokens, unsigned int line_num, macroTable* macros, symbolTable* symbols, arena* file_arena, char* error_str)
 {
 	char label_name[MAX_LENGTH_OF_LINE]; /* Holds the extracted label name from the line. */
     char instruction_type; /* Stores the type of instruction identified in the line. */
-    declarationNode *new_declaration; /* Pointer to the newly created declaration node. */
+	short next; /* The index of the token after the label name. */
 	
-	instruction_type = getInstructionType(line, error_str); /* Determines the type of instruction in the line. */
-	skipWord(line);
+	instruction_type = getInstructionType(tokens, error_str); /* Determines the type of instruction in the line. */
 	
 	/* Extracts the label name from the line and validates its length. */
-	getWord(line, label_name);
+	next = getTokensWord(tokens, tokens->operands, label_name);
 	if(strlen(label_name) > MAX_LENGTH_OF_LABEL-1){
 		strcpy(error_str, "Invalid label name, label name contains more than 31 characters.");
 		label_name[MAX_LENGTH_OF_LABEL] = '\0';
 	}
 	/* Checks for additional characters after the label name and sets an error message if found. */
-	if(!isWhiteSpaceString(line)){
+	if(next < tokens->tokens_amount){
 		sprintf(error_str, "Invalid label declaration, additional characters after the label name: %s", label_name);
-		if(curr_declaration)
-			return curr_declaration;
+		return FALSE;
 	}
 	
 	/* Check the correctness of the name of the label. */	
-	if(!checkLabelName(label_name, macros_list, error_str) && curr_declaration)
-		return curr_declaration;
+	if(!checkLabelName(label_name, macros, error_str))
+		return FALSE;
 		
 	/* Checks for conflicts with existing labels. */
-	if(!checkIfLabelNameAlreadyDeclared(label_name, instruction_type, *declarations_list, error_str) && curr_declaration)
-		return curr_declaration;
-	
-	/* Creates a new declaration node and handles memory allocation failure. */			
-	new_declaration = creatDeclarationNode(line_num, label_name, instruction_type, curr_declaration, error_str);
-	if(!new_declaration)
-		return NULL;	
-	
-	/* Updates the head of the linked list, in case the new declaration node is the first declaration node created. */
-	if(!(*declarations_list))
-		*declarations_list = new_declaration;
+	if(!checkIfLabelNameAlreadyDeclared(label_name, instruction_type, symbols, error_str))
+		return FALSE;
 	
-	return new_declaration;
+	/* Records the declaration in the symbol table. */			
+	return declareSymbol(symbols, label_name, instruction_type, line_num, file_arena, error_str);
 
 }
 
@@ -1111,44 +920,46 @@ declarationNode* readNewDeclaration(char* line, unsigned int line_num, macroNode
 * The function: readNewLabel
 *
 * The function processes a label declaration from a given line, verify that the label name is correct, 
-* and creates a new declaration node in the linked list accordingly. 
+* and records the label in the symbol table accordingly. 
 * It handles defining labels for several different types of instructions (data, string, code).
 *
 * Parameters:
-*   line - A pointer to the string containing the line to be processed.
+*   tokens - A pointer to the tokens of the line to be processed.
 *   line_num - The number of the line being processed.
-*   macros_list - A pointer to the head of the linked list of macro nodes.
+*   macros - A pointer to the macro table of the file.
 *   dc - The current data counter value.
 *   ic - The current instructions counter value.
-*   curr_declaration - A pointer to the currently last declaration node in the linked list.
-*   declarations_list - A pointer to the head of the linked list of declaration nodes.
+*   symbols - A pointer to the symbol table.
+*   file_arena - A pointer to the arena that the name of a new label is allocated from.
 *   error_str - A pointer to a buffer where an error message will be stored.
 *
 * Returns:
-*   A pointer to the newly created declaration node if successful, or NULL if memory allocation fails.
+*   TRUE - If the label was recorded in the symbol table.
+*   FALSE - If an error was found in the label or in the declaration that follows it.
+*   FATAL_ERROR - If a memory allocation failure occurred.
 */
-declarationNode* readNewLabel(char* line, unsigned int line_num, macroNode* macros_list, short dc, short ic, declarationNode* curr_declaration, declarationNode** declarations_list, char* error_str)
+char readNewLabel(lineTokens* tokens, unsigned int line_num, macroTable* macros, short dc, short ic, symbolTable* symbols, arena* file_arena, char* error_str)
 {
 	char instruction_type; /* Stores the type of instruction identified in the line. */
 	char label_name[MAX_LENGTH_OF_LINE]; /* Buffer for storing the label name parsed from the line. */
-	declarationNode *new_declaration; /* Pointer to the newly created declaration node. */
+	char indicator; /* The result of recording the label. */
 	
 	/* Validates and extracts the label name from the line. */
-	if(!getLabelName(line, label_name, error_str, macros_list) && curr_declaration)
-		return curr_declaration;
+	if(!getLabelName(tokens, label_name, error_str, macros))
+		return FALSE;
 	
 	/* Determines the type of instruction in the line. */
-	instruction_type = getInstructionType(line, error_str);
-	if((instruction_type == NO_TYPE) && curr_declaration)
-		return curr_declaration;
+	instruction_type = getInstructionType(tokens, error_str);
+	if(instruction_type == NO_TYPE)
+		return FALSE;
 	
 	/* Checks if the label name conflicts with a name that has already been defined or declared as extern. */
-	if(!checkIfLabelNameAlreadyDeclared(label_name, instruction_type, *declarations_list, error_str) && curr_declaration)
-		return curr_declaration;
+	if(!checkIfLabelNameAlreadyDeclared(label_name, instruction_type, symbols, error_str))
+		return FALSE;
 	
-	/* Creates a new declaration node based on the instruction type: */
+	/* Records the label based on the instruction type: */
 	if(instruction_type == CODE)
-		new_declaration = creatDeclarationNode(ic, label_name, instruction_type, curr_declaration, error_str);
+		indicator = declareSymbol(symbols, label_name, instruction_type, ic, file_arena, error_str);
 	
 	else if(instruction_type >= ENTRY){
 		/* Handles extern and entry declarations if a label precedes them is found. */
@@ -1157,93 +968,33 @@ declarationNode* readNewLabel(char* line, unsigned int line_num, macroNode* macr
 		else
 			printf("--- Warning: A label name was detected before an extern declaration in line number: %d ---\n", line_num);
 		
-		new_declaration = readNewDeclaration(line, line_num, macros_list, curr_declaration, declarations_list, error_str);
+		indicator = readNewDeclaration(tokens, line_num, macros, symbols, file_arena, error_str);
 	}
 	else
-		new_declaration = creatDeclarationNode(dc, label_name, instruction_type, curr_declaration, error_str);
-
-	skipWhiteChar(line); /* Advance to the start of the instruction or to the end of the line in the case of an entry or extern declaration. */
-	
-	/* Handles memory allocation failure for the new declaration node. */
-	if(!new_declaration)
-		return NULL;
-	
-	/* Updates the head of the declarations list if this is the first node. */
-	if(!(*declarations_list))
-		*declarations_list = new_declaration;
+		indicator = declareSymbol(symbols, label_name, instruction_type, dc, file_arena, error_str);
 				
-	return new_declaration;
-}
-
-/*
-* The function: creatDeclarationNode
-*
-* The function creates a new declaration node with the given parameters and links it to the current declaration node.
-*
-* Parameters:
-*   current_num - The decimal address or the line number to be assigned to the new declaration node.
-*   label_name - The name of the label to be assigned to the new declaration node.
-*   instruction_type - The type of the instruction.
-*   curr_declaration - A pointer to the currently last declaration node in the linked list.
-*   error_str - A pointer to a buffer where an error message will be stored if memory allocation fails.
-*
-* Returns:
-*   A pointer to the newly created declaration node if successful, or NULL if memory allocation fails.
-*/
-declarationNode* creatDeclarationNode(short current_num, char* label_name, char instruction_type, declarationNode* curr_declaration, char* error_str)
-{
-	declarationNode *new_declaration; /* A pointer for the new declaration node. */
-	
-	/* Allocate memory for the new declaration node. */
-	new_declaration = (declarationNode*)malloc(sizeof(declarationNode));
-	if(!new_declaration){
-		strcpy(error_str, "new declarationNode");
-		return NULL;
-	}
-	/* Allocate memory for the label name in the new node. */
-	new_declaration->label = (char*)malloc(sizeof(char) * (strlen(label_name)+1));
-	if(!new_declaration->label){
-		strcpy(error_str, "new declarationNode->label");
-		free(new_declaration);
-		return NULL;
-	}
-	/* Initialize the fields of the new declaration node. */
-	new_declaration->decimal_address = current_num;
-	strcpy(new_declaration->label, label_name);
-	new_declaration->type = instruction_type;
-	new_declaration->next = NULL;
-	
-	/* Link the new node to the end of the linked list. */
-	if(curr_declaration)
-		curr_declaration->next = new_declaration;
-	
-	curr_declaration = new_declaration; /* Updates the curr_declaration node to point to the address of the new_declaration node. */
-	
-	return new_declaration;
+	return indicator;
 }
 
 /*
 * The function: getLabelName
 *
-* The main function for handling label names, the function extracts the label name from the current line and verifies that the name is correct.
+* The main function for handling label names, the function extracts the label name from the label token of the current line and verifies that the name is correct.
 *
 * Parameters:
-*   line - A pointer to the string containing the line from which the label name will be extracted.
+*   tokens - A pointer to the tokens of the line, the label token holds the text before the colon.
 *   label_name - A pointer to a buffer where the extracted label name will be stored.
 *   error_str - A pointer to a buffer where an error message will be stored if the label name is invalid.
-*   macros_list - A pointer to the head of the linked list of macro nodes used to check if the label name already exists as a macro name.
+*   macros - A pointer to the macro table used to check if the label name already exists as a macro name.
 *
 * Returns:
 *   TRUE - If the label name is valid.
 *   FALSE - If there is an error in the label name.
 */
-char getLabelName(char* line, char* label_name, char* error_str, macroNode* macros_list)
+char getLabelName(lineTokens* tokens, char* label_name, char* error_str, macroTable* macros)
 {
-	char *tail; /* A temporary pointer to hold the position of the colon in the string. */
-	short label_len; /* A variable to hold the length of the name of the label. */
-	
-	tail = strchr(line, ':'); /* Find the position of the colon in the line. */		
-	label_len = strlen(line) - strlen(tail); /* Calculate the length of the label name based on the position of the colon. */
+	token *label = &tokens->tokens[tokens->label]; /* The label token of the line. */
+	short label_len = label->length; /* A variable to hold the length of the name of the label. */
 	
 	/* Check if the label name length exceeds the maximum allowed length. */
 	if(label_len >= MAX_LENGTH_OF_LABEL){
@@ -1251,22 +1002,21 @@ char getLabelName(char* line, char* label_name, char* error_str, macroNode* macr
 		label_len = MAX_LENGTH_OF_LABEL -1;
 	}
 	/* Copy the label name from the line to the label_name buffer. */	
-	strncpy(label_name, line, label_len);
+	strncpy(label_name, label->start, label_len);
 	label_name[label_len] = '\0';
 	
 	/* Validate the label name and check if it is not already used as a name of macro. */
-	if(!checkLabelName(label_name, macros_list, error_str))
+	if(!checkLabelName(label_name, macros, error_str))
 		return FALSE; 
 	
 	/* Checks if there is at least one white character after the colon */	
-	if(!isspace(line[label_len+1])){
+	if(!isspace(label->start[label_len+1])){
 		strcpy(error_str, "Invalid label definition, no space was detected after the colon.");
 		return FALSE;	
 	}	
-	skipWord(line);/* Skip the label name and the colon in the line. */
 	
 	/* Check if there is any instruction following the label. */
-	if(isWhiteSpaceString(line)){
+	if(tokens->operation == NO_TOKEN){
 		sprintf(error_str, "Invalid label definition, no instruction was detected after the label: %s", label_name);
 		return FALSE;
 	}
@@ -1282,43 +1032,41 @@ char getLabelName(char* line, char* label_name, char* error_str, macroNode* macr
 * Parameters:
 *   label_name - A pointer to the string containing the label name to be checked.
 *   instruction_type - The instruction type of the given label.
-*   declarations_list - A pointer to the head of the linked list of declaration nodes.
+*   symbols - A pointer to the symbol table.
 *   error_str - A pointer to a buffer where an error message will be stored if a conflict is found.
 *
 * Returns:
 *   TRUE - If the label name does not conflict with any other label name.
 *   FALSE - If there is a conflict with a previously defined or declared label name.
 */
-char checkIfLabelNameAlreadyDeclared(char* label_name, short instruction_type, declarationNode* declarations_list, char* error_str)
+char checkIfLabelNameAlreadyDeclared(char* label_name, short instruction_type, symbolTable* symbols, char* error_str)
 {
-	declarationNode *temp = declarations_list; /* A temporary pointer to traverse all nodes of the linked list */
+	int index; /* The index of the record of the label in the symbol table. */
+	symbol *record; /* The record of the label. */
 	
-	/* Iterate through the list of declaration nodes. */
-	while(temp){
-		/* Check if the current node's label matches the given label name. */
-		if(!strcmp(label_name, temp->label)){
-			/* Handle conflicts based on the instruction type of the given label and the instruction type of the existing label. */
-			if((instruction_type == EXTERN) && (temp->type != EXTERN)){
-				if(temp->type == ENTRY)
-					sprintf(error_str, "Invalid label, the label: %s has already been declared as an entry.", label_name);
-				else
-					sprintf(error_str, "Invalid label, the label: %s has already been defined in the current file.", label_name);
-
-				return FALSE;
-			}			
-			if((instruction_type == ENTRY) && (temp->type == EXTERN)){
-				sprintf(error_str, "Invalid label, the label: %s has already been declared as extern.", label_name);
-				return FALSE;
-			}
-			if((instruction_type != EXTERN) && (instruction_type != ENTRY) && (temp->type != ENTRY)){
-				if(temp->type == EXTERN)
-					sprintf(error_str, "Invalid label, the label: %s has already been declared as extern.", label_name);
-				else
-					sprintf(error_str, "Invalid label, the label: %s has already been defined in the current file.", label_name);
-				return FALSE;
-			}
-		}
-		temp = temp->next; /* Move to the next node in the list. */		
+	/* Find the record of the label, a label that was not seen yet has no conflicts. */
+	if((index = findSymbol(symbols, label_name)) == NO_SYMBOL)
+		return TRUE;
+	record = &symbols->symbols[index];
+	
+	/* Handle conflicts based on the instruction type of the given label and the previous declarations of the label. */
+	if((instruction_type == EXTERN) && (record->is_entry || record->defined_type != NO_TYPE)){
+		if(record->first_type == ENTRY)
+			sprintf(error_str, "Invalid label, the label: %s has already been declared as an entry.", label_name);
+		else
+			sprintf(error_str, "Invalid label, the label: %s has already been defined in the current file.", label_name);
+		return FALSE;
+	}
+	if((instruction_type == ENTRY) && record->is_extern){
+		sprintf(error_str, "Invalid label, the label: %s has already been declared as extern.", label_name);
+		return FALSE;
+	}
+	if((instruction_type != EXTERN) && (instruction_type != ENTRY) && (record->is_extern || record->defined_type != NO_TYPE)){
+		if(record->is_extern)
+			sprintf(error_str, "Invalid label, the label: %s has already been declared as extern.", label_name);
+		else
+			sprintf(error_str, "Invalid label, the label: %s has already been defined in the current file.", label_name);
+		return FALSE;
 	}
 	return TRUE;	
 }
@@ -1331,14 +1079,14 @@ char checkIfLabelNameAlreadyDeclared(char* label_name, short instruction_type, d
 * 
 * Parameters:
 *   label_name - A pointer to the string containing the label name to be checked.
-*   macros_list - A pointer to the head of the linked list of macro nodes.
+*   macros - A pointer to the macro table of the file.
 *   error_str - A pointer to a buffer where an error message will be stored if the label name is invalid.
 *
 * Returns:
 *   TRUE - If the label name is valid.
 *   FALSE - If the label name is invalid.
 */
-char checkLabelName(char* label_name, macroNode* macros_list, char* error_str)
+char checkLabelName(char* label_name, macroTable* macros, char* error_str)
 {
 	short i = 0; /* An index to track the current position in the label name. */
 	char tmp_error_str[ERROR_MESSAGE_SIZE]; /* A buffer to store temporary error messages. */
@@ -1350,7 +1098,7 @@ char checkLabelName(char* label_name, macroNode* macros_list, char* error_str)
 		return FALSE;
 	}
 	/* Checks that the label name does not conflict with any macro name. */
-	if(isMacroNameExists(label_name, macros_list)){
+	if(findMacro(macros, label_name)){
 		sprintf(error_str, "Invalid label name, the name: %s is already used as a macro name.", label_name);
 		return FALSE;
 	}
@@ -1373,63 +1121,37 @@ char checkLabelName(char* label_name, macroNode* macros_list, char* error_str)
 /*
 * The function: getInstructionType
 *
-* The function identifies the type of instruction from a given line by extracting the instruction name and 
-* checking if it corresponds to a recognized instruction or opcode.
+* The function identifies the type of instruction from the operation of a given line, by the entry of the operation 
+* in the reserved words table that was found by the lexer.
 * 
 * Parameters:
-*   line - A pointer to the string that holds the current line being analyzed.
+*   tokens - A pointer to the tokens of the current line being analyzed.
 *   error_str - A pointer to a string where an error message will be stored if the instruction is not recognized.
 *
 * Returns:
 *   The type of the instruction as a char value, or NO_TYPE if the instruction is not recognized.
 */
-char getInstructionType(char* line, char* error_str)
+char getInstructionType(lineTokens* tokens, char* error_str)
 {
-	short i = 0; /* An index to track the current position in the line. */
 	char instruction_type, instruction_name[MAX_LENGTH_OF_LINE]; /* Variables to store the instruction type and name. */
+	reservedWord *reserved = tokens->reserved; /* The entry of the instruction name in the reserved words table. */
 	
-	skipWhiteChar(line);/* Skips to the first non-white character. */
-	
-	/* Extract the instruction name from the line. */
-	while(!isspace(line[i]) && line[i] != '\n' && line[i] ){
-		instruction_name[i] = line[i];
-		i++;	
-	}
-	instruction_name[i] = '\0';	
-			
 	/* Determine if the instruction name matches a known instruction and what type of instruction it is. */
-	instruction_type = isInstruction(instruction_name); 
-	if(isOpcode(instruction_name) != NO_OPCODE)
-		instruction_type = CODE;
+	if(!reserved || reserved->kind == REGISTER_WORD)
+		instruction_type = NO_TYPE;
+	else
+		instruction_type = (reserved->kind == OPCODE_WORD) ? CODE : reserved->id;
 	
 	/* If the instruction is not recognized, then sets an error message. */
-	if(instruction_type == NO_TYPE)
+	if(instruction_type == NO_TYPE){
+		instruction_name[0] = '\0';
+		if(tokens->operation != NO_TOKEN)
+			tokenToString(&tokens->tokens[tokens->operation], instruction_name);
 		sprintf(error_str, "Invalid instruction, the word: %s is not recognized by the system.", instruction_name);
+	}
 	
 	return instruction_type;
 }
 
-/*
-* The function: freeDeclarationsList
-*
-* The function responsible for freeing the memory allocated for a linked list of declarationNode structures, 
-* including the memory allocated for each label in the nodes.
-* 
-* Parameters:
-*   declarations_list - A pointer to the head of the linked list of declarationNode structures to be freed.
-*/
-void freeDeclarationsList(declarationNode* declarations_list)
-{
-	declarationNode* temp; /* A temporary pointer to hold the next node in the list. */
-			
-	/* Iterating through the linked list until all nodes are freed. */
-	while(declarations_list){				
-		free(declarations_list->label);	/* Free the memory allocated for the label. */			
-		temp = declarations_list->next; /* Store the next node in the list. */
-		free(declarations_list); /* Free the current node. */
-		declarations_list = temp; /* Move to the next node in the list. */
-	}
-}
-
 /********************************************************************* - END OF FIRST PASS - *********************************************************************/
 
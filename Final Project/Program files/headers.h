@@ -12,17 +12,53 @@
 *			4. second_pass.c
 *			5. utilities.c
 *			6. errors.c
-*			7. headers.h
-*			8. makefile
+*			7. parallel.c
+*			8. arena.c
+*			9. symbol_table.c
+*			10. macro_table.c
+*			11. output.c
+*			12. source_reader.c
+*			13. lexer.c
+*			14. memory_image.c
+*			15. name_pool.c
+*			16. pipeline.c
+*			17. server.c
+*			18. cache.c
+*			19. sha256.c
+*			20. object_file.c
+*			21. optimizer.c
+*			22. control_flow.c
+*			23. obconv.c (the object converter program)
+*			24. linker.c (the linker program)
+*			25. simulator.c (the simulator program)
+*			26. disassembler.c (the disassembler program)
+*			27. bench.c (the benchmark program)
+*			28. bench_generator.c (the benchmark program)
+*			29. headers.h
+*			30. makefile
 */
 
+/* The assembler uses POSIX functions (fork, wait...) for assembling several files at the same time: */
+#define _POSIX_C_SOURCE 200112L
+
 /****************************************************** - THE STANDARD C LIBRARIES INCLUDED IN THE PROGRAM - ******************************************************/
 
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-#include <math.h>
 #include <ctype.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <errno.h>
+#include <time.h>
+#include <limits.h>
+#include <sys/resource.h>
+#include <dirent.h>
+#include <signal.h>
 
 /********************************************************************** - MACRO DEFINITIONS - *********************************************************************/
 
@@ -32,6 +68,29 @@
 #define BUFFER 5 /* Initial size of macro commends array */
 #define ERROR_MESSAGE_SIZE 110
 #define MEMORY_CELLS 4095
+#define ARENA_BLOCK_SIZE 65536 /* Size of a block of the arena allocator */
+#define SYMBOL_TABLE_SIZE 64 /* Initial size of the symbol table arrays */
+#define MACRO_TABLE_SIZE 64 /* Initial size of the macro table */
+#define NAME_POOL_SIZE 64 /* Initial size of the name pool arrays, must be a power of 2 */
+#define SOURCE_LINES_SIZE 256 /* Initial size of the lines array of the expanded source */
+#define IMAGE_SIZE 256 /* Initial size of the code image and of the data image */
+#define FIXUPS_SIZE 64 /* Initial size of the fixup list of the code image */
+#define RESERVED_WORDS_SLOTS 64 /* Size of the reserved words hash table, must be a power of 2 */
+#define OUTPUT_BUFFER_SIZE 65536 /* Size of the buffer of an output file */
+#define SOURCE_BUFFER_SIZE 65536 /* Initial size of the buffer of an input file that can not be mapped */
+#define NUMBER_DIGITS_SIZE 24 /* Enough characters for the digits of any long number */
+#define SERVER_LINE_SIZE 4096 /* Size of the buffer of a request line of the server */
+#define SHA256_BLOCK_SIZE 64 /* The bytes of a block of SHA-256 */
+#define SHA256_HEX_SIZE 65 /* The characters of a SHA-256 hash in hexadecimal, and '\0' */
+#define CACHE_NAME_SIZE 16 /* Enough characters for the name of a file of a cache entry */
+#define CACHE_ENTRIES_SIZE 64 /* Initial size of the entries array when the cache is trimmed */
+#define CACHE_MAX_KB 65536 /* The default size bound of the build cache, in KB */
+#define CACHE_TRIM_MISSES 64 /* The server trims the build cache after this amount of new entries */
+#define MAX_TOKENS_OF_LINE MAX_LENGTH_OF_LINE /* Every token of a line but the label has at least one character of its own */
+#define MIN_RESERVED_WORD_LENGTH 2
+#define MAX_RESERVED_WORD_LENGTH 7
+#define OPCODES_AMOUNT 16
+#define REGISTERS_AMOUNT 8
 
 /* File suffixes: */
 #define INPUT_FILE_SIZE 4
@@ -42,7 +101,8 @@
 
 /* Bitwise values: */
 #define BITS_NUM 15 /* Represent the number of bits in the assembler */
-#define ONE_BIT 1
+#define WORD_MASK 077777 /* The 15 bits of a machine word */
+#define REGISTER_MASK 07 /* The 3 bits of a register field */
 #define IMMEDIATE_ADDRESSING 0
 #define DIRECT_ADDRESSING 1
 #define INDIRECT_REGISTER_ADDRESSING 2
@@ -57,13 +117,17 @@
 #define A_ADDRESSING_METHOD 2
 #define R_ADDRESSING_METHOD 1
 #define E_ADDRESSING_METHOD 0
+#define ARE_MASK 07 /* The 3 'A', 'R' and 'E' bits of a word */
+#define TYPES_MASK 017 /* The 4 bits of the addressing types of an operand in the first word, a bit for every type */
+#define ANY_ADDRESSING 017 /* The addressing types of an operand that may have any type */
+#define WRITABLE_ADDRESSING 016 /* The addressing types of an operand that is written: not an immediate value */
+#define JUMP_ADDRESSING 06 /* The addressing types of the target of a jump: a label or an indirect register */
 
 /* Values: */
 #define FATAL_ERROR -1 /* Represents memory and file opening errors */
 #define TRUE 1
 #define FALSE 0 
 #define EXTERN_VALUE 01
-#define HAVE_BMC 0
 #define ENTRY_VALUES 100
 #define FIRST_MEMORY_CELL 100
 
@@ -71,93 +135,697 @@
 #define NO_TYPE -1
 #define NO_OPCODE -1
 #define NO_REGISTER -1
+#define NO_RESERVED_WORD -1
 #define NO_DECIMAL_ADDRESS -1
+#define NO_SYMBOL -1
+#define NO_NAME -1
+#define NO_TOKEN -1
+
+/* Exit status of a child process that assembled a file (parallel mode): */
+#define JOB_SUCCESS 0
+#define JOB_ERROR 1
+#define JOB_FATAL_ERROR 2
+#define JOB_CACHE_HIT 4 /* Added to the exit status when the file was restored from the build cache */
+#define JOB_CACHE_MISS 8 /* Added to the exit status when the file was assembled and stored in the build cache */
+
+/* Build cache: */
+#ifndef ENGINE_HASH
+#define ENGINE_HASH "unknown" /* The makefile passes a checksum of the sources of the assembler, see the rule of cache.o */
+#endif
+#define ASSEMBLER_VERSION "1.18-" ENGINE_HASH /* Part of the keys of the build cache, it changes whenever the sources change */
+#define CACHE_OUTPUTS_AMOUNT 5 /* The output files of an entry: .ob, .ent, .ext, .am and .obj */
+#define CACHE_AM_OUTPUT 3 /* The index of the .am file in the output files of an entry */
+#define CACHE_OBJECT_OUTPUT 4 /* The index of the .obj file in the output files of an entry */
+#define SHA256_ROTR(x, n) ((((x) >> (n)) | ((x) << (32-(n)))) & 0xFFFFFFFFUL) /* Rotates a 32 bits word to the right */
+
+/* Binary object format (see object_file.c): */
+#define OBJECT_MAGIC "AOB1"
+#define OBJECT_VERSION 1
+#define OBJECT_HEADER_SIZE 40
+#define OBJECT_SYMBOL_SIZE 8 /* An entry or an extern record: the offset of the name and the address */
+#define OBJECT_VERSION_FIELD 4 /* The offsets of the fields of the header */
+#define OBJECT_LOAD_BASE_FIELD 6
+#define OBJECT_CODE_WORDS_FIELD 8
+#define OBJECT_DATA_WORDS_FIELD 10
+#define OBJECT_ENTRIES_FIELD 12
+#define OBJECT_EXTERNS_FIELD 14
+#define OBJECT_WORDS_OFFSET_FIELD 16
+#define OBJECT_ENTRIES_OFFSET_FIELD 20
+#define OBJECT_EXTERNS_OFFSET_FIELD 24
+#define OBJECT_STRINGS_OFFSET_FIELD 28
+#define OBJECT_STRINGS_SIZE_FIELD 32
+#define OBJECT_FILE_SIZE_FIELD 36
+#define LINKED_FILE_NAME "linked" /* The default name of the output files of the linker */
+#define OBJECT_ALIGN(offset) (((offset) + 3) & ~(size_t)3) /* The tables of the object start at multiples of 4 */
+
+/* Optimizer (the bits of the optimizations option): */
+#define PEEPHOLE_OPTIMIZATION 1 /* Removes the instructions that do nothing (--peephole) */
+#define DEAD_CODE_ELIMINATION 2 /* Removes the code that can not be reached (--dce) */
+#define JUMP_THREADING 4 /* Retargets the jumps to jumps to the end of their chains (--thread-jumps) */
+#define NO_INSTRUCTION -1 /* A word of the code that is not the first word of an instruction */
+#define NO_FIXUP -1 /* A word of the code that does not refer to a label */
+#define NO_BLOCK -1 /* A missing successor of a basic block */
+
+/* Simulator: */
+#define MEMORY_SIZE (MEMORY_CELLS + 1) /* The cells of the memory of the machine, addresses 0 to MEMORY_CELLS */
+#define SIM_STACK_SIZE 1024 /* The depth of the stack of the return addresses of jsr */
+#define SIM_MAX_STEPS 100000000L /* The default limit of the amount of instructions of a run */
+#define SIM_MAX_INSTRUCTION_WORDS 3 /* The words of the longest instruction */
+#define SIGN_BIT 040000 /* The sign bit of a machine word */
+#define IMMEDIATE_SIGN_BIT 04000 /* The sign bit of the 12 bits value of an operand word */
+#define ADDRESS_MASK 07777 /* The 12 bits of the value of an operand word */
+#define SIM_ZERO_FLAG 1 /* The bit of the zero flag in the PSW */
+#define SIM_NEGATIVE_FLAG 2 /* The bit of the negative flag in the PSW */
+
+/* Disassembler: */
+#define DISASSEMBLY_SUFFIX ".dis.as" /* The suffix of the source files that the disassembler writes */
+#define DISASSEMBLY_DATA_LINE 6 /* The numbers of a .data line of the disassembly, so the line fits in MAX_LENGTH_OF_LINE */
+
+/* Benchmark workload (the defaults and the limits of the options of the benchmark program): */
+#define BENCH_FILES 50
+#define BENCH_LINES 1000 /* The lines of every file, the words of a file must fit in the memory so bigger files are cut */
+#define BENCH_MACRO_PERCENT 10
+#define BENCH_LABELS 100
+#define BENCH_MAX_LABELS 1000
+#define BENCH_EXTERN_PERCENT 10
+#define BENCH_ENTRY_PERCENT 10
+#define BENCH_DATA_SIZE 5
+#define BENCH_MAX_DATA_SIZE 10 /* The numbers of a .data line, so the line fits in MAX_LENGTH_OF_LINE */
+#define BENCH_MACROS_AMOUNT 8
+#define BENCH_MACRO_LENGTH 3 /* The commands of every macro */
+#define BENCH_DATA_PERCENT 20 /* The lines of the body that are .data or .string lines */
+#define BENCH_MAX_LINE_WORDS 12 /* The words of the longest line: a string of BENCH_MAX_DATA_SIZE characters */
+#define BENCH_WORDS_LIMIT (MEMORY_CELLS - FIRST_MEMORY_CELL + 1)
+#define BENCH_NAME_SIZE 32 /* Enough characters for the name of a generated file in the directory */
 
 /************************************************************************* - STRUCTURES - *************************************************************************/
 
-/* pre_processor struct: */
+/* arena structures: */
+typedef union{
+	long l;
+	double d;
+	void *p;
+}arenaAlign; /* Every allocation of the arena is aligned to the size of this union. */
+
+typedef struct arena_block{
+	struct arena_block *next; /* A pointer to the previous block of the arena. */
+	size_t size; /* The amount of bytes in the block. */
+	size_t used; /* The amount of bytes that were already allocated from the block. */
+}arenaBlock;
+
+typedef struct{
+	arenaBlock *blocks; /* The current block of the arena, the blocks are linked from the newest to the oldest. */
+	arenaBlock *spare; /* The empty blocks that were kept by arenaReset, they are used before new blocks are allocated. */
+	long allocations_amount; /* The amount of allocations from the arena. */
+	size_t blocks_bytes; /* The amount of bytes of all the blocks (and the spare blocks), with their headers. */
+}arena;
+
+/* assembler structures: */
+typedef enum {PRE_PROCESSOR_STAGE, FIRST_PASS_STAGE, SECOND_PASS_STAGE, OUTPUT_STAGE, STAGES_AMOUNT} assemblerStage;
+
+typedef struct{
+	double seconds[STAGES_AMOUNT]; /* The wall time of every stage. */
+	long lines_amount; /* The amount of lines of the input file. */
+	long macros_expanded; /* The amount of macro calls that were expanded. */
+	long instructions_amount; /* The amount of instruction lines. */
+	long code_words; /* The amount of words of the code image. */
+	long data_words; /* The amount of words of the data image. */
+	long labels_amount; /* The amount of labels in the symbol table. */
+	long fixups_amount; /* The amount of operands that refer to a label. */
+	long allocations_amount; /* The amount of allocations from the arena. */
+	long heap_bytes; /* The peak heap use of the tables, the images and the arena. */
+}assemblyStats;
+
+typedef struct{
+	short jobs_amount; /* The amount of files that are assembled at the same time (-j). */
+	char emit_am; /* TRUE if the expanded source should be written to the .am file (--emit-am). */
+	char emit_object; /* TRUE if the binary object should be written to the .obj file (--obj). */
+	char optimizations; /* The optimizations to run between the first and the second pass, a bit for every one (--thread-jumps, --dce, --peephole), 0 for none. */
+	char print_stats; /* TRUE if the statistics of every file should be printed (--stats). */
+	assemblyStats *stats; /* The statistics of every file are added to it, or NULL if they are not summed. */
+	struct assembler_workspace *workspace; /* The tables that are kept from file to file (--server), or NULL if every file has its own. */
+	struct build_cache *cache; /* The build cache (--cache), or NULL if every file is assembled. */
+}assemblerOptions;
+
+/* build cache structures: */
+typedef struct build_cache{
+	char *dir; /* The directory of the cache. */
+	long max_bytes; /* The size bound of the cache, the least recently used entries are removed above it. */
+	long hits; /* The amount of files that were restored from the cache. */
+	long misses; /* The amount of files that were assembled and stored in the cache. */
+	long evictions; /* The amount of entries that were removed because of the size bound. */
+	long entries_amount; /* The amount of entries, after the cache was trimmed. */
+	long bytes; /* The size of all the entries, after the cache was trimmed. */
+}buildCache;
+
+typedef struct{
+	char key[SHA256_HEX_SIZE]; /* The key of the entry, it is also the name of its directory. */
+	long bytes; /* The size of the files of the entry. */
+	double used; /* The time of the last use of the entry, in seconds. */
+}cacheEntry;
+
+typedef struct{
+	unsigned long state[8]; /* The hash of the blocks so far, 32 bits in every cell. */
+	unsigned long bytes_amount; /* The amount of bytes that were hashed. */
+	unsigned char block[SHA256_BLOCK_SIZE]; /* The bytes of the block that is not full yet. */
+	int block_used; /* The amount of bytes in the block. */
+}sha256Context;
+
+/* benchmark structures: */
+typedef struct{
+	long lines_amount; /* The amount of lines of every file. */
+	long macro_percent; /* The percent of the lines of the body that call a macro. */
+	long labels_amount; /* The amount of labels of every file. */
+	long extern_percent; /* The percent of the labels that are extern, and of the label operands that refer to them. */
+	long entry_percent; /* The percent of the labels that are declared as entry. */
+	long data_size; /* The amount of numbers of every .data line. */
+}benchWorkload;
+
+/* source reader structures: */
+typedef struct{
+	char *text; /* The content of the file, mapped to the memory or read to a buffer. */
+	size_t length; /* The amount of characters in the file. */
+	size_t position; /* The index of the start of the next line. */
+	char is_mapped; /* TRUE if the content was mapped with mmap, FALSE if it was read to a buffer. */
+	long lines_amount; /* The amount of lines that were read. */
+}sourceFile;
+
+typedef struct{
+	char *start; /* A pointer to the start of the line in the content of the file. */
+	size_t length; /* The amount of characters in the line, including the '\n' at its end. */
+	unsigned int number; /* The number of the line in the input file, the messages of the passes refer to it. */
+}lineView;
+
+/* name pool structures: */
+typedef struct{
+	char **names; /* The distinct names of the file, the index of a name is its id. */
+	int names_amount; /* The amount of names. */
+	int names_size; /* The allocated size of the names array. */
+	int *slots; /* The hash table, every slot holds the id of a name or NO_NAME. */
+	int slots_size; /* The size of the hash table, always a power of 2. */
+}namePool;
+
+/* pre_processor structures: */
 typedef struct macro{
 	char *name; /* Stores the name of the macro. */
-	char **commands; /* Stores the commands of the macro. */
-	struct macro *next; /* A pointer to the next node in the linked list. */
+	lineView *commands; /* Stores the commands of the macro, as views to the input file. */
+	int commands_amount; /* The amount of commands. */
 }macroNode;
 
+typedef struct{
+	namePool *names; /* The name pool of the file, that the names of the macros are kept in. */
+	macroNode **by_name; /* For every id of a name in the name pool, the macro of the name or NULL. */
+	int by_name_size; /* The size of the by_name array. */
+	int macros_amount; /* The amount of macros in the table. */
+	long calls_amount; /* The amount of macro calls that were expanded. */
+}macroTable;
+
+typedef struct{
+	lineView *lines; /* The lines of the source after the macros were spread, as views to the input file. */
+	int lines_amount; /* The amount of lines. */
+	int lines_size; /* The allocated size of the lines array. */
+}sourceLines;
+
 /* first and second passes structures: */
-typedef struct instruction{
-	short ic; /* At the beginning of the first passes represents the instruction counter - IC, and at the end represents the decimal address. */
-	unsigned int line; /* If line > 0, represents the number of the line where the label is mentioned.
-			            * If line = 0, represents that the word has already been translated into binary machine code. */
-	union{
-		short bmc; /* Represent the Binary Machine Code-BMC. */
-		char *name; /* The name of the label mentioned in the line. */
-	}type;
-	struct instruction *next; /* A pointer to the next node in the linked list. */
-}instructionNode;
-
-typedef struct data{
-	short dc; /* At the beginning of the first passes represents the data counter - DC, and at the end represents the decimal address. */
-	short bmc; /* Represent the Binary Machine Code-BMC. */
-	struct data *next; /* A pointer to the next node in the linked list. */
-}dataNode;
-
-typedef struct declaration{
-	short decimal_address; /* If it's an instruction, it represents the IC\DC counter. 
-							* If it's an entry or extern, it represents the line number where it was declared. */
-	char *label; /* The name of the declared label. */
-	char type; /* .data represented by 0, .string by 1, .entry by 2, .extern by 3 and .code by 4. */
-	struct declaration *next; /* A pointer to the next node in the linked list. */
-}declarationNode;
+typedef struct{
+	short *words; /* The Binary Machine Code-BMC of the words, the index of a word is its counter (IC-FIRST_MEMORY_CELL or DC). */
+	int words_amount; /* The amount of words. */
+	int words_size; /* The allocated size of the words array. */
+}wordsImage;
+
+typedef struct{
+	int index; /* The index of the word of the operand in the code image. */
+	int symbol; /* The index of the record of the label in the symbol table. */
+	unsigned int line; /* The number of the line where the label is mentioned. */
+}fixup;
+
+typedef struct{
+	wordsImage code; /* The words of the instructions. */
+	wordsImage data; /* The words of the data and the strings. */
+	fixup *fixups; /* The words of the operands that refer to a label, in the order of the code image. */
+	int fixups_amount; /* The amount of fixups. */
+	int fixups_size; /* The allocated size of the fixups array. */
+	int instructions_amount; /* The amount of instruction lines. */
+}memoryImage;
+
+/* symbol table structures: */
+typedef struct{
+	char *name; /* The name of the label. */
+	short address; /* The IC\DC counter of the definition, and at the end of the first pass the decimal address. */
+	unsigned int line; /* The line number of the first entry or extern declaration of the label. */
+	char defined_type; /* The type of the definition: .data represented by 0, .string by 1 and .code by 4, NO_TYPE if the label was not defined. */
+	char first_type; /* The type of the first definition or declaration of the label, used for choosing the error message of a conflict. */
+	char is_entry; /* TRUE if the label was declared as entry. */
+	char is_extern; /* TRUE if the label was declared as extern. */
+}symbol;
+
+typedef struct{
+	namePool *names; /* The name pool of the file, that the names of the labels are kept in. */
+	symbol *symbols; /* The records of the labels, in the order they were first seen. */
+	int symbols_amount; /* The amount of records. */
+	int symbols_size; /* The allocated size of the symbols array. */
+	int *by_name; /* For every id of a name in the name pool, the index of the record of the name or NO_SYMBOL. */
+	int by_name_size; /* The size of the by_name array. */
+	int *entries; /* The indexes of the entry labels, in the order of their first declaration. */
+	int entries_amount; /* The amount of entry labels. */
+	int entries_size; /* The allocated size of the entries array. */
+}symbolTable;
+
+/* workspace struct: */
+typedef struct assembler_workspace{
+	arena file_arena; /* The arena that all the nodes of the file are allocated from. */
+	namePool names; /* The names of the labels and the macros of the file. */
+	macroTable macros; /* The macro table of the file. */
+	symbolTable symbols; /* The symbol table of the file. */
+	sourceLines kept_lines; /* The lines of the input file that the pre processor keeps, before the macros are spread. */
+	sourceLines expanded_source; /* The lines of the source after the pre processor. */
+	memoryImage image; /* The code and data words of the file. */
+}assemblerWorkspace;
+
+/* output struct: */
+typedef struct{
+	int fd; /* The file descriptor of the output file. */
+	char *data; /* The buffer, the characters that were not written to the file yet. */
+	size_t used; /* The amount of characters in the buffer. */
+}outputBuffer;
+
+/* object file structures: */
+typedef struct{
+	unsigned char *data; /* The bytes of the object, in the binary object format. */
+	size_t size; /* The amount of bytes. */
+	char is_mapped; /* TRUE if the bytes are a binary object file that was read with sourceOpen, FALSE if they were allocated. */
+	sourceFile file; /* The binary object file, when is_mapped is TRUE. */
+}objectImage;
+
+typedef struct{
+	char *name; /* The name of the label. */
+	short address; /* The address of the entry label, or of the word that refers to the extern label. */
+}objectSymbol;
+
+/* linker struct: */
+typedef struct{
+	objectImage object; /* The object of the module. */
+	char *name; /* The name of the module, as received from the user. */
+	short code_base; /* The address of the first code word of the module in the linked image. */
+	short data_base; /* The address of the first data word of the module in the linked image. */
+}linkModule;
+
+/* optimizer structs: */
+typedef struct{
+	int start; /* The index of the first word of the instruction in the code image. */
+	short length; /* The amount of words of the instruction. */
+	short opcode; /* The opcode of the instruction. */
+	short types[2]; /* The addressing types of the source and the target, NO_TYPE for a missing operand. */
+	char removed; /* TRUE if the instruction was removed from the code. */
+}codeInstruction;
+
+typedef struct{
+	memoryImage *image; /* The memory image of the file. */
+	symbolTable *symbols; /* The symbol table of the file. */
+	codeInstruction *instructions; /* The instructions of the code, in their order. */
+	int instructions_amount; /* The amount of instructions. */
+	int *instruction_at; /* For every word of the code, the index of the instruction that starts at it or NO_INSTRUCTION. */
+	int *fixup_at; /* For every word of the code, the index of its fixup or NO_FIXUP. */
+	int *new_index; /* For every word of the code, its index after the compaction. */
+	char *labeled; /* For every word of the code, TRUE if a label is defined at it. */
+	char *dropped; /* For every word of the code, TRUE if it is removed from the code. */
+	int words_saved; /* The amount of words that were dropped. */
+	int removed_amount; /* The amount of instructions that were removed. */
+}codeStream;
+
+typedef struct{
+	int first; /* The index of the first instruction of the block. */
+	int last; /* The index of the last instruction of the block. */
+	int successors[2]; /* The blocks that the run may go to after the block, NO_BLOCK for a missing one. */
+	char indirect; /* TRUE if the block ends with a jump to the address in a register, that may go to any block. */
+	char reachable; /* TRUE if the run may get to the block. */
+}basicBlock;
+
+typedef struct{
+	basicBlock *blocks; /* The basic blocks, in the order of the code. */
+	int blocks_amount; /* The amount of blocks. */
+	int *block_of; /* For every instruction that was not removed, the index of its block. */
+}controlFlow;
+
+/* simulator structs: */
+typedef enum {SIM_RUNNING, SIM_STOPPED, SIM_ERROR} simState;
+
+struct machine; /* The machine is defined below, the functions of the instructions receive it. */
+
+typedef struct sim_instruction{
+	void (*handler)(struct machine*, struct sim_instruction*); /* The function of the opcode of the instruction. */
+	short *source; /* The source operand: a register, a memory cell, or operands[0]. NULL if there is no source. */
+	short *target; /* The target operand: a register, a memory cell, or operands[1]. NULL if there is no target. */
+	char source_indirect; /* TRUE if the source is *rX: the operand is the memory cell whose address is in the register. */
+	char target_indirect; /* TRUE if the target is *rX (not for a jump, that jumps to the address in the register). */
+	short operands[2]; /* The values of the immediate operands, and the addresses of the labels of lea and the jumps. */
+	short next; /* The address of the next instruction. */
+	char valid; /* TRUE if the record holds the decoded instruction, FALSE if it must be decoded again. */
+}simInstruction;
+
+typedef struct machine{
+	short memory[MEMORY_SIZE]; /* The memory cells, every cell holds a 15 bits word. */
+	simInstruction decoded[MEMORY_SIZE]; /* The dispatch record of the instruction at every address. */
+	short registers[REGISTERS_AMOUNT]; /* The registers r0-r7. */
+	short pc; /* The address of the next instruction. */
+	short address; /* The address of the current instruction. */
+	short psw; /* The flags: SIM_ZERO_FLAG and SIM_NEGATIVE_FLAG. */
+	short stack[SIM_STACK_SIZE]; /* The return addresses of jsr. */
+	short stack_used; /* The amount of return addresses in the stack. */
+	short code_end; /* The address after the last code word of the program. */
+	short scratch; /* A cell for the operand of an instruction that failed, so it can finish without harm. */
+	long steps; /* The amount of instructions that were run. */
+	simState state; /* SIM_RUNNING, SIM_STOPPED at stop, or SIM_ERROR. */
+}simulator;
+
+/* disassembler structs: */
+typedef struct{
+	short opcode; /* The opcode of the instruction, or NO_OPCODE if the word is not the first word of a valid instruction. */
+	short types[2]; /* The addressing types of the source and the target, NO_TYPE for a missing operand. */
+	short values[2]; /* The number, the address of the label (0 for an extern label) or the register of every operand. */
+	short are[2]; /* The 'A', 'R' or 'E' bit of the word of every operand. */
+	short operand_addresses[2]; /* The address of the word of every operand. */
+	short length; /* The amount of words of the instruction, 1 for a word that is not valid. */
+}disassembledInstruction;
+
+typedef struct{
+	objectImage object; /* The object that is decoded. */
+	disassembledInstruction instructions[MEMORY_SIZE]; /* The record of the instruction that starts at every address of the code. */
+	char *labels[MEMORY_SIZE]; /* The name of the label at every address, or NULL. */
+	char *externs[MEMORY_SIZE]; /* The extern name of every reference site, or NULL. */
+	char referenced[MEMORY_SIZE]; /* TRUE for every address that a label operand refers to. */
+	namePool names; /* The names of the disassembly, so a made name is never the name of another label. */
+	arena names_arena; /* The arena of the names of the pool. */
+	char **extern_names; /* The distinct extern names, in the order of the .extern lines. */
+	int extern_names_amount; /* The amount of extern names. */
+	short code_end; /* The address after the last code word. */
+	short data_end; /* The address after the last data word. */
+	int instructions_amount; /* The amount of valid instructions. */
+	int labels_amount; /* The amount of labels. */
+	int invalid_words; /* The amount of words of the code that are not valid instructions. */
+}disassembly;
+
+/* parallel struct: */
+typedef struct job{
+	pid_t pid; /* The id of the child process that assembles the file. */
+	FILE *output; /* A temporary file that holds the output of the child process. */
+	char indicator; /* The result of the assembly: TRUE, FALSE or FATAL_ERROR. */
+	char finished; /* TRUE if the child process has finished. */
+	char printed; /* TRUE if the output of the file was already printed. */
+	char cache_result; /* JOB_CACHE_HIT or JOB_CACHE_MISS if the file went through the build cache, 0 otherwise. */
+}assemblyJob;
 
 /* Reserved keywords of the assembler: */
 typedef enum {MOV, CMP, ADD, SUB, LEA, CLR, NOT, INC, DEC, JMP, BNE, RED, PRN, JSR, RTS, STOP} opcode;
 
 typedef enum {DATA, STRING, ENTRY, EXTERN, CODE} instruction;
 
-/****************************************************************** - PRE_PROCESSOR FUNCTIONS - ******************************************************************/
-
-char macrosLayout(FILE*, char*, char*, char*, macroNode**);
-macroNode* readNewMacro(char*, unsigned int*, FILE*, macroNode*, macroNode**, char*);
-macroNode* creatMacroNode(char*);
-void freeMacrosList(macroNode*);
-char getMacroData(char*, unsigned int*, FILE*, macroNode*, macroNode*, char*);
+typedef enum {OPCODE_WORD, REGISTER_WORD, INSTRUCTION_WORD} reservedWordKind;
+
+typedef struct{
+	char *name; /* The reserved word. */
+	char kind; /* The kind of the word: OPCODE_WORD, REGISTER_WORD or INSTRUCTION_WORD. */
+	char id; /* The opcode number, the register number or the instruction type of the word. */
+}reservedWord;
+
+typedef struct{
+	char operands_amount; /* The amount of operands of the opcode. */
+	char source_types; /* The addressing types that the source operand may have, a bit for every type (1 << type). */
+	char target_types; /* The addressing types that the target operand may have. */
+	char sets_flags; /* TRUE if the instruction sets the flags of the PSW by its result (cmp, add, sub, clr, not, inc and dec). */
+}opcodeRule;
+
+/* lexer structures: */
+typedef enum {LABEL_TOKEN, OPERATION_TOKEN, WORD_TOKEN, NUMBER_TOKEN, COMMA_TOKEN, STRING_TOKEN} tokenType;
+
+typedef struct{
+	char type; /* The type of the token. */
+	char spaced; /* TRUE if white characters come before the token in the line. */
+	short length; /* The amount of characters in the token. */
+	char *start; /* A pointer to the first character of the token in the line. */
+	double value; /* The value of a number token. */
+}token;
+
+typedef struct{
+	token tokens[MAX_TOKENS_OF_LINE]; /* The tokens of the line, in their order in the line. */
+	short tokens_amount; /* The amount of tokens. */
+	short label; /* The index of the label token, or NO_TOKEN if the line has no label. */
+	short operation; /* The index of the operation token, or NO_TOKEN if the line has no operation. */
+	short operands; /* The index of the first operand token, it equals tokens_amount if there are no operands. */
+	reservedWord *reserved; /* The operation in the reserved words table, or NULL if it is not a reserved word. */
+}lineTokens;
+
+/******************************************************************** - PIPELINE FUNCTIONS - **********************************************************************/
+
+char assembleFile(char*, assemblerOptions*);
+double wallTime(void);
+void addStageTime(assemblyStats*, short, double*);
+void workspaceInit(assemblerWorkspace*);
+void resetWorkspace(assemblerWorkspace*);
+void freeWorkspace(assemblerWorkspace*);
+void collectAssemblyStats(assemblyStats*, sourceFile*, assemblerWorkspace*, size_t);
+size_t workspaceHeapBytes(assemblerWorkspace*);
+void reportAssemblyStats(char*, assemblyStats*, char, assemblerOptions*);
+void addAssemblyStats(assemblyStats*, assemblyStats*);
+void printAssemblyStats(char*, assemblyStats*, char, char);
+void printJsonString(char*);
+
+/********************************************************************** - SERVER FUNCTIONS - **********************************************************************/
+
+char runAssemblerServer(assemblerOptions*);
+char readServerRequest(char*, assemblerOptions*, char**);
+void printServerStatus(char*);
+
+/*********************************************************************** - CACHE FUNCTIONS - ***********************************************************************/
+
+char buildFile(char*, assemblerOptions*);
+char hashSourceFile(char*, assemblerOptions*, char*);
+char restoreCacheEntry(char*, char*, assemblerOptions*);
+char assembleAndStore(char*, char*, char*, assemblerOptions*);
+char isCacheOutput(short, assemblerOptions*);
+char readCacheResult(char*, char*, double*);
+char writeCacheResult(char*, char);
+char* cachePath(char*, char*);
+char copyCacheFile(char*, char*);
+void printCacheFile(char*);
+void removeCacheEntry(char*);
+int compareCacheEntries(const void*, const void*);
+void trimBuildCache(buildCache*);
+void printCacheStats(buildCache*);
+void sha256Init(sha256Context*);
+void sha256Block(sha256Context*, unsigned char*);
+void sha256Update(sha256Context*, unsigned char*, size_t);
+void sha256Final(sha256Context*, char*);
+
+/******************************************************************** - OBJECT FILE FUNCTIONS - *******************************************************************/
+
+unsigned long readObjectField(objectImage*, size_t, short);
+void writeObjectField(unsigned char*, size_t, unsigned long, short);
+short getObjectWord(objectImage*, int);
+char* getObjectSymbol(objectImage*, short, int, short*);
+char buildObjectImage(objectImage*, short*, short, short*, short, objectSymbol*, int, objectSymbol*, int);
+char writeObjectFile(objectImage*, char*);
+char mapObjectFile(objectImage*, char*);
+char readTextObject(objectImage*, char*);
+char writeTextObject(objectImage*, char*);
+char loadObject(objectImage*, char*);
+void freeObjectImage(objectImage*);
+char convertObject(char*, char);
+char checkObject(char*);
+
+/*********************************************************************** - LINKER FUNCTIONS - **********************************************************************/
+
+char linkModules(char**, int, char*, char);
+short relocateAddress(linkModule*, short);
+char relocateModule(linkModule*, short*, short*, short, namePool*, int*, short*);
+
+/********************************************************************* - OPTIMIZER FUNCTIONS - *********************************************************************/
+
+char optimizeCode(char*, short*, memoryImage*, symbolTable*, char, arena*);
+char buildCodeStream(codeStream*, memoryImage*, symbolTable*, arena*);
+void threadJumpsPass(codeStream*, char*);
+char deadCodePass(codeStream*, char*, arena*);
+void peepholePass(codeStream*);
+int nextLiveInstruction(codeStream*, int);
+char isLabeled(codeStream*, int, int);
+void removeInstruction(codeStream*, int);
+int operandWord(codeInstruction*, short);
+char sameOperand(codeStream*, codeInstruction*, short, codeInstruction*, short);
+int jumpTarget(codeStream*, codeInstruction*);
+char flagsAreDead(codeStream*, int);
+void compactCodeStream(codeStream*, short*);
+
+/******************************************************************** - CONTROL FLOW FUNCTIONS - ********************************************************************/
+
+char buildControlFlow(controlFlow*, codeStream*, arena*);
+char isBlockEnd(codeInstruction*);
+void findSuccessors(controlFlow*, codeStream*, int);
+int labelBlock(controlFlow*, codeStream*, symbol*);
+char markReachableBlocks(controlFlow*, codeStream*, arena*);
+void pushReachableBlock(controlFlow*, int*, int*, int);
+
+/********************************************************************* - SIMULATOR FUNCTIONS - *********************************************************************/
+
+char loadSimProgram(simulator*, char*);
+char* decodeSimInstruction(simulator*, short);
+void decodeSimRegister(simulator*, simInstruction*, short, short, short);
+void runSimulator(simulator*, long);
+char simError(simulator*, char*);
+short* simOperand(simulator*, short*, char);
+void simWrite(simulator*, short*, long, char);
+void simJump(simulator*, short);
+void simMov(simulator*, simInstruction*);
+void simCmp(simulator*, simInstruction*);
+void simAdd(simulator*, simInstruction*);
+void simSub(simulator*, simInstruction*);
+void simLea(simulator*, simInstruction*);
+void simClr(simulator*, simInstruction*);
+void simNot(simulator*, simInstruction*);
+void simInc(simulator*, simInstruction*);
+void simDec(simulator*, simInstruction*);
+void simJmp(simulator*, simInstruction*);
+void simBne(simulator*, simInstruction*);
+void simRed(simulator*, simInstruction*);
+void simPrn(simulator*, simInstruction*);
+void simJsr(simulator*, simInstruction*);
+void simRts(simulator*, simInstruction*);
+void simStop(simulator*, simInstruction*);
+void printSimRegisters(simulator*);
+
+/******************************************************************** - DISASSEMBLER FUNCTIONS - *******************************************************************/
+
+char disassembleFile(char*, char);
+char decodeDisassembly(disassembly*, char);
+char addDisassemblySymbols(disassembly*);
+char addExternName(disassembly*, char*);
+char* newDisassemblyName(disassembly*, char, short);
+char writeDisassembly(disassembly*, char*, char*);
+void writeDisassemblyLabel(outputBuffer*, char*);
+
+/******************************************************************** - BENCHMARK FUNCTIONS - *********************************************************************/
+
+char readBenchNumber(char*, long, long, long*);
+int muteOutput(void);
+void restoreOutput(int);
+void printBenchReport(assemblyStats*, long);
+long benchRandom(unsigned long*, long);
+void writeBenchOperand(char*, short, benchWorkload*, int, unsigned long*);
+short writeBenchInstruction(char*, benchWorkload*, int, char, unsigned long*);
+short writeBenchData(char*, benchWorkload*, unsigned long*);
+long generateBenchProgram(char*, benchWorkload*, unsigned long);
+
+/********************************************************************* - PARALLEL FUNCTIONS - *********************************************************************/
+
+char runParallelAssembly(char**, int, assemblerOptions*);
+char startAssemblyJob(assemblyJob*, char*, assemblerOptions*);
+short waitForAssemblyJob(assemblyJob*, int);
+void printFinishedJobs(assemblyJob*, int, int*, char*);
+void finishJobOutput(assemblyJob*, int, char*);
+
+/*********************************************************************** - ARENA FUNCTIONS - ***********************************************************************/
+
+void arenaInit(arena*);
+void* arenaAlloc(arena*, size_t);
+char* arenaStrdup(arena*, char*);
+void arenaReset(arena*);
+void arenaFree(arena*);
+
+/******************************************************************* - SYMBOL TABLE FUNCTIONS - *******************************************************************/
+
+void symbolTableInit(symbolTable*, namePool*);
+int findSymbol(symbolTable*, char*);
+char growSymbolsByName(symbolTable*, int);
+int addSymbol(symbolTable*, char*, arena*, char*);
+char declareSymbol(symbolTable*, char*, char, short, arena*, char*);
+void resetSymbolTable(symbolTable*);
+void freeSymbolTable(symbolTable*);
+
+/******************************************************************* - MACRO TABLE FUNCTIONS - ********************************************************************/
+
+void macroTableInit(macroTable*, namePool*);
+macroNode* findMacro(macroTable*, char*);
+char growMacrosByName(macroTable*, int, arena*);
+char addMacro(macroTable*, macroNode*, arena*, char*);
+
+/******************************************************************** - NAME POOL FUNCTIONS - *********************************************************************/
+
+void namePoolInit(namePool*);
+unsigned long hashName(char*);
+int findName(namePool*, char*);
+char growNameSlots(namePool*);
+int internName(namePool*, char*, arena*, char*);
+void resetNamePool(namePool*);
+void freeNamePool(namePool*);
+
+/******************************************************************* - SOURCE READER FUNCTIONS - ******************************************************************/
+
+char sourceOpen(sourceFile*, char*);
+char sourceReadAll(sourceFile*, int);
+char sourceNextLine(sourceFile*, lineView*);
+void sourceClose(sourceFile*);
+void viewToLine(lineView, char*);
+void skipViewWhiteChar(lineView*);
+
+/************************************************************************ - LEXER FUNCTIONS - ***********************************************************************/
+
+void lexLine(char*, lineTokens*);
+void lexOperands(char*, lineTokens*);
+void lexString(char*, lineTokens*);
+short addToken(lineTokens*, char, char*, long, char);
+void tokenToString(token*, char*);
+short getTokensWord(lineTokens*, short, char*);
+
+/******************************************************************** - MEMORY IMAGE FUNCTIONS - ******************************************************************/
+
+void memoryImageInit(memoryImage*);
+char addImageWord(wordsImage*, short, char*);
+char addFixup(memoryImage*, int, int, unsigned int, char*);
+void resetMemoryImage(memoryImage*);
+void freeMemoryImage(memoryImage*);
+
+/****************************************************************** - PRE_PROCESSOR FUNCTIONS- ******************************************************************/
+
+char macrosLayout(sourceFile*, char*, macroTable*, sourceLines*, sourceLines*, arena*);
+char readNewMacro(char*, unsigned int*, sourceFile*, macroTable*, arena*, char*);
+macroNode* creatMacroNode(arena*, char*);
+char getMacroData(char*, unsigned int*, sourceFile*, macroNode*, macroTable*, arena*, char*);
 char getMacroName(char*, char*, char*);
-char getCommands(char*, FILE*, unsigned int*, macroNode*, char*);
+char getCommands(char*, lineView*, sourceFile*, unsigned int*, macroNode*, arena*, char*);
+char readMacroLine(sourceFile*, lineView*, char*, unsigned int*, char*);
 char isStartMacroDeclaration(char*, char*);
 char isEndMacroDeclaration(char*, char*);
 char isValidLine(char*, char*);
-/* Printing functions: */
-macroNode* isMacroNameExists(char*, macroNode*);
-void printLineToFile(FILE*, char*, macroNode*);
-void printMacroCommands(macroNode*, FILE*);
+/* Expanded source functions: */
+char addLineToSource(sourceLines*, lineView, macroTable*, char*);
+char addMacroCommands(macroNode*, sourceLines*, char*);
+char addSourceLine(sourceLines*, lineView, char*);
+char writeAmFile(char*, char*, sourceLines*);
+void freeSourceLines(sourceLines*);
 
 /******************************************************************** - FIRST_PASS FUNCTIONS - ********************************************************************/
 
-char firstPass(FILE*, char*, short* ,macroNode*, instructionNode**, dataNode**, declarationNode**);
-char UpdateDataCounter(dataNode*, declarationNode*, short*, short, short);
+char firstPass(sourceLines*, char*, short* ,macroTable*, memoryImage*, symbolTable*, arena*);
+char UpdateDataCounter(memoryImage*, symbolTable*, short*);
 char checkBitException(int, short);
 
-/* Declaration nodes functions: */
-declarationNode* readNewDeclaration(char*, unsigned int, macroNode*, declarationNode*, declarationNode**, char*);
-declarationNode* readNewLabel(char*, unsigned int, macroNode*, short, short, declarationNode*, declarationNode**, char*);
-declarationNode* creatDeclarationNode(short, char*, char, declarationNode*, char*);
-char getLabelName(char*, char*, char*, macroNode*);
-char getInstructionType(char*, char*);
-char checkLabelName(char*, macroNode*, char*);
-char checkIfLabelNameAlreadyDeclared(char*, short, declarationNode*, char*);
-void freeDeclarationsList(declarationNode*);
+/* Declaration functions: */
+char readNewDeclaration(lineTokens*, unsigned int,macroTable*, symbolTable*, arena*, char*);
+char readNewLabel(lineTokens*, unsigned int,macroTable*, short, short, symbolTable*, arena*, char*);
+char getLabelName(lineTokens*, char*, char*, macroTable*);
+char getInstructionType(lineTokens*, char*);
+char checkLabelName(char*, macroTable*, char*);
+char checkIfLabelNameAlreadyDeclared(char*, short, symbolTable*, char*);
 
 /* Data nodes functions: */
-dataNode* readNewData(short*, short, char*, dataNode*, dataNode**, char*);
-dataNode* creatDataNode(short, short, dataNode**, char*);
-short readNumbers(char*, short*, char*);
-char dataLineCheck(char*, char*);
-short readString(char*, short*, char*);
-char stringLineCheck(char*, char*);
-void freeDataList(dataNode*);
+char readNewData(short, lineTokens*, memoryImage*, char*);
+short readNumbers(lineTokens*, short*, char*);
+char dataLineCheck(lineTokens*, char*);
+short readString(lineTokens*, short*, char*);
+char stringLineCheck(lineTokens*, char*);
 
 /* Instruction nodes functions: */
-instructionNode* readNewInstruction(short*, char*, instructionNode*, instructionNode**, unsigned int, char*);
-instructionNode* creatInstructionNode(short, short, char*, unsigned int, instructionNode**, char*);
+char readNewInstruction(lineTokens*, memoryImage*, symbolTable*, unsigned int, arena*, char*);
+char addCodeWord(memoryImage*, symbolTable*, short, char*, unsigned int, arena*, char*);
 char isAbsolute(short);
 void getFirstWordBMC(short, short, short, short*);
 void getImmediateBMC(char*, short*);
@@ -166,41 +834,62 @@ void getTargetRegisterBMC(char*, short*);
 short isValidTargetOperandType(short, char*, char*);
 short isValidSourceOperandType(short, char*, char*);
 short getOperandAddressingType(char*, char*);
-char readTargetOperand(char*, char*, char*);
-char readTwoOperands(char*, char*, char*, char*);
-short getOpcode(char*);
-void freeInstructionsList(instructionNode*);
+char readTargetOperand(lineTokens*, short, char*, char*);
+char readTwoOperands(lineTokens*, char*, char*, char*);
+short getOpcode(lineTokens*);
 
 /******************************************************************* - SECOND_PASS FUNCTIONS - *******************************************************************/
 
-char secondPass(char*, char*, short*, instructionNode**, dataNode*, declarationNode*, char);
-char isEntriesDefined(char*, declarationNode*);
-char fillingMissingBMCofLabel(char*, instructionNode**, declarationNode*, short*, short*);
-char createObAndExtFiles(char*, short*, instructionNode**, dataNode*, short*);
-char createEntFile(char*, declarationNode*, short*);
-void printfObIcDcNumbersLine(FILE*, short*);
-void printfEntOutputLine(FILE*, declarationNode*, short*);
-void printfExtOutputLine(FILE*, instructionNode*, short*);
+char secondPass(char*, char*, short*, memoryImage*, symbolTable*, char, char, assemblyStats*);
+char isEntriesDefined(char*, symbolTable*, short*);
+char fillingMissingBMCofLabel(char*, memoryImage*, symbolTable*, short*);
+char createObAndExtFiles(char*, short*, memoryImage*, symbolTable*, short*);
+char createEntFile(char*, symbolTable*, short*);
+char createObjFile(char*, short*, memoryImage*, symbolTable*);
+void printfObIcDcNumbersLine(outputBuffer*, short*);
+void printfObOutputLine(outputBuffer*, short, short);
+void printfEntOutputLine(outputBuffer*, symbol*, short*);
+void printfExtOutputLine(outputBuffer*, symbol*, short, short*);
 void getRelocatableBMC(short, short*);
 
 /********************************************************************* - UTILITIES FUNCTIONS - *********************************************************************/
 
-short isOpcode(char*);
-short isRegister(char*);
-short isInstruction(char*);
+short hashReservedWord(char*, short);
+reservedWord* findReservedWord(char*);
+short getReservedWordId(char*, char);
+char* getOpcodeName(short);
+opcodeRule* getOpcodeRule(short);
+short decodeOperandType(short);
+char decodeFirstWord(short, short*, short*);
+short instructionLength(short*);
+short operandWordOffset(short*, short);
+short decodeOperandWord(short, short, short, short*);
+long signedWord(short);
 char isValidName(char*, char*);
 char isWhiteSpaceString(char*);
 void skipWhiteChar(char*);
 void skipWord(char*);
 void getWord(char*, char*);
 void continueTo(char*, short);
-void mainGeneralFree(FILE*, char*, macroNode*, declarationNode*, dataNode*, instructionNode*);
+void mainGeneralFree(sourceFile*, char*, assemblerWorkspace*, char);
 void checkIfRemainMoreFile(int);
 
 /* Bitwise functions: */
-void insertBinaryValueByKeyWords(short, short*, short);
-void insertBinaryValueByData(short, short*, short);
-void turnOnBit(short*, short);
+short encodeFirstWord(short, short, short);
+short encodeRegisters(short, short);
+short encodeOperand(short, short);
+short encodeData(short);
+
+/*********************************************************************** - OUTPUT FUNCTIONS - **********************************************************************/
+
+char outputOpen(outputBuffer*, char*);
+void outputFlush(outputBuffer*);
+void outputClose(outputBuffer*);
+void outputChars(outputBuffer*, char*, size_t);
+void outputString(outputBuffer*, char*);
+void outputSpaces(outputBuffer*, long);
+void outputDecimal(outputBuffer*, long, short);
+void outputOctal(outputBuffer*, unsigned long, short);
 
 /********************************************************************** - ERRORS FUNCTIONS - **********************************************************************/
 
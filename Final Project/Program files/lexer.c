@@ -0,0 +1,212 @@
+#include "headers.h"
+
+/*
+* FILE: lexer.c
+*
+* This file includes the functions of the lexer of the first pass.
+* Every line of the expanded source is walked once with a cursor, and it is split into a small array of tokens:
+* the label, the operation (an instruction name or a directive), and the operands as words, numbers, commas and strings.
+* The tokens point into the line, so the first pass reads the parts of the line from the tokens, without copying
+* the rest of the line again every time it advances, and without changing the line.
+*
+*/
+
+/*
+* The function: lexLine
+*
+* The function splits a line of the expanded source into tokens.
+* A colon anywhere in the line makes the text before it a label, and the operation starts after the first word
+* of the line (the label and its colon). The operation is the next word, until a white character.
+* The operands of a .string directive are one string token, the operands of any other line are split to words
+* at white characters and at commas.
+*
+* Parameters:
+*	line - the line, it is not changed and it must stay valid while the tokens are used.
+*	tokens - a pointer to the tokens of the line.
+*/
+void lexLine(char* line, lineTokens* tokens)
+{
+	char *cursor = line;/*The current character in the line*/
+	char *start;/*The first character of the current token*/
+	char *colon = strchr(line, ':');/*The end of the label*/
+	char operation_name[MAX_LENGTH_OF_LINE];/*The operation, for finding it in the reserved words table*/
+
+	tokens->tokens_amount = 0;
+	tokens->label = NO_TOKEN;
+	tokens->operation = NO_TOKEN;
+	tokens->reserved = NULL;
+
+	if(colon){
+		tokens->label = addToken(tokens, LABEL_TOKEN, line, colon - line, FALSE);
+		while(*cursor && !isspace((unsigned char)*cursor))
+			cursor++;
+	}
+
+	while(isspace((unsigned char)*cursor))
+		cursor++;
+	if(*cursor){
+		start = cursor;
+		while(*cursor && !isspace((unsigned char)*cursor))
+			cursor++;
+		tokens->operation = addToken(tokens, OPERATION_TOKEN, start, cursor - start, TRUE);
+		tokenToString(&tokens->tokens[tokens->operation], operation_name);
+		tokens->reserved = findReservedWord(operation_name);
+	}
+	tokens->operands = tokens->tokens_amount;
+
+	if(tokens->reserved && tokens->reserved->kind == INSTRUCTION_WORD && tokens->reserved->id == STRING)
+		lexString(cursor, tokens);
+	else
+		lexOperands(cursor, tokens);
+}
+
+/*
+* The function: lexOperands
+*
+* The function splits the operands of a line to commas and words, a word ends at a white character or at a comma.
+* A word that starts with a number is a number token, and the value of the number is kept in the token.
+*
+* Parameters:
+*	cursor - the first character after the operation.
+*	tokens - a pointer to the tokens of the line.
+*/
+void lexOperands(char* cursor, lineTokens* tokens)
+{
+	char *start;/*The first character of the current token*/
+	char *end;/*The end of the number at the start of the word*/
+	char spaced;/*TRUE if white characters come before the current token*/
+	double value;/*The number at the start of the word*/
+	short index;/*The index of the new token*/
+
+	while(TRUE){
+		spaced = FALSE;
+		while(isspace((unsigned char)*cursor)){
+			cursor++;
+			spaced = TRUE;
+		}
+		if(!*cursor)
+			return;
+
+		start = cursor;
+		if(*cursor == ','){
+			addToken(tokens, COMMA_TOKEN, start, 1, spaced);
+			cursor++;
+			continue;
+		}
+		while(*cursor && !isspace((unsigned char)*cursor) && *cursor != ',')
+			cursor++;
+
+		/*The number never passes the end of the word, strtod stops at white characters and at commas*/
+		value = strtod(start, &end);
+		index = addToken(tokens, (end != start) ? NUMBER_TOKEN : WORD_TOKEN, start, cursor - start, spaced);
+		tokens->tokens[index].value = (end != start) ? value : 0;
+	}
+}
+
+/*
+* The function: lexString
+*
+* The function reads the operand of a .string directive: a string token from the opening quotation mark to the closing
+* one (or to the end of the line, if the string is not closed). Any other characters, before the opening quotation mark
+* or after the closing one, are kept as one word token, until the end of the line.
+*
+* Parameters:
+*	cursor - the first character after the operation.
+*	tokens - a pointer to the tokens of the line.
+*/
+void lexString(char* cursor, lineTokens* tokens)
+{
+	char *end;/*The closing quotation mark*/
+
+	while(isspace((unsigned char)*cursor))
+		cursor++;
+	if(!*cursor)
+		return;
+
+	if(*cursor == '"'){
+		if(!(end = strchr(cursor+1, '"'))){
+			addToken(tokens, STRING_TOKEN, cursor, strlen(cursor), TRUE);
+			return;
+		}
+		addToken(tokens, STRING_TOKEN, cursor, end - cursor + 1, TRUE);
+		for(cursor = end+1; isspace((unsigned char)*cursor); cursor++)
+			;
+		if(!*cursor)
+			return;
+	}
+	addToken(tokens, WORD_TOKEN, cursor, strlen(cursor), TRUE);
+}
+
+/*
+* The function: addToken
+*
+* The function adds a token to the end of the tokens of a line.
+*
+* Parameters:
+*	tokens - a pointer to the tokens of the line.
+*	type - the type of the token.
+*	start - the first character of the token in the line.
+*	length - the amount of characters in the token.
+*	spaced - TRUE if white characters come before the token.
+*
+* Returns:
+*	The index of the new token.
+*/
+short addToken(lineTokens* tokens, char type, char* start, long length, char spaced)
+{
+	token *new_token = &tokens->tokens[tokens->tokens_amount];/*The new token*/
+
+	new_token->type = type;
+	new_token->spaced = spaced;
+	new_token->start = start;
+	new_token->length = (short)length;
+	new_token->value = 0;
+
+	return tokens->tokens_amount++;
+}
+
+/*
+* The function: tokenToString
+*
+* The function copies the characters of a token to a string.
+*
+* Parameters:
+*	current_token - a pointer to the token.
+*	str - the buffer of the string, at least MAX_LENGTH_OF_LINE characters.
+*/
+void tokenToString(token* current_token, char* str)
+{
+	memcpy(str, current_token->start, current_token->length);
+	str[current_token->length] = '\0';
+}
+
+/*
+* The function: getTokensWord
+*
+* The function copies a word of the line to a string, like getWord does: the token at the given index, and the tokens
+* that follow it without white characters between them (so a comma that is attached to a word is a part of the word).
+*
+* Parameters:
+*	tokens - a pointer to the tokens of the line.
+*	index - the index of the first token of the word.
+*	word - the buffer of the word, at least MAX_LENGTH_OF_LINE characters, it is empty if there are no tokens from the index.
+*
+* Returns:
+*	The index of the first token after the word.
+*/
+short getTokensWord(lineTokens* tokens, short index, char* word)
+{
+	short length = 0;/*The length of the word*/
+
+	if(index < tokens->tokens_amount){
+		do{
+			memcpy(word + length, tokens->tokens[index].start, tokens->tokens[index].length);
+			length += tokens->tokens[index++].length;
+		}while(index < tokens->tokens_amount && !tokens->tokens[index].spaced);
+	}
+	word[length] = '\0';
+
+	return index;
+}
+
+/*********************************************************************** - END OF LEXER - ***********************************************************************/
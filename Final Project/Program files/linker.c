@@ -0,0 +1,277 @@
+#include "headers.h"
+
+/*
+* FILE: linker.c
+*
+* This file is the linker program, that links several assembled modules into one loadable image.
+* Usage (the names of the modules are without the suffix):
+*	./linker [-o output] [--obj] module1 module2 ...
+* A module is read from its binary object file (.obj) if it exists, and otherwise from its text object files (.ob, .ent
+* and .ext). The code words of all the modules are laid out from FIRST_MEMORY_CELL in the order of the modules, and the
+* data words of all the modules follow them, like the code and the data of a single file.
+* The linker works in one pass over the modules and one pass over their words:
+*	1. the entries of all the modules are kept in a global hash of names (a name pool), with their final addresses.
+*	2. the words of every code operand that refers to a label of the module (the 'R' bit) are moved to the final address.
+*	3. every word that refers to an extern (the .ext records) is found in the global hash, and it gets the final address
+*	   and the 'R' bit.
+* The image is written to output.ob (by default linked.ob), with an output.ent file of all the entries, and with --obj
+* also to output.obj. Nothing is written if an extern is not found or an entry is defined in more than one module.
+*
+*/
+
+int main(int argc, char *argv[])
+{
+	char *output_name = LINKED_FILE_NAME;/*The name of the output files, without the suffix*/
+	char emit_object = FALSE;/*TRUE if the .obj file should be written too*/
+	char indicator;/*The result of the link*/
+	int i = 1;/*The current argument number*/
+
+	/*Read the options that appear before the names of the modules*/
+	while(i < argc && argv[i][0] == '-'){
+		if(!strcmp(argv[i], "-o") && i+1 < argc)/*The name of the output files*/
+			output_name = argv[++i];
+		else if(!strcmp(argv[i], "--obj"))/*Write the .obj file*/
+			emit_object = TRUE;
+		else{
+			printf("--- Error: unknown option %s. ---\n", argv[i]);
+			return EXIT_FAILURE;
+		}
+		i++;
+	}
+	if(i == argc){
+		printf("--- Usage: linker [-o output] [--obj] module1 module2 ... ---\n");
+		return EXIT_FAILURE;
+	}
+
+	indicator = linkModules(argv + i, argc - i, output_name, emit_object);
+	return (indicator == TRUE) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*
+* The function: linkModules
+*
+* The function loads the modules, resolves their externs against the entries of all the modules, and writes the linked image.
+*
+* Parameters:
+*	modules_names - the names of the modules, without the suffix.
+*	modules_amount - the amount of modules.
+*	output_name - the name of the output files, without the suffix.
+*	emit_object - TRUE if the .obj file should be written too.
+*
+* Returns:
+*	TRUE - if the image was written.
+*	FALSE - if a module could not be read, or the modules could not be linked.
+*	FATAL_ERROR - if a memory allocation failure occurred or an output file could not be created.
+*/
+char linkModules(char** modules_names, int modules_amount, char* output_name, char emit_object)
+{
+	linkModule *modules;/*The modules*/
+	namePool entries_names;/*The global hash of the names of the entries*/
+	arena names_arena;/*The arena of the names of the entries*/
+	int *owners = NULL;/*For every id of a name, the module that defines the entry, or NO_NAME*/
+	short *addresses = NULL;/*For every id of a name, the final address of the entry*/
+	short *code = NULL, *data = NULL;/*The words of the linked image*/
+	objectSymbol *entries = NULL;/*The entries of the linked image*/
+	objectImage linked;/*The linked image*/
+	char *object_file_name;/*The names of the old output files that are removed, and of the .obj output file*/
+	char error_str[ERROR_MESSAGE_SIZE];/*The error message of the name pool*/
+	long code_words = 0, data_words = 0;/*The amount of code words and data words of the image*/
+	int entries_amount = 0, externs_amount = 0;/*The amount of entries and of extern references*/
+	char indicator = TRUE;/*The result of loading the modules and of the allocations*/
+	char resolved = TRUE;/*FALSE if an entry is defined twice or an extern was not found*/
+	char *name;/*The name of the current record*/
+	short address;/*The address of the current record*/
+	int i, j, id, loaded = 0;/*Counters, the id of a name, and the amount of loaded modules*/
+
+	if(!(modules = (linkModule*)malloc(sizeof(linkModule) * modules_amount))){
+		memoryError("modules", modules_names[0]);
+		return FATAL_ERROR;
+	}
+	namePoolInit(&entries_names);
+	arenaInit(&names_arena);
+
+	/*Load the modules, and give every module its place in the image*/
+	for(i = 0; i < modules_amount && indicator == TRUE; i++){
+		modules[i].name = modules_names[i];
+		if((indicator = loadObject(&modules[i].object, modules_names[i])) == TRUE){
+			loaded++;
+			modules[i].code_base = (short)(FIRST_MEMORY_CELL + code_words);
+			code_words += readObjectField(&modules[i].object, OBJECT_CODE_WORDS_FIELD, 2);
+			data_words += readObjectField(&modules[i].object, OBJECT_DATA_WORDS_FIELD, 2);
+			entries_amount += (int)readObjectField(&modules[i].object, OBJECT_ENTRIES_FIELD, 2);
+			externs_amount += (int)readObjectField(&modules[i].object, OBJECT_EXTERNS_FIELD, 2);
+		}
+	}
+	if(indicator == TRUE && code_words + data_words > MEMORY_CELLS - FIRST_MEMORY_CELL + 1){
+		printf("--- Error: the linked image has %ld words, it does not fit in the memory. ---\n", code_words + data_words);
+		indicator = FALSE;
+	}
+	for(i = 0, data_words = 0; i < loaded && indicator == TRUE; i++){/*The data words of the modules follow all the code words*/
+		modules[i].data_base = (short)(FIRST_MEMORY_CELL + code_words + data_words);
+		data_words += readObjectField(&modules[i].object, OBJECT_DATA_WORDS_FIELD, 2);
+	}
+
+	/*Keep the names of the entries in the global hash*/
+	for(i = 0; i < loaded && indicator == TRUE; i++){
+		for(j = 0; j < (int)readObjectField(&modules[i].object, OBJECT_ENTRIES_FIELD, 2) && indicator == TRUE; j++){
+			if(internName(&entries_names, getObjectSymbol(&modules[i].object, OBJECT_ENTRIES_OFFSET_FIELD, j, &address), &names_arena, error_str) == NO_NAME){
+				memoryError(error_str, modules[i].name);
+				indicator = FATAL_ERROR;
+			}
+		}
+	}
+	if(indicator == TRUE && (!(owners = (int*)malloc(sizeof(int) * (entries_names.names_amount+1))) ||
+			!(addresses = (short*)malloc(sizeof(short) * (entries_names.names_amount+1))) ||
+			!(code = (short*)malloc(sizeof(short) * (code_words+1))) || !(data = (short*)malloc(sizeof(short) * (data_words+1))) ||
+			!(entries = (objectSymbol*)malloc(sizeof(objectSymbol) * (entries_amount+1))))){
+		memoryError("linked image", output_name);
+		indicator = FATAL_ERROR;
+	}
+
+	/*The final addresses of the entries*/
+	for(i = 0; i < entries_names.names_amount && indicator == TRUE; i++)
+		owners[i] = NO_NAME;
+	for(i = 0, entries_amount = 0; i < loaded && indicator == TRUE; i++){
+		for(j = 0; j < (int)readObjectField(&modules[i].object, OBJECT_ENTRIES_FIELD, 2); j++){
+			name = getObjectSymbol(&modules[i].object, OBJECT_ENTRIES_OFFSET_FIELD, j, &address);
+			id = findName(&entries_names, name);
+			if(owners[id] != NO_NAME){
+				printf("--- Error: the entry %s is defined in the modules %s and %s. ---\n", name, modules[owners[id]].name, modules[i].name);
+				resolved = FALSE;
+				continue;
+			}
+			owners[id] = i;
+			addresses[id] = relocateAddress(&modules[i], address);
+			entries[entries_amount].name = name;
+			entries[entries_amount++].address = addresses[id];
+		}
+	}
+
+	/*Copy the words of the modules, move the label operands and resolve the externs*/
+	for(i = 0; i < loaded && indicator == TRUE; i++){
+		if(relocateModule(&modules[i], code, data, (short)code_words, &entries_names, owners, addresses) != TRUE)
+			resolved = FALSE;
+	}
+	if(indicator == TRUE && !resolved)
+		indicator = FALSE;
+
+	if(indicator == TRUE){
+		if((indicator = buildObjectImage(&linked, code, (short)code_words, data, (short)data_words, entries, entries_amount, NULL, 0)) != TRUE)
+			memoryError("linked image", output_name);
+		else{
+			/*The .ent and .ext files of an older link are removed (the image has no externs)*/
+			if(!(object_file_name = (char*)malloc(sizeof(char) * (strlen(output_name)+EXT_FILE_SIZE)))){
+				memoryError("linked image", output_name);
+				indicator = FATAL_ERROR;
+			}
+			else{
+				sprintf(object_file_name, "%s.ent", output_name);
+				remove(object_file_name);
+				sprintf(object_file_name, "%s.ext", output_name);
+				remove(object_file_name);
+				sprintf(object_file_name, "%s.obj", output_name);
+				if(writeTextObject(&linked, output_name) != TRUE || (emit_object && writeObjectFile(&linked, object_file_name) != TRUE)){
+					newFileOpenError("linked image", output_name);
+					indicator = FATAL_ERROR;
+				}
+				else
+					printf("--- Linked %d modules into %s: %ld code words, %ld data words, %d entries, %d extern references resolved. ---\n",
+						loaded, output_name, code_words, data_words, entries_amount, externs_amount);
+			}
+			free(object_file_name);
+			freeObjectImage(&linked);
+		}
+	}
+
+	for(i = 0; i < loaded; i++)
+		freeObjectImage(&modules[i].object);
+	free(modules);
+	free(owners);
+	free(addresses);
+	free(code);
+	free(data);
+	free(entries);
+	freeNamePool(&entries_names);
+	arenaFree(&names_arena);
+	return indicator;
+}
+
+/*
+* The function: relocateAddress
+*
+* The function moves an address of a module to its final address in the linked image.
+*
+* Parameters:
+*	module - a pointer to the module.
+*	address - the address in the module (a code address or a data address).
+*
+* Returns:
+*	The final address.
+*/
+short relocateAddress(linkModule* module, short address)
+{
+	short code_words = (short)readObjectField(&module->object, OBJECT_CODE_WORDS_FIELD, 2);/*The amount of code words of the module*/
+
+	if(address < FIRST_MEMORY_CELL + code_words)
+		return (short)(address - FIRST_MEMORY_CELL + module->code_base);
+	return (short)(address - FIRST_MEMORY_CELL - code_words + module->data_base);
+}
+
+/*
+* The function: relocateModule
+*
+* The function copies the words of a module to their place in the linked image. The code words that hold the address of
+* a label of the module ('R' bit) get the final address of the label, and the words that refer to an extern get the
+* final address of its entry.
+*
+* Parameters:
+*	module - a pointer to the module.
+*	code - the code words of the linked image.
+*	data - the data words of the linked image.
+*	image_code_words - the amount of code words of the linked image.
+*	entries_names - the global hash of the names of the entries.
+*	owners - for every id of a name, the module that defines the entry, or NO_NAME.
+*	addresses - for every id of a name, the final address of the entry.
+*
+* Returns:
+*	TRUE - if all the externs of the module were resolved.
+*	FALSE - otherwise, the externs that were not found are printed.
+*/
+char relocateModule(linkModule* module, short* code, short* data, short image_code_words, namePool* entries_names, int* owners, short* addresses)
+{
+	short code_words = (short)readObjectField(&module->object, OBJECT_CODE_WORDS_FIELD, 2);/*The amount of code words of the module*/
+	short data_words = (short)readObjectField(&module->object, OBJECT_DATA_WORDS_FIELD, 2);/*The amount of data words of the module*/
+	short *module_code = code + (module->code_base - FIRST_MEMORY_CELL);/*The code words of the module in the image*/
+	short *module_data = data + (module->data_base - FIRST_MEMORY_CELL - image_code_words);/*The data words of the module in the image*/
+	short word;/*The current word*/
+	char *name;/*The name of the current extern*/
+	short address;/*The address of the word of the current extern*/
+	char indicator = TRUE;/*FALSE if an extern was not found*/
+	int i, id;/*Counter and the id of a name*/
+
+	for(i = 0; i < code_words; i++){
+		word = getObjectWord(&module->object, i);
+		if((word & ARE_MASK) == (1 << R_ADDRESSING_METHOD))/*An operand that holds the address of a label of the module*/
+			word = encodeOperand(relocateAddress(module, (short)(word >> ADDRESS_START_POSITION)), R_ADDRESSING_METHOD);
+		module_code[i] = word;
+	}
+	for(i = 0; i < data_words; i++)
+		module_data[i] = getObjectWord(&module->object, code_words + i);
+
+	for(i = 0; i < (int)readObjectField(&module->object, OBJECT_EXTERNS_FIELD, 2); i++){
+		name = getObjectSymbol(&module->object, OBJECT_EXTERNS_OFFSET_FIELD, i, &address);
+		if(address < FIRST_MEMORY_CELL || address >= FIRST_MEMORY_CELL + code_words){
+			printf("--- Error: the extern %s of the module %s refers to the address %04d, that is not in its code. ---\n", name, module->name, address);
+			indicator = FALSE;
+		}
+		else if((id = findName(entries_names, name)) == NO_NAME || owners[id] == NO_NAME){
+			printf("--- Error: the extern %s of the module %s (address %04d) is not an entry of any module. ---\n", name, module->name, address);
+			indicator = FALSE;
+		}
+		else
+			module_code[address - FIRST_MEMORY_CELL] = encodeOperand(addresses[id], R_ADDRESSING_METHOD);
+	}
+	return indicator;
+}
+
+/************************************************************************ - END OF LINKER - ***********************************************************************/
@@ -0,0 +1,128 @@
+#include "headers.h"
+
+/*
+* FILE: macro_table.c
+*
+* This file includes the functions of the macro table of the pre processor.
+* The names of the macros are kept in the name pool of the file, and the macros are found by the id of the name in an
+* array, so checking the first word of every source line and every label name against the macros names is done in O(1)
+* expected time, no matter how many macros the file has. The array holds pointers to the macros nodes, and it is allocated
+* from the arena of the file.
+*
+*/
+
+/*
+* The function: macroTableInit
+*
+* The function initializes an empty macro table.
+*
+* Parameters:
+*	table - a pointer to the macro table to initialize.
+*	names - a pointer to the name pool of the file, that the names of the macros are kept in.
+*/
+void macroTableInit(macroTable* table, namePool* names)
+{
+	table->names = names;
+	table->by_name = NULL;
+	table->by_name_size = 0;
+	table->macros_amount = 0;
+	table->calls_amount = 0;
+}
+
+/*
+* The function: findMacro
+*
+* The function searches the macro table for the macro with the given name.
+*
+* Parameters:
+*	table - a pointer to the macro table.
+*	name - the name to search for.
+*
+* Returns:
+*	A pointer to the macroNode if the macro name exists in the table, or NULL if the name is not found.
+*/
+macroNode* findMacro(macroTable* table, char* name)
+{
+	int id;/*The id of the name in the name pool*/
+
+	if(!table->macros_amount)
+		return NULL;
+
+	id = findName(table->names, name);
+	if(id == NO_NAME || id >= table->by_name_size)
+		return NULL;
+	return table->by_name[id];
+}
+
+/*
+* The function: growMacrosByName
+*
+* The function enlarges the array of the macros by the ids of the names, so it has a cell for the given id.
+* The old array is released with the arena of the file.
+*
+* Parameters:
+*	table - a pointer to the macro table.
+*	id - the id of a name in the name pool.
+*	file_arena - a pointer to the arena that the new array is allocated from.
+*
+* Returns:
+*	TRUE - if the array has a cell for the id.
+*	FALSE - if a memory allocation failure occurred.
+*/
+char growMacrosByName(macroTable* table, int id, arena* file_arena)
+{
+	macroNode **new_by_name;/*The new array*/
+	int new_size = table->by_name_size ? table->by_name_size : MACRO_TABLE_SIZE;/*The size of the new array*/
+	int i;/*Counter*/
+
+	if(id < table->by_name_size)
+		return TRUE;
+	while(new_size <= id)
+		new_size *= 2;
+
+	new_by_name = (macroNode**)arenaAlloc(file_arena, sizeof(macroNode*) * new_size);
+	if(!new_by_name)
+		return FALSE;
+	for(i = 0; i < new_size; i++)
+		new_by_name[i] = (i < table->by_name_size) ? table->by_name[i] : NULL;
+
+	table->by_name = new_by_name;
+	table->by_name_size = new_size;
+	return TRUE;
+}
+
+/*
+* The function: addMacro
+*
+* The function inserts a new macro to the macro table, the name of the macro must not be in the table yet.
+* The name of the macro is replaced by its copy in the name pool.
+*
+* Parameters:
+*	table - a pointer to the macro table.
+*	macro - a pointer to the macroNode to insert.
+*	file_arena - a pointer to the arena that the array of the macros and a new name are allocated from.
+*	error_str - a pointer to a buffer where an error message will be stored if memory allocation fails.
+*
+* Returns:
+*	TRUE - if the macro was inserted.
+*	FALSE - if a memory allocation failure occurred.
+*/
+char addMacro(macroTable* table, macroNode* macro, arena* file_arena, char* error_str)
+{
+	int id;/*The id of the name in the name pool*/
+
+	if((id = internName(table->names, macro->name, file_arena, error_str)) == NO_NAME)
+		return FALSE;
+	if(!growMacrosByName(table, id, file_arena)){
+		strcpy(error_str, "macro table names");
+		return FALSE;
+	}
+
+	macro->name = table->names->names[id];
+	table->by_name[id] = macro;
+	table->macros_amount++;
+
+	return TRUE;
+}
+
+/********************************************************************* - END OF MACRO TABLE - *********************************************************************/
@@ -0,0 +1,138 @@
+#include "headers.h"
+
+/*
+* FILE: memory_image.c
+*
+* This file includes the functions of the memory image of the assembler.
+* The machine words of the file are kept in two flat arrays of 16 bit words: the code image, where the word of the
+* instruction counter IC is in the cell IC-FIRST_MEMORY_CELL, and the data image, where the word of the data counter DC
+* is in the cell DC. The operands that refer to a label can not be encoded in the first pass, so they are kept in a
+* compact fixup list (the index of the word in the code image, the record of the label in the symbol table and the line
+* it was mentioned in), and the second pass fills only these words. The output file is written by one sweep over the two arrays.
+*
+*/
+
+/*
+* The function: memoryImageInit
+*
+* The function initializes an empty memory image.
+*
+* Parameters:
+*	image - a pointer to the memory image to initialize.
+*/
+void memoryImageInit(memoryImage* image)
+{
+	image->code.words = NULL;
+	image->code.words_amount = 0;
+	image->code.words_size = 0;
+	image->data.words = NULL;
+	image->data.words_amount = 0;
+	image->data.words_size = 0;
+	image->fixups = NULL;
+	image->fixups_amount = 0;
+	image->fixups_size = 0;
+	image->instructions_amount = 0;
+}
+
+/*
+* The function: addImageWord
+*
+* The function adds a word to the end of the code image or of the data image.
+*
+* Parameters:
+*	words - a pointer to the image (the code image or the data image).
+*	word - the binary machine code of the word.
+*	error_str - a pointer to a buffer where an error message will be stored if memory allocation fails.
+*
+* Returns:
+*	TRUE - if the word was added.
+*	FALSE - if a memory allocation failure occurred.
+*/
+char addImageWord(wordsImage* words, short word, char* error_str)
+{
+	short *temp_words;/*The words array after reallocation*/
+
+	if(words->words_amount == words->words_size){/*Enlarge the words array*/
+		words->words_size = words->words_size ? words->words_size*2 : IMAGE_SIZE;
+		temp_words = (short*)realloc(words->words, sizeof(short) * words->words_size);
+		if(!temp_words){
+			strcpy(error_str, "memory image words");
+			return FALSE;
+		}
+		words->words = temp_words;
+	}
+	words->words[words->words_amount++] = word;
+
+	return TRUE;
+}
+
+/*
+* The function: addFixup
+*
+* The function records an operand that refers to a label, the word of the operand is filled in the second pass.
+*
+* Parameters:
+*	image - a pointer to the memory image.
+*	index - the index of the word of the operand in the code image.
+*	symbol_index - the index of the record of the label in the symbol table.
+*	line - the number of the line where the label is mentioned.
+*	error_str - a pointer to a buffer where an error message will be stored if memory allocation fails.
+*
+* Returns:
+*	TRUE - if the fixup was recorded.
+*	FALSE - if a memory allocation failure occurred.
+*/
+char addFixup(memoryImage* image, int index, int symbol_index, unsigned int line, char* error_str)
+{
+	fixup *temp_fixups;/*The fixups array after reallocation*/
+
+	if(image->fixups_amount == image->fixups_size){/*Enlarge the fixups array*/
+		image->fixups_size = image->fixups_size ? image->fixups_size*2 : FIXUPS_SIZE;
+		temp_fixups = (fixup*)realloc(image->fixups, sizeof(fixup) * image->fixups_size);
+		if(!temp_fixups){
+			strcpy(error_str, "memory image fixups");
+			return FALSE;
+		}
+		image->fixups = temp_fixups;
+	}
+	image->fixups[image->fixups_amount].index = index;
+	image->fixups[image->fixups_amount].symbol = symbol_index;
+	image->fixups[image->fixups_amount].line = line;
+	image->fixups_amount++;
+
+	return TRUE;
+}
+
+/*
+* The function: resetMemoryImage
+*
+* The function empties the memory image, and keeps its arrays for the words of the next file.
+*
+* Parameters:
+*	image - a pointer to the memory image.
+*/
+void resetMemoryImage(memoryImage* image)
+{
+	image->code.words_amount = 0;
+	image->data.words_amount = 0;
+	image->fixups_amount = 0;
+	image->instructions_amount = 0;
+}
+
+/*
+* The function: freeMemoryImage
+*
+* The function releases the arrays of the memory image.
+*
+* Parameters:
+*	image - a pointer to the memory image.
+*/
+void freeMemoryImage(memoryImage* image)
+{
+	free(image->code.words);
+	free(image->data.words);
+	free(image->fixups);
+	memoryImageInit(image);
+}
+
+/******************************************************************** - END OF MEMORY IMAGE - *******************************************************************/
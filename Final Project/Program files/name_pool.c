@@ -0,0 +1,202 @@
+#include "headers.h"
+
+/*
+* FILE: name_pool.c
+*
+* This file includes the functions of the name pool of the assembler.
+* Every distinct name of the file (the labels and the macros names) is stored once in the pool, and it gets a small
+* integer id. The symbol table and the macro table keep their records by the id of the name, so a name is hashed and
+* compared with strings only once when it is looked up, and the tables compare and index the names by integers.
+* The names are found by a hash table with open addressing (linear probing), and they are allocated from the arena of the file.
+*
+*/
+
+/*
+* The function: namePoolInit
+*
+* The function initializes an empty name pool.
+*
+* Parameters:
+*	pool - a pointer to the name pool to initialize.
+*/
+void namePoolInit(namePool* pool)
+{
+	pool->names = NULL;
+	pool->names_amount = 0;
+	pool->names_size = 0;
+	pool->slots = NULL;
+	pool->slots_size = 0;
+}
+
+/*
+* The function: hashName
+*
+* The function calculates the hash value of a name (FNV-1a).
+*
+* Parameters:
+*	name - the name.
+*
+* Returns:
+*	The hash value of the name.
+*/
+unsigned long hashName(char* name)
+{
+	unsigned long hash = 2166136261UL;/*The offset basis of FNV-1a*/
+
+	while(*name){
+		hash ^= (unsigned char)*name++;
+		hash = (hash * 16777619UL) & 0xFFFFFFFFUL;
+	}
+	return hash;
+}
+
+/*
+* The function: findName
+*
+* The function searches the name pool for a name.
+*
+* Parameters:
+*	pool - a pointer to the name pool.
+*	name - the name to search for.
+*
+* Returns:
+*	The id of the name, or NO_NAME if the name is not in the pool.
+*/
+int findName(namePool* pool, char* name)
+{
+	unsigned long i;/*The current slot*/
+
+	if(!pool->slots_size)
+		return NO_NAME;
+
+	/*The size of the slots array is a power of 2, so the modulo is a bitwise and*/
+	for(i = hashName(name) & (pool->slots_size-1); pool->slots[i] != NO_NAME; i = (i+1) & (pool->slots_size-1)){
+		if(!strcmp(pool->names[pool->slots[i]], name))
+			return pool->slots[i];
+	}
+	return NO_NAME;
+}
+
+/*
+* The function: growNameSlots
+*
+* The function doubles the size of the slots array of the hash table, and inserts all the names again.
+*
+* Parameters:
+*	pool - a pointer to the name pool.
+*
+* Returns:
+*	TRUE - if the slots array was enlarged.
+*	FALSE - if a memory allocation failure occurred.
+*/
+char growNameSlots(namePool* pool)
+{
+	int *new_slots;/*The new slots array*/
+	int new_size = pool->slots_size ? pool->slots_size*2 : NAME_POOL_SIZE;/*The size of the new slots array*/
+	unsigned long j;/*The slot of the current name*/
+	int i;/*Counter*/
+
+	new_slots = (int*)malloc(sizeof(int) * new_size);
+	if(!new_slots)
+		return FALSE;
+	for(i = 0; i < new_size; i++)
+		new_slots[i] = NO_NAME;
+
+	/*Insert every name to its slot in the new array*/
+	for(i = 0; i < pool->names_amount; i++){
+		for(j = hashName(pool->names[i]) & (new_size-1); new_slots[j] != NO_NAME; j = (j+1) & (new_size-1))
+			;
+		new_slots[j] = i;
+	}
+
+	free(pool->slots);
+	pool->slots = new_slots;
+	pool->slots_size = new_size;
+	return TRUE;
+}
+
+/*
+* The function: internName
+*
+* The function returns the id of a name, and stores the name in the pool if it is not there yet.
+*
+* Parameters:
+*	pool - a pointer to the name pool.
+*	name - the name.
+*	file_arena - a pointer to the arena that a new name is copied to.
+*	error_str - a pointer to a buffer where an error message will be stored if memory allocation fails.
+*
+* Returns:
+*	The id of the name, or NO_NAME if a memory allocation failure occurred.
+*/
+int internName(namePool* pool, char* name, arena* file_arena, char* error_str)
+{
+	int id;/*The id of the name*/
+	unsigned long i;/*The current slot*/
+	char **temp_names;/*The names array after reallocation*/
+
+	if((id = findName(pool, name)) != NO_NAME)
+		return id;
+
+	/*Keep the hash table at most half full*/
+	if((pool->names_amount+1)*2 > pool->slots_size && !growNameSlots(pool)){
+		strcpy(error_str, "name pool slots");
+		return NO_NAME;
+	}
+	if(pool->names_amount == pool->names_size){/*Enlarge the names array*/
+		pool->names_size = pool->names_size ? pool->names_size*2 : NAME_POOL_SIZE;
+		temp_names = (char**)realloc(pool->names, sizeof(char*) * pool->names_size);
+		if(!temp_names){
+			strcpy(error_str, "name pool names");
+			return NO_NAME;
+		}
+		pool->names = temp_names;
+	}
+
+	id = pool->names_amount;
+	if(!(pool->names[id] = arenaStrdup(file_arena, name))){
+		strcpy(error_str, "name pool name");
+		return NO_NAME;
+	}
+	pool->names_amount++;
+
+	for(i = hashName(name) & (pool->slots_size-1); pool->slots[i] != NO_NAME; i = (i+1) & (pool->slots_size-1))
+		;
+	pool->slots[i] = id;
+
+	return id;
+}
+
+/*
+* The function: resetNamePool
+*
+* The function empties the name pool, and keeps its arrays for the names of the next file.
+*
+* Parameters:
+*	pool - a pointer to the name pool.
+*/
+void resetNamePool(namePool* pool)
+{
+	int i;/*Counter*/
+
+	for(i = 0; i < pool->slots_size; i++)
+		pool->slots[i] = NO_NAME;
+	pool->names_amount = 0;
+}
+
+/*
+* The function: freeNamePool
+*
+* The function releases the arrays of the name pool (the names are released with the arena of the file).
+*
+* Parameters:
+*	pool - a pointer to the name pool.
+*/
+void freeNamePool(namePool* pool)
+{
+	free(pool->names);
+	free(pool->slots);
+	namePoolInit(pool);
+}
+
+/********************************************************************* - END OF NAME POOL - **********************************************************************/
@@ -0,0 +1,168 @@
+#include "headers.h"
+
+/*
+* FILE: obconv.c
+*
+* This file is the object converter program, that converts the outputs of the assembler between the text object files
+* (.ob, .ent and .ext) and the binary object file (.obj), so the two formats can be checked against each other.
+* Usage (the files names are without the suffix):
+*	./obconv --to-obj file1 file2 ...	- build the .obj file of the text object files.
+*	./obconv --to-text file1 file2 ...	- write the text object files of the .obj file.
+*	./obconv --check file1 file2 ...	- check that the text object files and the .obj file hold the same object.
+*
+*/
+
+int main(int argc, char *argv[])
+{
+	char indicator = TRUE;/*FALSE if one of the files failed*/
+	int i;/*Counter*/
+
+	if(argc < 3 || (strcmp(argv[1], "--to-obj") && strcmp(argv[1], "--to-text") && strcmp(argv[1], "--check"))){
+		printf("--- Usage: obconv --to-obj|--to-text|--check file1 file2 ... ---\n");
+		return EXIT_FAILURE;
+	}
+
+	for(i = 2; i < argc; i++){
+		if(!strcmp(argv[1], "--check")){
+			if(checkObject(argv[i]) != TRUE)
+				indicator = FALSE;
+		}
+		else if(convertObject(argv[i], !strcmp(argv[1], "--to-obj")) != TRUE)
+			indicator = FALSE;
+	}
+	return indicator ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*
+* The function: convertObject
+*
+* The function converts the object of a file from the text format to the binary format, or from the binary format to
+* the text format.
+*
+* Parameters:
+*	file_name - the name of the object files without the suffix.
+*	to_binary - TRUE to build the .obj file, FALSE to write the text files.
+*
+* Returns:
+*	TRUE - if the object was converted.
+*	FALSE - if the source object does not exist or it is not valid.
+*	FATAL_ERROR - if a memory allocation failure occurred or a file could not be created.
+*/
+char convertObject(char* file_name, char to_binary)
+{
+	objectImage object;/*The object of the file*/
+	char *obj_file_name;/*The name of the .obj file*/
+	char indicator;/*The result of the conversion*/
+
+	if(!(obj_file_name = (char*)malloc(sizeof(char) * (strlen(file_name)+EXT_FILE_SIZE)))){
+		memoryError("obj_file", file_name);
+		return FATAL_ERROR;
+	}
+	strcpy(obj_file_name, file_name);
+	strcat(obj_file_name, ".obj");
+
+	indicator = to_binary ? readTextObject(&object, file_name) : mapObjectFile(&object, obj_file_name);
+	if(indicator == TRUE){
+		indicator = to_binary ? writeObjectFile(&object, obj_file_name) : writeTextObject(&object, file_name);
+		if(indicator != TRUE){
+			newFileOpenError(to_binary ? "obj_file" : "ob_file", file_name);
+			indicator = FATAL_ERROR;
+		}
+		freeObjectImage(&object);
+	}
+	else if(indicator == FATAL_ERROR)
+		memoryError("object", file_name);
+	else
+		printf("--- Error: the %s of %s does not exist or it is not valid. ---\n", to_binary ? "text object" : "binary object", file_name);
+
+	free(obj_file_name);
+	return indicator;
+}
+
+/*
+* The function: checkObject
+*
+* The function reads the text object files and the binary object file of a file, and compares their words, entries and
+* externs. The first difference is printed.
+*
+* Parameters:
+*	file_name - the name of the object files without the suffix.
+*
+* Returns:
+*	TRUE - if the two formats hold the same object.
+*	FALSE - if they are different, or one of them does not exist or it is not valid.
+*	FATAL_ERROR - if a memory allocation failure occurred.
+*/
+char checkObject(char* file_name)
+{
+	short fields[4] = {OBJECT_CODE_WORDS_FIELD, OBJECT_DATA_WORDS_FIELD, OBJECT_ENTRIES_FIELD, OBJECT_EXTERNS_FIELD};/*The amounts of the object*/
+	char *fields_names[4] = {"code words", "data words", "entries", "externs"};/*The names of the amounts*/
+	objectImage text_object, binary_object;/*The object of the text files and of the .obj file*/
+	char *obj_file_name;/*The name of the .obj file*/
+	char *text_name, *binary_name;/*The names of the current records*/
+	short text_address, binary_address;/*The addresses of the current records*/
+	char indicator;/*The result of the check*/
+	int i, j, amount;/*Counters and the amount of the current table*/
+
+	if(!(obj_file_name = (char*)malloc(sizeof(char) * (strlen(file_name)+EXT_FILE_SIZE)))){
+		memoryError("obj_file", file_name);
+		return FATAL_ERROR;
+	}
+	strcpy(obj_file_name, file_name);
+	strcat(obj_file_name, ".obj");
+
+	if((indicator = readTextObject(&text_object, file_name)) != TRUE){
+		if(indicator == FATAL_ERROR)
+			memoryError("object", file_name);
+		else
+			printf("--- Error: the text object of %s does not exist or it is not valid. ---\n", file_name);
+		free(obj_file_name);
+		return indicator;
+	}
+	if((indicator = mapObjectFile(&binary_object, obj_file_name)) != TRUE){
+		if(indicator == FATAL_ERROR)
+			memoryError("object", file_name);
+		else
+			printf("--- Error: the binary object of %s does not exist or it is not valid. ---\n", file_name);
+		freeObjectImage(&text_object);
+		free(obj_file_name);
+		return indicator;
+	}
+
+	for(i = 0; i < 4 && indicator == TRUE; i++){
+		if(readObjectField(&text_object, fields[i], 2) != readObjectField(&binary_object, fields[i], 2)){
+			printf("--- %s: the text object has %lu %s and the binary object has %lu. ---\n", file_name,
+				readObjectField(&text_object, fields[i], 2), fields_names[i], readObjectField(&binary_object, fields[i], 2));
+			indicator = FALSE;
+		}
+	}
+	amount = (int)(readObjectField(&text_object, OBJECT_CODE_WORDS_FIELD, 2) + readObjectField(&text_object, OBJECT_DATA_WORDS_FIELD, 2));
+	for(i = 0; i < amount && indicator == TRUE; i++){
+		if(getObjectWord(&text_object, i) != getObjectWord(&binary_object, i)){
+			printf("--- %s: the word at address %d is %05o in the text object and %05o in the binary object. ---\n", file_name,
+				FIRST_MEMORY_CELL + i, (unsigned int)getObjectWord(&text_object, i), (unsigned int)getObjectWord(&binary_object, i));
+			indicator = FALSE;
+		}
+	}
+	for(j = 0; j < 2 && indicator == TRUE; j++){
+		amount = (int)readObjectField(&text_object, j ? OBJECT_EXTERNS_FIELD : OBJECT_ENTRIES_FIELD, 2);
+		for(i = 0; i < amount && indicator == TRUE; i++){
+			text_name = getObjectSymbol(&text_object, j ? OBJECT_EXTERNS_OFFSET_FIELD : OBJECT_ENTRIES_OFFSET_FIELD, i, &text_address);
+			binary_name = getObjectSymbol(&binary_object, j ? OBJECT_EXTERNS_OFFSET_FIELD : OBJECT_ENTRIES_OFFSET_FIELD, i, &binary_address);
+			if(strcmp(text_name, binary_name) || text_address != binary_address){
+				printf("--- %s: %s %d is %s %04d in the text object and %s %04d in the binary object. ---\n", file_name,
+					j ? "extern" : "entry", i+1, text_name, text_address, binary_name, binary_address);
+				indicator = FALSE;
+			}
+		}
+	}
+	if(indicator == TRUE)
+		printf("--- %s: the text object and the binary object match. ---\n", file_name);
+
+	freeObjectImage(&text_object);
+	freeObjectImage(&binary_object);
+	free(obj_file_name);
+	return indicator;
+}
+
+/******************************************************************** - END OF OBJECT CONVERTER - *****************************************************************/
@@ -0,0 +1,509 @@
+#include "headers.h"
+
+/*
+* FILE: object_file.c
+*
+* This file includes the functions of the binary object format (.obj), and the functions that read and write the text
+* object files (.ob, .ent and .ext), so the tools of the assembler share one reader of the objects.
+* A binary object is kept in the memory exactly as it is kept in the file, so a file is mapped to the memory and used
+* without parsing, and a text object is read by building the same bytes. All the numbers are little endian:
+*	header (OBJECT_HEADER_SIZE bytes):
+*		0  "AOB1"			4  version (16 bits)		6  load base (16 bits)
+*		8  code words (16 bits)		10 data words (16 bits)		12 entries (16 bits)		14 externs (16 bits)
+*		16 offset of the words		20 offset of the entries	24 offset of the externs
+*		28 offset of the strings	32 size of the strings		36 size of the file		(32 bits each)
+*	words - the code words and then the data words, 16 bits each.
+*	entries, externs - OBJECT_SYMBOL_SIZE bytes each: the offset of the name in the strings (32 bits) and the address
+*		(16 bits, and 16 bits of padding). An extern has a record for every word that refers to it.
+*	strings - the distinct names, every name ends with '\0'.
+* The tables start at offsets that are multiples of 4.
+*
+*/
+
+/*
+* The function: readObjectField
+*
+* The function reads a little endian number from the bytes of an object.
+*
+* Parameters:
+*	object - a pointer to the object.
+*	offset - the offset of the number in the object.
+*	size - the amount of bytes of the number (2 or 4).
+*
+* Returns:
+*	The number.
+*/
+unsigned long readObjectField(objectImage* object, size_t offset, short size)
+{
+	unsigned long value = 0;/*The number*/
+
+	while(size--)
+		value = (value << 8) | object->data[offset + size];
+	return value;
+}
+
+/*
+* The function: writeObjectField
+*
+* The function writes a little endian number to the bytes of an object.
+*
+* Parameters:
+*	data - the bytes of the object.
+*	offset - the offset of the number in the object.
+*	value - the number.
+*	size - the amount of bytes of the number (2 or 4).
+*/
+void writeObjectField(unsigned char* data, size_t offset, unsigned long value, short size)
+{
+	short i;/*Counter*/
+
+	for(i = 0; i < size; i++, value >>= 8)
+		data[offset + i] = (unsigned char)(value & 0xFF);
+}
+
+/*
+* The function: getObjectWord
+*
+* The function returns a word of the object, the code words are first and then the data words.
+*
+* Parameters:
+*	object - a pointer to the object.
+*	index - the index of the word.
+*
+* Returns:
+*	The word.
+*/
+short getObjectWord(objectImage* object, int index)
+{
+	return (short)readObjectField(object, readObjectField(object, OBJECT_WORDS_OFFSET_FIELD, 4) + index*2, 2);
+}
+
+/*
+* The function: getObjectSymbol
+*
+* The function returns an entry or an extern record of the object.
+*
+* Parameters:
+*	object - a pointer to the object.
+*	table_field - OBJECT_ENTRIES_OFFSET_FIELD for an entry, or OBJECT_EXTERNS_OFFSET_FIELD for an extern.
+*	index - the index of the record in the table.
+*	address - a pointer that receives the address of the record.
+*
+* Returns:
+*	The name of the record.
+*/
+char* getObjectSymbol(objectImage* object, short table_field, int index, short* address)
+{
+	size_t record = readObjectField(object, table_field, 4) + (size_t)index * OBJECT_SYMBOL_SIZE;/*The offset of the record*/
+
+	*address = (short)readObjectField(object, record + 4, 2);
+	return (char*)object->data + readObjectField(object, OBJECT_STRINGS_OFFSET_FIELD, 4) + readObjectField(object, record, 4);
+}
+
+/*
+* The function: buildObjectImage
+*
+* The function builds the bytes of a binary object. The names of the records are stored once in the strings, they are
+* found with a name pool.
+*
+* Parameters:
+*	object - a pointer to the object, it receives the new bytes.
+*	code - the code words.
+*	code_words - the amount of code words.
+*	data - the data words.
+*	data_words - the amount of data words.
+*	entries - the entry records.
+*	entries_amount - the amount of entry records.
+*	externs - the extern records.
+*	externs_amount - the amount of extern records.
+*
+* Returns:
+*	TRUE - if the object was built.
+*	FATAL_ERROR - if a memory allocation failure occurred.
+*/
+char buildObjectImage(objectImage* object, short* code, short code_words, short* data, short data_words, objectSymbol* entries, int entries_amount, objectSymbol* externs, int externs_amount)
+{
+	namePool names;/*The distinct names of the records*/
+	arena names_arena;/*The arena of the names*/
+	char error_str[ERROR_MESSAGE_SIZE];/*The error message of the name pool, not used*/
+	unsigned long *name_offsets = NULL;/*The offset of every name in the strings*/
+	size_t words_offset = OBJECT_HEADER_SIZE;/*The offsets of the sections*/
+	size_t entries_offset, externs_offset, strings_offset;
+	size_t strings_size = 0;/*The size of the strings*/
+	size_t record;/*The offset of the current record*/
+	objectSymbol *table;/*The current table of records*/
+	int table_amount;/*The amount of records in the current table*/
+	char indicator = TRUE;/*FATAL_ERROR if a memory allocation failure occurred*/
+	int i, j, id;/*Counters and the id of a name*/
+
+	namePoolInit(&names);
+	arenaInit(&names_arena);
+	object->data = NULL;
+	object->is_mapped = FALSE;
+
+	/*Give every distinct name an id, and an offset in the strings*/
+	for(j = 0; j < 2 && indicator == TRUE; j++){
+		table = j ? externs : entries;
+		table_amount = j ? externs_amount : entries_amount;
+		for(i = 0; i < table_amount && indicator == TRUE; i++){
+			if(internName(&names, table[i].name, &names_arena, error_str) == NO_NAME)
+				indicator = FATAL_ERROR;
+		}
+	}
+	if(indicator == TRUE && names.names_amount && !(name_offsets = (unsigned long*)malloc(sizeof(unsigned long) * names.names_amount)))
+		indicator = FATAL_ERROR;
+	for(i = 0; i < names.names_amount && indicator == TRUE; i++){
+		name_offsets[i] = strings_size;
+		strings_size += strlen(names.names[i]) + 1;
+	}
+
+	entries_offset = OBJECT_ALIGN(words_offset + 2 * ((size_t)code_words + data_words));
+	externs_offset = entries_offset + (size_t)entries_amount * OBJECT_SYMBOL_SIZE;
+	strings_offset = externs_offset + (size_t)externs_amount * OBJECT_SYMBOL_SIZE;
+	object->size = strings_offset + strings_size;
+	if(indicator == TRUE && !(object->data = (unsigned char*)calloc(object->size, 1)))
+		indicator = FATAL_ERROR;
+
+	if(indicator == TRUE){
+		memcpy(object->data, OBJECT_MAGIC, 4);
+		writeObjectField(object->data, OBJECT_VERSION_FIELD, OBJECT_VERSION, 2);
+		writeObjectField(object->data, OBJECT_LOAD_BASE_FIELD, FIRST_MEMORY_CELL, 2);
+		writeObjectField(object->data, OBJECT_CODE_WORDS_FIELD, code_words, 2);
+		writeObjectField(object->data, OBJECT_DATA_WORDS_FIELD, data_words, 2);
+		writeObjectField(object->data, OBJECT_ENTRIES_FIELD, entries_amount, 2);
+		writeObjectField(object->data, OBJECT_EXTERNS_FIELD, externs_amount, 2);
+		writeObjectField(object->data, OBJECT_WORDS_OFFSET_FIELD, words_offset, 4);
+		writeObjectField(object->data, OBJECT_ENTRIES_OFFSET_FIELD, entries_offset, 4);
+		writeObjectField(object->data, OBJECT_EXTERNS_OFFSET_FIELD, externs_offset, 4);
+		writeObjectField(object->data, OBJECT_STRINGS_OFFSET_FIELD, strings_offset, 4);
+		writeObjectField(object->data, OBJECT_STRINGS_SIZE_FIELD, strings_size, 4);
+		writeObjectField(object->data, OBJECT_FILE_SIZE_FIELD, object->size, 4);
+
+		for(i = 0; i < code_words; i++)
+			writeObjectField(object->data, words_offset + i*2, (unsigned short)code[i] & WORD_MASK, 2);
+		for(i = 0; i < data_words; i++)
+			writeObjectField(object->data, words_offset + (code_words + i)*2, (unsigned short)data[i] & WORD_MASK, 2);
+
+		for(j = 0; j < 2; j++){
+			table = j ? externs : entries;
+			table_amount = j ? externs_amount : entries_amount;
+			for(i = 0; i < table_amount; i++){
+				id = findName(&names, table[i].name);
+				record = (j ? externs_offset : entries_offset) + (size_t)i * OBJECT_SYMBOL_SIZE;
+				writeObjectField(object->data, record, name_offsets[id], 4);
+				writeObjectField(object->data, record + 4, (unsigned short)table[i].address, 2);
+			}
+		}
+		for(i = 0; i < names.names_amount; i++)
+			strcpy((char*)object->data + strings_offset + name_offsets[i], names.names[i]);
+	}
+
+	free(name_offsets);
+	freeNamePool(&names);
+	arenaFree(&names_arena);
+	return indicator;
+}
+
+/*
+* The function: writeObjectFile
+*
+* The function writes the bytes of a binary object to a file.
+*
+* Parameters:
+*	object - a pointer to the object.
+*	object_file_name - the name of the file.
+*
+* Returns:
+*	TRUE - if the file was written.
+*	FALSE - if the file could not be created.
+*	FATAL_ERROR - if a memory allocation failure occurred.
+*/
+char writeObjectFile(objectImage* object, char* object_file_name)
+{
+	outputBuffer object_file;/*The buffered writer of the file*/
+	char indicator;/*The result of creating the file*/
+
+	if((indicator = outputOpen(&object_file, object_file_name)) != TRUE)
+		return indicator;
+	outputChars(&object_file, (char*)object->data, object->size);
+	outputClose(&object_file);
+	return TRUE;
+}
+
+/*
+* The function: mapObjectFile
+*
+* The function maps a binary object file to the memory, and checks that all its sections are inside the file, so the
+* object can be used without checking it again.
+*
+* Parameters:
+*	object - a pointer to the object, it receives the file.
+*	object_file_name - the name of the file.
+*
+* Returns:
+*	TRUE - if the object is valid.
+*	FALSE - if the file does not exist or it is not a valid binary object.
+*	FATAL_ERROR - if a memory allocation failure occurred.
+*/
+char mapObjectFile(objectImage* object, char* object_file_name)
+{
+	char indicator;/*The result of reading the file*/
+	size_t strings_offset, strings_size = 0;/*The strings of the object*/
+	size_t record;/*The offset of the first record of a table*/
+	int i, j;/*Counters*/
+
+	object->data = NULL;
+	object->is_mapped = TRUE;
+	if((indicator = sourceOpen(&object->file, object_file_name)) != TRUE)
+		return indicator;
+	object->data = (unsigned char*)object->file.text;
+	object->size = object->file.length;
+
+	indicator = (object->size >= OBJECT_HEADER_SIZE && !memcmp(object->data, OBJECT_MAGIC, 4) &&
+			readObjectField(object, OBJECT_VERSION_FIELD, 2) == OBJECT_VERSION &&
+			readObjectField(object, OBJECT_FILE_SIZE_FIELD, 4) == object->size);
+	if(indicator){
+		strings_offset = readObjectField(object, OBJECT_STRINGS_OFFSET_FIELD, 4);
+		strings_size = readObjectField(object, OBJECT_STRINGS_SIZE_FIELD, 4);
+		indicator = (readObjectField(object, OBJECT_WORDS_OFFSET_FIELD, 4) >= OBJECT_HEADER_SIZE &&
+			readObjectField(object, OBJECT_WORDS_OFFSET_FIELD, 4) + 2 * (readObjectField(object, OBJECT_CODE_WORDS_FIELD, 2) +
+				readObjectField(object, OBJECT_DATA_WORDS_FIELD, 2)) <= readObjectField(object, OBJECT_ENTRIES_OFFSET_FIELD, 4) &&
+			readObjectField(object, OBJECT_ENTRIES_OFFSET_FIELD, 4) + readObjectField(object, OBJECT_ENTRIES_FIELD, 2) * OBJECT_SYMBOL_SIZE <=
+				readObjectField(object, OBJECT_EXTERNS_OFFSET_FIELD, 4) &&
+			readObjectField(object, OBJECT_EXTERNS_OFFSET_FIELD, 4) + readObjectField(object, OBJECT_EXTERNS_FIELD, 2) * OBJECT_SYMBOL_SIZE <=
+				strings_offset &&
+			strings_offset + strings_size == object->size && (!strings_size || !object->data[object->size-1]));
+	}
+	/*Every name must start inside the strings*/
+	for(j = 0; j < 2 && indicator; j++){
+		record = readObjectField(object, j ? OBJECT_EXTERNS_OFFSET_FIELD : OBJECT_ENTRIES_OFFSET_FIELD, 4);
+		for(i = 0; i < (int)readObjectField(object, j ? OBJECT_EXTERNS_FIELD : OBJECT_ENTRIES_FIELD, 2) && indicator; i++)
+			indicator = (readObjectField(object, record + (size_t)i * OBJECT_SYMBOL_SIZE, 4) < strings_size);
+	}
+
+	if(!indicator){
+		freeObjectImage(object);
+		return FALSE;
+	}
+	return TRUE;
+}
+
+/*
+* The function: readTextObject
+*
+* The function reads the text object files of an input file (the .ob file, and the .ent and .ext files if they exist),
+* and builds the binary object of them.
+*
+* Parameters:
+*	object - a pointer to the object, it receives the new bytes.
+*	file_name - the name of the files without the suffix.
+*
+* Returns:
+*	TRUE - if the object was built.
+*	FALSE - if the .ob file does not exist, or one of the files is not valid.
+*	FATAL_ERROR - if a memory allocation failure occurred.
+*/
+char readTextObject(objectImage* object, char* file_name)
+{
+	char *suffixes[3] = {".ob", ".ent", ".ext"};/*The suffixes of the files*/
+	char *text_file_name;/*The name of the current file*/
+	char line[MAX_LENGTH_OF_LINE];/*The current line*/
+	char name[MAX_LENGTH_OF_LINE];/*The name of the current record*/
+	FILE *text_file;/*The current file*/
+	short words_amount[2] = {0, 0};/*The amount of code words and data words*/
+	short *words = NULL;/*The words of the object*/
+	objectSymbol *tables[2] = {NULL, NULL};/*The entry records and the extern records*/
+	int tables_amount[2] = {0, 0};/*The amount of records of every table*/
+	int tables_size[2] = {0, 0};/*The allocated size of every table*/
+	objectSymbol *temp_table;/*A table after reallocation*/
+	arena names_arena;/*The arena of the names of the records*/
+	int ic, dc, address;/*The numbers of the current line*/
+	unsigned int word;/*The word of the current line*/
+	char indicator = TRUE;/*The result of reading the files*/
+	int i, j;/*Counters*/
+
+	if(!(text_file_name = (char*)malloc(sizeof(char) * (strlen(file_name)+EXT_FILE_SIZE))))
+		return FATAL_ERROR;
+	arenaInit(&names_arena);
+
+	for(i = 0; i < 3 && indicator == TRUE; i++){
+		sprintf(text_file_name, "%s%s", file_name, suffixes[i]);
+		if(!(text_file = fopen(text_file_name, "r"))){
+			if(!i)/*Only the .ob file must exist*/
+				indicator = FALSE;
+			continue;
+		}
+		if(!i){/*The header line, and then a word in every line from the load base*/
+			if(!fgets(line, MAX_LENGTH_OF_LINE, text_file) || sscanf(line, "%d %d", &ic, &dc) != 2 || ic < 0 || dc < 0 || ic + dc > MEMORY_CELLS)
+				indicator = FALSE;
+			else if(!(words = (short*)malloc(sizeof(short) * (ic + dc + 1))))
+				indicator = FATAL_ERROR;
+			for(j = 0; j < ic + dc && indicator == TRUE; j++){
+				if(!fgets(line, MAX_LENGTH_OF_LINE, text_file) || sscanf(line, "%d %o", &address, &word) != 2 ||
+						address != FIRST_MEMORY_CELL + j || word > WORD_MASK)
+					indicator = FALSE;
+				else
+					words[j] = (short)word;
+			}
+			if(indicator == TRUE && fgets(line, MAX_LENGTH_OF_LINE, text_file))/*There are more lines than words*/
+				indicator = FALSE;
+			words_amount[0] = (short)ic;
+			words_amount[1] = (short)dc;
+		}
+		else{/*A name and an address in every line*/
+			while(indicator == TRUE && fgets(line, MAX_LENGTH_OF_LINE, text_file)){
+				if(sscanf(line, "%s %d", name, &address) != 2 || strlen(name) >= MAX_LENGTH_OF_LABEL)
+					indicator = FALSE;
+				else if(tables_amount[i-1] == tables_size[i-1]){
+					tables_size[i-1] = tables_size[i-1] ? tables_size[i-1]*2 : SYMBOL_TABLE_SIZE;
+					if(!(temp_table = (objectSymbol*)realloc(tables[i-1], sizeof(objectSymbol) * tables_size[i-1])))
+						indicator = FATAL_ERROR;
+					else
+						tables[i-1] = temp_table;
+				}
+				if(indicator == TRUE){
+					tables[i-1][tables_amount[i-1]].address = (short)address;
+					if(!(tables[i-1][tables_amount[i-1]++].name = arenaStrdup(&names_arena, name)))
+						indicator = FATAL_ERROR;
+				}
+			}
+		}
+		fclose(text_file);
+	}
+
+	if(indicator == TRUE)
+		indicator = buildObjectImage(object, words, words_amount[0], words + words_amount[0], words_amount[1], tables[0], tables_amount[0], tables[1], tables_amount[1]);
+
+	free(text_file_name);
+	free(words);
+	free(tables[0]);
+	free(tables[1]);
+	arenaFree(&names_arena);
+	return indicator;
+}
+
+/*
+* The function: writeTextObject
+*
+* The function writes the text object files of a binary object, in the same format as the assembler.
+*
+* Parameters:
+*	object - a pointer to the object.
+*	file_name - the name of the files without the suffix.
+*
+* Returns:
+*	TRUE - if the files were written.
+*	FATAL_ERROR - if a file could not be created or a memory allocation failure occurred.
+*/
+char writeTextObject(objectImage* object, char* file_name)
+{
+	char *suffixes[3] = {".ob", ".ent", ".ext"};/*The suffixes of the files*/
+	short fields[3] = {0, OBJECT_ENTRIES_FIELD, OBJECT_EXTERNS_FIELD};/*The fields of the amounts of the records*/
+	short offset_fields[3] = {0, OBJECT_ENTRIES_OFFSET_FIELD, OBJECT_EXTERNS_OFFSET_FIELD};/*The fields of the tables*/
+	char *text_file_name;/*The name of the current file*/
+	outputBuffer text_file;/*The buffered writer of the current file*/
+	short ic_dc_counter[2];/*The amount of code words and data words*/
+	short is_length[2];/*The length of the longest name of a table, in cell 1*/
+	symbol record;/*The current record, for the printing functions of the second pass*/
+	int amount;/*The amount of records of the current table*/
+	char indicator = TRUE;/*The result of writing the files*/
+	int i, j;/*Counters*/
+
+	if(!(text_file_name = (char*)malloc(sizeof(char) * (strlen(file_name)+EXT_FILE_SIZE))))
+		return FATAL_ERROR;
+	ic_dc_counter[0] = (short)readObjectField(object, OBJECT_CODE_WORDS_FIELD, 2);
+	ic_dc_counter[1] = (short)readObjectField(object, OBJECT_DATA_WORDS_FIELD, 2);
+
+	for(i = 0; i < 3 && indicator == TRUE; i++){
+		amount = i ? (int)readObjectField(object, fields[i], 2) : 0;
+		if(i && !amount)/*The .ent and .ext files are created only when they have records*/
+			continue;
+		sprintf(text_file_name, "%s%s", file_name, suffixes[i]);
+		if(outputOpen(&text_file, text_file_name) != TRUE){
+			indicator = FATAL_ERROR;
+			continue;
+		}
+		if(!i){
+			printfObIcDcNumbersLine(&text_file, ic_dc_counter);
+			for(j = 0; j < ic_dc_counter[0] + ic_dc_counter[1]; j++)
+				printfObOutputLine(&text_file, FIRST_MEMORY_CELL + j, getObjectWord(object, j));
+		}
+		else{
+			is_length[1] = 0;
+			for(j = 0; j < amount; j++){
+				if((short)strlen(getObjectSymbol(object, offset_fields[i], j, &record.address)) > is_length[1])
+					is_length[1] = (short)strlen(getObjectSymbol(object, offset_fields[i], j, &record.address));
+			}
+			for(j = 0; j < amount; j++){
+				record.name = getObjectSymbol(object, offset_fields[i], j, &record.address);
+				if(i == 1)
+					printfEntOutputLine(&text_file, &record, is_length);
+				else
+					printfExtOutputLine(&text_file, &record, record.address, is_length);
+			}
+		}
+		outputClose(&text_file);
+	}
+
+	free(text_file_name);
+	return indicator;
+}
+
+/*
+* The function: loadObject
+*
+* The function loads an object from its binary object file if it exists, or from its text object files.
+*
+* Parameters:
+*	object - a pointer to the object.
+*	file_name - the name of the object files, without the suffix.
+*
+* Returns:
+*	TRUE - if the object was loaded.
+*	FALSE - if the object files do not exist or they are not valid.
+*	FATAL_ERROR - if a memory allocation failure occurred.
+*/
+char loadObject(objectImage* object, char* file_name)
+{
+	char *obj_file_name;/*The name of the .obj file*/
+	char indicator;/*The result of loading the object*/
+
+	if(!(obj_file_name = (char*)malloc(sizeof(char) * (strlen(file_name)+EXT_FILE_SIZE)))){
+		memoryError("obj_file", file_name);
+		return FATAL_ERROR;
+	}
+	strcpy(obj_file_name, file_name);
+	strcat(obj_file_name, ".obj");
+
+	if(!access(obj_file_name, F_OK))
+		indicator = mapObjectFile(object, obj_file_name);
+	else
+		indicator = readTextObject(object, file_name);
+	if(indicator == FATAL_ERROR)
+		memoryError("object", file_name);
+	else if(!indicator)
+		printf("--- Error: the object of %s does not exist or it is not valid. ---\n", file_name);
+
+	free(obj_file_name);
+	return indicator;
+}
+
+/*
+* The function: freeObjectImage
+*
+* The function releases the bytes of an object, or unmaps its file.
+*
+* Parameters:
+*	object - a pointer to the object.
+*/
+void freeObjectImage(objectImage* object)
+{
+	if(object->is_mapped)
+		sourceClose(&object->file);
+	else
+		free(object->data);
+	object->data = NULL;
+	object->size = 0;
+}
+
+/********************************************************************* - END OF OBJECT FILE - *********************************************************************/
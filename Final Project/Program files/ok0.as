@@ -0,0 +1,69 @@
+;generated
+.extern X0
+.extern X1
+.extern X2
+.extern X3
+.extern X4
+macr m_one
+ inc r1
+ mov r1, *r2
+endmacr
+macr m_two
+ prn #5
+endmacr
+jsr D0
+jmp *r5
+lea L4, D0
+lea L3, r1
+stop
+bne X4
+cmp #-77, r0
+bne D2
+L0: inc L4
+add *r7, D1
+bne D1
+prn *r3
+L1: clr D0
+L2: lea L1, X1
+inc X2
+red D2
+bne L7
+m_one
+red D2
+L3: lea L1, r1
+m_one
+sub r1, *r1
+m_one
+m_one
+L4: sub r3, r0
+L5: jsr D0
+m_two
+m_two
+cmp r0, #79
+L6: red r7
+clr r3
+L7: clr D2
+sub r2, X4
+jmp *r6
+dec L0
+add *r0, r4
+stop
+jmp *r2
+prn r1
+m_one
+bne L7
+rts
+jsr X1
+jsr L5
+dec r2
+stop
+mov #26, *r4
+cmp r3, #85
+mov r6, *r0
+mov #-52, L6
+D0: .data 394, -191, -214
+D1: .string "abc1"
+D2: .data 205, -314, -398
+.entry L0
+.entry L7
+  
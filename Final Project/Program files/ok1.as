@@ -0,0 +1,338 @@
+;generated
+.extern X0
+.extern X1
+.extern X2
+.extern X3
+.extern X4
+macr m_one
+ inc r1
+ mov r1, *r2
+endmacr
+macr m_two
+ prn #5
+endmacr
+add *r1, *r7
+not D12
+m_one
+mov r4, r3
+L0: bne L2
+m_one
+prn D4
+rts
+red L28
+mov r1, L37
+jsr L38
+stop
+cmp r3, r6
+red D6
+L1: clr r6
+stop
+m_one
+prn L21
+not r3
+red *r4
+mov r2, r3
+L2: red r3
+red *r5
+m_one
+bne *r0
+clr X4
+dec L9
+L3: mov *r3, *r1
+L4: jmp L21
+clr r4
+bne *r7
+bne *r3
+not r6
+L5: mov r2, L20
+jsr X0
+mov r5, r6
+m_two
+cmp *r1, #-21
+clr *r4
+cmp D8, D15
+m_one
+L6: jsr D13
+jmp *r0
+jmp L20
+lea D4, L34
+red r7
+add #-79, L21
+dec *r4
+jmp D12
+sub *r0, *r1
+lea L43, L48
+m_two
+dec *r4
+rts
+L7: cmp *r0, #-77
+cmp L30, r2
+L8: inc L13
+jmp *r7
+bne L3
+m_one
+bne *r6
+L9: bne *r1
+stop
+not *r3
+L10: dec D7
+bne L49
+L11: clr *r4
+L12: add L28, L31
+add #-95, r0
+stop
+sub *r1, r2
+L13: lea L39, D15
+lea L18, r0
+not L38
+L14: inc *r1
+jsr *r7
+prn *r2
+L15: jsr L7
+lea L33, *r6
+L16: add D12, L22
+rts
+inc L40
+inc r6
+dec r3
+m_one
+m_two
+clr r3
+red D9
+prn L19
+cmp r6, *r6
+L17: cmp #-35, #-32
+L18: lea D6, L48
+prn L41
+stop
+L19: jsr L37
+mov X1, *r0
+m_one
+dec L22
+dec *r4
+clr r5
+not r6
+mov #45, r0
+lea D14, *r4
+bne L15
+jmp *r5
+stop
+prn L0
+not *r6
+jmp D7
+red r0
+prn *r1
+jmp D2
+L20: prn *r2
+mov *r4, r6
+lea L33, *r2
+L21: sub r1, *r1
+L22: clr r1
+jmp X1
+dec L9
+red *r0
+dec *r3
+stop
+bne L33
+mov r5, *r3
+L23: clr r7
+lea D8, r2
+L24: rts
+inc L26
+sub D0, *r7
+cmp #52, #92
+L25: rts
+sub L12, D1
+clr L30
+prn D7
+sub L10, L1
+bne *r4
+lea L1, *r2
+prn *r2
+m_two
+mov #37, X1
+L26: dec D5
+L27: lea L24, r7
+dec r3
+clr *r6
+cmp *r6, X2
+dec r1
+lea L26, *r0
+m_two
+stop
+L28: bne L16
+lea D7, X1
+bne L38
+m_one
+bne L33
+jmp D4
+not *r5
+stop
+rts
+mov *r2, L47
+jsr *r2
+L29: bne *r4
+mov #-62, *r5
+rts
+red r6
+cmp L6, r4
+bne *r5
+bne L3
+lea L23, *r0
+dec r1
+L30: add #-45, r2
+red *r4
+stop
+jsr *r5
+stop
+dec *r3
+m_one
+stop
+m_two
+jsr L45
+not *r0
+bne *r6
+jsr *r7
+lea L32, r0
+cmp *r6, r4
+mov #-77, L49
+red r7
+sub r5, D3
+dec *r2
+jsr *r4
+jsr *r7
+prn r1
+m_two
+L31: mov #-36, D11
+L32: clr L11
+cmp X2, r5
+m_one
+jsr L33
+L33: cmp L11, r1
+stop
+L34: stop
+not X0
+jmp *r3
+stop
+red r4
+m_two
+sub D15, *r4
+lea L24, *r0
+lea L34, *r7
+not *r5
+clr r2
+rts
+L35: bne L27
+bne L16
+inc X2
+L36: clr r1
+L37: jmp *r5
+m_one
+m_one
+add L35, r5
+prn #-69
+L38: dec L5
+L39: sub *r5, L34
+add D1, *r3
+mov *r1, *r2
+prn #73
+stop
+prn *r3
+cmp #-56, L27
+mov *r4, r4
+sub *r1, r5
+mov *r7, r2
+lea D11, *r5
+L40: prn r6
+dec *r0
+L41: lea L12, *r0
+jsr *r5
+cmp #20, #65
+L42: cmp #50, X1
+dec r5
+inc r3
+clr L5
+red *r0
+red *r5
+lea L43, r1
+L43: stop
+sub #22, L49
+prn L12
+bne D9
+not *r7
+L44: stop
+lea L48, *r1
+clr *r6
+jmp L19
+dec D9
+inc r6
+inc *r2
+inc X2
+clr *r0
+cmp D14, #-37
+cmp r1, #64
+L45: inc L2
+dec r6
+L46: bne *r6
+prn D13
+lea L35, L10
+lea L32, *r5
+mov L16, *r3
+not r6
+lea D0, r3
+lea L3, r6
+lea L30, *r2
+prn *r2
+red *r4
+not r7
+m_one
+sub *r7, *r0
+m_two
+L47: lea L14, *r3
+prn #81
+lea L0, r1
+prn r3
+inc *r4
+dec *r1
+clr r0
+L48: not *r5
+L49: cmp r7, L22
+not r6
+not L46
+add *r0, *r0
+clr L36
+add r1, *r4
+red *r0
+stop
+m_one
+bne L35
+m_two
+red *r6
+mov #-91, r0
+bne *r5
+cmp *r1, r1
+D0: .data 367, 52, -44
+D1: .string "abc1"
+D2: .data -158, 12, 441
+D3: .string "abc3"
+D4: .data 329, 57, -497
+D5: .string "abc5"
+D6: .data 444, -336, 431
+D7: .string "abc7"
+D8: .data -168, -131, -281
+D9: .string "abc9"
+D10: .data -351, 417, 94
+D11: .string "abc11"
+D12: .data -349, 103, -390
+D13: .string "abc13"
+D14: .data -87, -176, 387
+D15: .string "abc15"
+.entry L0
+.entry L7
+.entry L14
+.entry L21
+.entry L28
+.entry L35
+.entry L42
+.entry L49
+  
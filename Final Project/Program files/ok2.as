@@ -0,0 +1,982 @@
+;generated
+.extern X0
+.extern X1
+.extern X2
+.extern X3
+.extern X4
+macr m_one
+ inc r1
+ mov r1, *r2
+endmacr
+macr m_two
+ prn #5
+endmacr
+cmp #-79, *r2
+jmp *r3
+clr *r6
+red r7
+mov *r7, *r6
+clr r2
+L0: bne L34
+clr *r6
+red r5
+rts
+rts
+dec *r5
+rts
+rts
+bne D7
+jmp *r6
+red r1
+mov D40, L15
+L1: inc r1
+L2: dec L53
+L3: cmp #-8, *r2
+L4: sub #-94, D36
+lea D38, L133
+cmp L38, #-99
+sub *r5, *r0
+cmp *r6, L121
+L5: bne L6
+lea L124, r5
+dec *r6
+lea L64, L33
+L6: inc r0
+rts
+m_two
+red *r6
+lea L98, *r2
+inc L25
+m_one
+L7: mov r7, *r6
+not r6
+L8: cmp r2, #69
+sub *r4, r5
+jsr L26
+mov r0, *r7
+add #-28, L95
+inc *r3
+rts
+sub *r1, L20
+prn D27
+stop
+stop
+lea L68, *r7
+jsr *r4
+L9: dec r6
+add #-82, *r2
+L10: jsr L22
+cmp L75, r3
+bne *r2
+L11: jsr L84
+dec L40
+prn *r2
+prn L100
+prn *r6
+bne D44
+not *r6
+mov *r7, r7
+mov r3, r6
+sub r3, *r3
+mov r7, *r2
+add *r0, *r1
+bne *r4
+add *r2, *r4
+lea L41, *r6
+lea L72, r7
+prn r3
+lea D26, r4
+m_two
+jmp *r1
+lea L78, L59
+dec L28
+prn *r3
+L12: rts
+jmp *r2
+not *r5
+stop
+red L91
+L13: dec r6
+bne *r5
+jmp L94
+dec *r7
+clr *r6
+L14: red L91
+m_two
+jsr L138
+prn *r7
+L15: bne L127
+L16: not *r4
+add *r3, D31
+bne *r0
+L17: add r7, *r2
+sub *r6, L13
+bne D0
+stop
+rts
+rts
+m_one
+lea D24, r2
+m_two
+mov *r1, r5
+L18: jsr L86
+cmp r3, #23
+L19: cmp #-49, #33
+inc L95
+L20: sub L27, *r3
+prn *r6
+clr r1
+L21: not L96
+lea L33, *r5
+sub r4, *r7
+lea L7, r3
+cmp D10, #90
+cmp L36, *r0
+lea D45, D25
+jmp L40
+dec r1
+cmp r4, #62
+mov L107, *r4
+not *r2
+rts
+prn r4
+rts
+bne *r1
+stop
+lea L53, r4
+mov L80, L81
+bne *r1
+mov *r2, L38
+add r4, r1
+inc L144
+inc D8
+prn r3
+dec r3
+prn r1
+stop
+inc L14
+add #-87, *r6
+sub *r5, r7
+inc *r0
+m_one
+m_one
+inc r0
+sub #73, r2
+L22: jmp *r7
+m_one
+sub *r1, r5
+dec *r4
+mov #-13, *r0
+cmp #76, r6
+clr r0
+m_one
+red r2
+cmp L144, L103
+m_two
+add L59, r3
+add *r3, L134
+prn r2
+L23: red L146
+jsr *r2
+red L5
+L24: lea L145, r4
+not *r6
+cmp r0, r4
+L25: stop
+inc *r7
+rts
+clr *r4
+jsr L129
+prn #10
+rts
+prn r5
+clr L59
+jsr *r7
+clr *r4
+prn *r4
+prn #-48
+L26: red *r5
+L27: bne L134
+inc *r1
+jmp *r2
+L28: bne *r7
+mov r3, D39
+L29: jmp *r7
+not r5
+clr L138
+inc D0
+dec r3
+L30: prn r5
+clr *r0
+L31: not r3
+m_one
+not r2
+mov #-8, L78
+m_one
+add r2, X1
+add *r2, *r1
+jmp *r0
+add r2, D0
+cmp *r7, #-61
+red r4
+not L56
+m_one
+L32: add L89, L108
+L33: mov #-13, r2
+cmp D38, r6
+jmp *r1
+L34: sub #-77, L90
+jmp L22
+inc *r1
+not *r0
+stop
+clr r1
+L35: prn L107
+dec r1
+clr D19
+add *r2, r3
+prn r1
+L36: sub r0, r1
+inc *r6
+L37: lea L100, L26
+rts
+m_one
+cmp L111, #-51
+bne L44
+dec r3
+jmp *r6
+prn *r6
+jmp *r6
+add #-35, *r7
+stop
+not *r1
+jsr L130
+clr L78
+L38: add *r2, L141
+m_one
+jmp L41
+not r3
+dec r4
+prn #-86
+L39: bne *r0
+L40: cmp L94, *r7
+dec D34
+inc L98
+jsr *r1
+L41: cmp r1, L5
+m_one
+stop
+bne L1
+m_two
+m_one
+mov L7, *r4
+mov *r4, L99
+clr *r0
+jsr L147
+inc L55
+clr r0
+L42: not r3
+not r2
+sub *r7, r2
+mov #-42, r4
+jmp D45
+L43: stop
+L44: red *r6
+sub D15, r3
+add r1, r2
+L45: not *r5
+L46: not L86
+inc r4
+mov #-99, L53
+inc L62
+L47: sub r1, *r6
+mov L31, L57
+dec X1
+L48: jmp D38
+L49: mov #71, D17
+mov #-42, r5
+dec L43
+L50: dec *r1
+bne *r3
+stop
+bne L117
+m_one
+inc r6
+cmp r4, #15
+jsr D43
+clr r3
+dec r2
+cmp D30, #-85
+L51: dec r2
+add r2, L106
+L52: not *r0
+not r7
+rts
+cmp *r6, L108
+clr r2
+sub L7, *r0
+prn *r2
+m_two
+bne *r0
+cmp L92, #-97
+lea D2, r6
+m_two
+sub *r4, *r7
+rts
+mov #91, r1
+rts
+mov *r0, L41
+not L141
+bne L28
+clr r2
+dec *r5
+rts
+prn #33
+stop
+add r6, *r4
+stop
+m_one
+jsr D5
+L53: dec r0
+cmp r4, r3
+dec r6
+L54: clr *r0
+L55: bne *r3
+prn L5
+m_one
+prn *r2
+cmp r6, *r1
+rts
+inc *r7
+stop
+stop
+prn #-33
+bne L146
+cmp #-76, L43
+inc r3
+sub *r7, *r2
+jmp *r7
+bne *r2
+L56: jsr *r2
+bne *r4
+red r6
+cmp X3, *r3
+not *r2
+inc r1
+m_one
+stop
+m_one
+add *r2, *r2
+jsr *r2
+rts
+prn L46
+L57: not *r3
+m_two
+m_two
+L58: sub D30, *r3
+stop
+lea L93, r3
+red *r2
+dec r1
+m_one
+inc L56
+jsr *r2
+jsr *r2
+sub L135, r6
+L59: jsr *r6
+add #27, *r7
+clr D39
+bne *r7
+lea L48, r3
+L60: cmp r1, r7
+mov #3, *r2
+lea L28, L53
+L61: bne X4
+L62: lea L9, r4
+inc r7
+m_one
+stop
+L63: inc L89
+m_one
+L64: jsr L58
+stop
+add L39, L122
+rts
+lea L149, *r4
+L65: jsr L81
+m_one
+lea D14, r5
+add *r1, L38
+mov *r2, r0
+jmp *r7
+cmp L102, *r5
+rts
+jmp L18
+m_two
+lea L92, *r7
+L66: red r2
+lea L106, L102
+red *r5
+stop
+m_one
+L67: stop
+sub r4, r6
+cmp L51, #-68
+mov D35, r3
+add *r2, L136
+jmp *r1
+L68: dec *r0
+dec *r7
+mov *r5, L64
+m_one
+L69: inc *r1
+rts
+jmp *r4
+prn *r0
+jsr *r2
+m_two
+L70: prn *r7
+m_two
+rts
+dec *r1
+sub r0, D0
+not *r4
+red *r5
+m_one
+inc *r3
+not L100
+L71: prn D1
+bne L99
+jmp L62
+jmp D37
+m_one
+jmp *r6
+cmp r7, L49
+cmp #-82, r4
+not r6
+L72: not X1
+L73: clr r1
+red *r7
+mov L3, *r0
+stop
+not *r6
+jsr L100
+lea L136, r3
+add *r0, L32
+L74: dec *r1
+bne L124
+not L75
+L75: not r6
+cmp *r0, *r4
+rts
+dec D10
+jmp *r5
+prn D35
+stop
+m_one
+cmp #71, #55
+L76: not r2
+L77: red L21
+inc *r4
+clr r5
+jsr L47
+stop
+prn r3
+sub r7, L8
+clr r3
+cmp *r0, *r3
+clr L64
+stop
+clr L8
+add *r2, D2
+dec L137
+prn L90
+add L30, r4
+inc *r4
+prn *r1
+dec L109
+mov *r4, r7
+m_two
+prn D32
+bne L66
+sub *r4, L35
+add r2, D45
+L78: stop
+add r5, D6
+m_two
+bne *r7
+inc *r7
+mov *r3, L81
+inc *r0
+L79: jsr L39
+inc r3
+red L147
+L80: bne *r5
+stop
+not *r6
+L81: dec r3
+rts
+stop
+jmp *r5
+m_one
+mov *r3, *r0
+L82: clr *r7
+stop
+L83: inc *r1
+clr D32
+sub D3, r0
+rts
+inc *r5
+dec r3
+stop
+L84: prn D39
+lea D13, *r3
+dec L104
+add #-69, L90
+clr L116
+add r2, *r3
+L85: add L147, *r4
+rts
+jsr *r3
+sub r0, *r4
+rts
+not *r3
+not D29
+dec r6
+stop
+cmp D11, *r0
+red r5
+bne *r2
+prn L22
+bne L120
+mov #-6, *r6
+L86: sub L85, r3
+jmp *r5
+sub *r5, r1
+dec r1
+add #-53, D9
+inc *r1
+dec L71
+jsr *r3
+jsr L105
+L87: stop
+L88: mov *r2, r5
+not r4
+m_one
+red *r6
+jmp *r0
+jmp L74
+stop
+red r3
+L89: lea D9, *r7
+m_one
+L90: clr r2
+m_one
+L91: not L64
+cmp *r1, #-34
+bne L108
+sub #24, L120
+stop
+red D35
+rts
+L92: sub L125, *r6
+L93: cmp #62, r0
+dec L110
+inc r1
+L94: jmp L138
+mov #96, *r1
+dec L35
+cmp r1, L68
+jmp L45
+L95: rts
+mov D1, r3
+not L57
+red *r1
+prn #75
+bne *r7
+red *r1
+red r7
+prn #50
+not r1
+L96: stop
+lea L93, r5
+clr L23
+mov r1, r4
+jmp *r5
+jsr *r1
+L97: cmp #14, L33
+L98: add #-75, L37
+cmp L130, r7
+not *r7
+m_two
+jsr L4
+add *r7, r4
+add L9, L16
+L99: dec *r4
+m_one
+L100: sub r1, L3
+L101: sub *r7, *r2
+mov D27, *r6
+m_one
+inc L111
+add #-28, r7
+rts
+L102: add L100, *r0
+rts
+not L138
+bne *r7
+stop
+bne L121
+mov *r3, D10
+jmp *r1
+inc *r0
+L103: sub *r4, r0
+inc *r0
+rts
+mov r2, *r5
+dec r4
+L104: bne *r6
+red *r0
+L105: inc D13
+dec L48
+inc L79
+jsr *r2
+prn r7
+rts
+stop
+L106: inc r4
+L107: dec D20
+L108: rts
+dec r1
+L109: jsr *r7
+clr r0
+dec *r0
+stop
+not r4
+bne *r5
+rts
+rts
+m_two
+L110: add r2, L89
+cmp *r1, L35
+cmp r7, *r5
+mov #1, D36
+cmp #75, #-60
+red *r2
+mov L128, r5
+red *r2
+sub L18, r3
+bne *r7
+m_two
+add r7, *r6
+clr D15
+clr r4
+L111: dec *r5
+dec *r7
+prn *r0
+L112: stop
+add r5, r7
+jmp *r1
+not r1
+m_one
+stop
+rts
+L113: jsr *r0
+inc D14
+stop
+dec *r5
+dec *r1
+not r7
+red L111
+add #12, r5
+L114: not L7
+mov r2, *r1
+dec r3
+inc r6
+sub D20, L124
+dec *r0
+L115: inc r7
+cmp L30, #-88
+sub *r5, L111
+not *r0
+rts
+jsr *r7
+L116: jmp L54
+mov L135, *r3
+jmp X2
+red *r2
+m_one
+red L22
+L117: stop
+add *r1, *r1
+m_one
+rts
+rts
+L118: add #-50, r4
+add r7, r6
+mov L138, r0
+rts
+prn *r1
+L119: bne L11
+inc r3
+prn #-65
+dec r4
+mov *r1, L147
+prn r3
+inc *r5
+m_two
+rts
+prn *r1
+add #-90, D28
+L120: stop
+m_one
+m_two
+stop
+L121: cmp #-6, #-38
+clr L82
+L122: prn L79
+cmp *r7, #89
+bne D19
+cmp *r6, *r3
+stop
+jmp D21
+dec r6
+rts
+red r3
+stop
+jsr L56
+L123: not D22
+mov D37, L23
+m_one
+red L132
+bne L0
+bne *r6
+not r1
+m_one
+add r0, L134
+L124: bne *r2
+red *r3
+cmp #36, r7
+dec L114
+add #-26, r2
+L125: stop
+jsr *r6
+L126: prn L82
+clr r7
+stop
+stop
+rts
+stop
+m_one
+L127: lea L78, *r3
+m_one
+dec *r0
+cmp *r6, L70
+L128: prn *r6
+prn #-10
+sub r4, L17
+bne *r5
+mov #-80, *r3
+jsr L96
+bne *r3
+dec L37
+red D34
+m_two
+L129: not *r2
+mov #-34, *r4
+m_one
+L130: prn L71
+red D44
+add L59, *r6
+L131: mov *r4, *r6
+lea L72, *r3
+inc *r5
+red L74
+sub D39, r2
+not r7
+mov L17, *r1
+lea X2, D12
+stop
+not *r6
+bne L110
+m_two
+cmp *r4, #69
+stop
+dec *r6
+not r5
+lea L123, *r2
+inc *r5
+sub L126, D8
+sub *r3, r3
+jsr *r7
+add #68, r4
+lea L10, *r7
+L132: inc r1
+prn *r2
+m_two
+lea D33, r0
+m_one
+stop
+m_one
+jmp *r2
+L133: red r3
+mov r3, L129
+bne L60
+jsr *r3
+L134: jsr L66
+sub r3, *r0
+prn L102
+prn #-74
+jsr *r0
+clr *r5
+dec r0
+prn L68
+sub *r4, *r4
+L135: dec *r3
+m_one
+L136: mov L126, *r2
+not L130
+mov r0, r2
+prn #64
+L137: prn #-32
+jsr L118
+L138: prn L134
+sub *r6, r0
+L139: add *r4, L148
+inc D27
+cmp L31, #57
+jsr L37
+mov r4, *r5
+jsr D35
+inc *r5
+jsr L8
+m_one
+inc r4
+stop
+bne L41
+clr L107
+jmp *r6
+jmp *r0
+stop
+m_two
+L140: jmp D33
+not *r7
+inc D1
+jmp D28
+lea L134, *r1
+stop
+L141: red *r6
+rts
+rts
+L142: rts
+rts
+jsr *r0
+mov *r0, r5
+L143: not D43
+lea L14, *r1
+sub r6, *r5
+red L51
+L144: rts
+not r5
+inc *r1
+L145: red D36
+red L19
+L146: jmp *r3
+sub r2, *r7
+m_one
+m_one
+not L78
+red L59
+cmp *r0, #-17
+lea L100, *r1
+L147: dec *r2
+prn *r1
+lea L28, r6
+stop
+stop
+stop
+stop
+m_one
+L148: mov r2, *r1
+mov #56, L128
+mov *r4, r5
+L149: add D34, *r0
+not D38
+sub #18, r4
+inc L80
+clr r3
+stop
+rts
+dec *r5
+jmp *r5
+bne *r2
+not r5
+D0: .data -431, -403, 450
+D1: .string "abc1"
+D2: .data 188, -35, 97
+D3: .string "abc3"
+D4: .data -432, -460, 291
+D5: .string "abc5"
+D6: .data 169, -90, 439
+D7: .string "abc7"
+D8: .data 491, -124, 400
+D9: .string "abc9"
+D10: .data -41, -19, 480
+D11: .string "abc11"
+D12: .data 337, 240, -250
+D13: .string "abc13"
+D14: .data 381, 122, -21
+D15: .string "abc15"
+D16: .data -464, 310, 263
+D17: .string "abc17"
+D18: .data -168, -384, -326
+D19: .string "abc19"
+D20: .data 343, -201, -189
+D21: .string "abc21"
+D22: .data -244, -470, -229
+D23: .string "abc23"
+D24: .data -302, 466, -354
+D25: .string "abc25"
+D26: .data -419, -43, 274
+D27: .string "abc27"
+D28: .data 35, -203, -223
+D29: .string "abc29"
+D30: .data -92, -141, 439
+D31: .string "abc31"
+D32: .data 101, -242, 158
+D33: .string "abc33"
+D34: .data 343, 397, -435
+D35: .string "abc35"
+D36: .data 163, -151, 429
+D37: .string "abc37"
+D38: .data -395, -67, 381
+D39: .string "abc39"
+D40: .data -350, 194, -222
+D41: .string "abc41"
+D42: .data 368, -159, 76
+D43: .string "abc43"
+D44: .data -231, -431, -356
+D45: .string "abc45"
+.entry L0
+.entry L7
+.entry L14
+.entry L21
+.entry L28
+.entry L35
+.entry L42
+.entry L49
+.entry L56
+.entry L63
+.entry L70
+.entry L77
+.entry L84
+.entry L91
+.entry L98
+.entry L105
+.entry L112
+.entry L119
+.entry L126
+.entry L133
+.entry L140
+.entry L147
+  
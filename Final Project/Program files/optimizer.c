@@ -0,0 +1,479 @@
+#include "headers.h"
+
+/*
+* FILE: optimizer.c
+*
+* This file includes the optimization passes, that run on the code image between the first pass and the second pass
+* when they are asked for (--thread-jumps, --dce, --peephole). The labels are not resolved yet at this point: the word of a label operand is
+* still empty, and its fixup holds the record of the label, so the code can be shortened and the labels moved before
+* the second pass fills the words.
+*
+* The code image is read into a code stream: the list of the instructions (the opcode, the addressing types and the
+* words of every instruction), and for every word its fixup and whether a label is defined at it. A pass removes
+* instructions and drops words, and the stream is compacted at the end: the words are moved down, the fixups get their
+* new indexes, the code labels move to their new addresses (a label of a removed instruction moves to the instruction
+* after it), and the data labels move down by the amount of words that were saved.
+*
+* The jump threading pass retargets a jmp, bne or jsr whose label is a jmp to the label of that jmp, along the whole
+* chain, so the run does not go through the middle jumps (they are often left dead, for the dead code pass). A bne that
+* goes to a bne is retargeted too: bne does not change the flags, so the second one jumps as well.
+*
+* The dead code pass removes the basic blocks that the run can not get to (see control_flow.c), like the code of a macro
+* that is expanded after a jmp or a stop, or a subroutine that is never called.
+*
+* The peephole pass removes the instructions that do nothing:
+*	mov X, X					- the target is not changed, and mov does not set the flags.
+*	inc X followed by dec X (or dec X, inc X)	- the value is not changed, if the flags are not used after the pair and
+*							  no label is defined at the second instruction.
+*	jmp L or bne L, when L is the next instruction	- the instruction after it runs anyway.
+*	cmp X, Y					- if the flags are not used after it.
+* The flags are not used after an instruction if an instruction that sets them (cmp, add, sub, clr, not, inc and dec) or
+* stop comes before bne, jmp, jsr and rts in the straight line code that follows it.
+*
+*/
+
+/*
+* The function: optimizeCode
+*
+* The function runs the optimization passes of the options on the code image of a file, and prints the words that
+* were saved.
+*
+* Parameters:
+*	file_name - the name of the file, for the report.
+*	ic_dc_counter - the amount of code words (cell 0) and data words (cell 1), the amount of code words is updated.
+*	image - a pointer to the memory image of the file.
+*	symbols - a pointer to the symbol table of the file, the addresses of the labels are updated.
+*	optimizations - the passes to run, a bit for every pass.
+*	file_arena - a pointer to the arena of the file, the tables of the code stream are allocated from it.
+*
+* Returns:
+*	TRUE - if the passes were run.
+*	FATAL_ERROR - if a memory allocation failure occurred.
+*/
+char optimizeCode(char* file_name, short* ic_dc_counter, memoryImage* image, symbolTable* symbols, char optimizations, arena* file_arena)
+{
+	codeStream stream;/*The instructions of the code image*/
+	char indicator;/*The result of reading the code image*/
+
+	if((indicator = buildCodeStream(&stream, image, symbols, file_arena)) != TRUE)
+		return indicator;
+
+	if(optimizations & JUMP_THREADING)
+		threadJumpsPass(&stream, file_name);
+	if((optimizations & DEAD_CODE_ELIMINATION) && deadCodePass(&stream, file_name, file_arena) == FATAL_ERROR)
+		return FATAL_ERROR;
+	if(optimizations & PEEPHOLE_OPTIMIZATION)
+		peepholePass(&stream);
+
+	compactCodeStream(&stream, ic_dc_counter);
+	printf("--- Optimized %s: %d words saved, %d instructions removed. ---\n", file_name, stream.words_saved, stream.removed_amount);
+	return TRUE;
+}
+
+/*
+* The function: buildCodeStream
+*
+* The function reads the code image to a code stream: the instructions in their order, and for every word the
+* instruction that starts at it, its fixup and whether a label is defined at it.
+*
+* Parameters:
+*	stream - a pointer to the code stream.
+*	image - a pointer to the memory image of the file.
+*	symbols - a pointer to the symbol table of the file.
+*	file_arena - a pointer to the arena that the tables of the stream are allocated from.
+*
+* Returns:
+*	TRUE - if the stream was built.
+*	FALSE - if a word of the code is not a valid instruction, the code is not optimized.
+*	FATAL_ERROR - if a memory allocation failure occurred.
+*/
+char buildCodeStream(codeStream* stream, memoryImage* image, symbolTable* symbols, arena* file_arena)
+{
+	int words_amount = image->code.words_amount;/*The amount of words of the code*/
+	codeInstruction *instruction;/*The current instruction*/
+	int i, index;/*Counter and the index of the current word*/
+
+	stream->image = image;
+	stream->symbols = symbols;
+	stream->instructions_amount = stream->words_saved = stream->removed_amount = 0;
+	stream->instructions = (codeInstruction*)arenaAlloc(file_arena, sizeof(codeInstruction) * (words_amount+1));
+	stream->instruction_at = (int*)arenaAlloc(file_arena, sizeof(int) * (words_amount+1));
+	stream->fixup_at = (int*)arenaAlloc(file_arena, sizeof(int) * (words_amount+1));
+	stream->new_index = (int*)arenaAlloc(file_arena, sizeof(int) * (words_amount+1));
+	stream->labeled = (char*)arenaAlloc(file_arena, sizeof(char) * (words_amount+1));
+	stream->dropped = (char*)arenaAlloc(file_arena, sizeof(char) * (words_amount+1));
+	if(!stream->instructions || !stream->instruction_at || !stream->fixup_at || !stream->new_index || !stream->labeled || !stream->dropped){
+		memoryError("code stream", "optimizer");
+		return FATAL_ERROR;
+	}
+	for(index = 0; index <= words_amount; index++){
+		stream->instruction_at[index] = NO_INSTRUCTION;
+		stream->fixup_at[index] = NO_FIXUP;
+		stream->labeled[index] = stream->dropped[index] = FALSE;
+	}
+
+	for(index = 0; index < words_amount; index += instruction->length){
+		instruction = &stream->instructions[stream->instructions_amount];
+		if(!decodeFirstWord(image->code.words[index], &instruction->opcode, instruction->types))
+			return FALSE;
+		instruction->start = index;
+		instruction->length = instructionLength(instruction->types);
+		instruction->removed = FALSE;
+		stream->instruction_at[index] = stream->instructions_amount++;
+	}
+	/*The end of the code is a place that a jump may reach too*/
+	stream->instruction_at[words_amount] = stream->instructions_amount;
+
+	for(i = 0; i < image->fixups_amount; i++)
+		stream->fixup_at[image->fixups[i].index] = i;
+	for(i = 0; i < symbols->symbols_amount; i++){
+		index = symbols->symbols[i].address - FIRST_MEMORY_CELL;
+		if(symbols->symbols[i].defined_type == CODE && index >= 0 && index <= words_amount)
+			stream->labeled[index] = TRUE;
+	}
+	return TRUE;
+}
+
+/*
+* The function: threadJumpsPass
+*
+* The function retargets the jumps to jumps, to the end of their chains, and prints every rewritten jump.
+*
+* Parameters:
+*	stream - a pointer to the code stream.
+*	file_name - the name of the file, for the report.
+*/
+void threadJumpsPass(codeStream* stream, char* file_name)
+{
+	codeInstruction *instruction, *hop;/*The current jump and the jump in its chain*/
+	fixup *target_fixup;/*The fixup of the label of the current jump*/
+	int i, target, hop_fixup;/*The index of the current jump, its target instruction and the fixup of the hop*/
+	int label, hops, rewritten = 0;/*The label at the end of the chain, the amount of hops and the rewritten jumps*/
+
+	for(i = nextLiveInstruction(stream, 0); i < stream->instructions_amount; i = nextLiveInstruction(stream, i+1)){
+		instruction = &stream->instructions[i];
+		if((instruction->opcode != JMP && instruction->opcode != BNE && instruction->opcode != JSR) ||
+				(target = jumpTarget(stream, instruction)) == NO_INSTRUCTION)
+			continue;
+		target_fixup = &stream->image->fixups[stream->fixup_at[operandWord(instruction, 1)]];
+		label = target_fixup->symbol;
+
+		/*A chain of jumps that goes around in a loop ends after visiting every instruction*/
+		for(hops = 0; target != NO_INSTRUCTION && (target = nextLiveInstruction(stream, target)) < stream->instructions_amount &&
+				hops < stream->instructions_amount; hops++){
+			hop = &stream->instructions[target];
+			if((hop->opcode != JMP && (hop->opcode != BNE || instruction->opcode != BNE)) || hop->types[1] != DIRECT_ADDRESSING ||
+					(hop_fixup = stream->fixup_at[operandWord(hop, 1)]) == NO_FIXUP || stream->image->fixups[hop_fixup].symbol == label)
+				break;
+			label = stream->image->fixups[hop_fixup].symbol;
+			target = jumpTarget(stream, hop);
+		}
+
+		if(label != target_fixup->symbol){
+			printf("--- Jump threading of %s, on line %u: %s %s is retargeted to %s. ---\n", file_name, target_fixup->line,
+				getOpcodeName(instruction->opcode), stream->symbols->symbols[target_fixup->symbol].name, stream->symbols->symbols[label].name);
+			target_fixup->symbol = label;
+			rewritten++;
+		}
+	}
+	printf("--- Jump threading of %s: %d jumps rewritten. ---\n", file_name, rewritten);
+}
+
+/*
+* The function: deadCodePass
+*
+* The function removes the instructions of the basic blocks that can not be reached, and prints their amount.
+*
+* Parameters:
+*	stream - a pointer to the code stream.
+*	file_name - the name of the file, for the report.
+*	file_arena - a pointer to the arena that the control flow graph is allocated from.
+*
+* Returns:
+*	TRUE - if the pass was run.
+*	FATAL_ERROR - if a memory allocation failure occurred.
+*/
+char deadCodePass(codeStream* stream, char* file_name, arena* file_arena)
+{
+	controlFlow flow;/*The basic blocks of the code*/
+	basicBlock *block;/*The current block*/
+	int i, j, dead_blocks = 0;/*Counters and the amount of blocks that were removed*/
+
+	if(buildControlFlow(&flow, stream, file_arena) == FATAL_ERROR || markReachableBlocks(&flow, stream, file_arena) == FATAL_ERROR)
+		return FATAL_ERROR;
+
+	for(i = 0; i < flow.blocks_amount; i++){
+		block = &flow.blocks[i];
+		if(block->reachable)
+			continue;
+		for(j = block->first; j <= block->last; j = nextLiveInstruction(stream, j+1))
+			removeInstruction(stream, j);
+		dead_blocks++;
+	}
+	printf("--- Dead code of %s: %d of %d basic blocks can not be reached. ---\n", file_name, dead_blocks, flow.blocks_amount);
+	return TRUE;
+}
+
+/*
+* The function: peepholePass
+*
+* The function removes the instructions of the patterns that are described at the top of the file, until
+* no pattern is found (a removal may make another pattern, like a jump to the instruction after a removed one).
+*
+* Parameters:
+*	stream - a pointer to the code stream.
+*/
+void peepholePass(codeStream* stream)
+{
+	codeInstruction *instruction, *next_instruction;/*The current instruction and the instruction after it*/
+	char changed = TRUE;/*TRUE if the last round changed the code*/
+	int i, next;/*The index of the current instruction and of the instruction after it*/
+
+	while(changed){
+		changed = FALSE;
+		for(i = nextLiveInstruction(stream, 0); i < stream->instructions_amount; i = nextLiveInstruction(stream, i+1)){
+			instruction = &stream->instructions[i];
+			next = nextLiveInstruction(stream, i+1);
+			next_instruction = &stream->instructions[next];
+
+			if(instruction->opcode == MOV && sameOperand(stream, instruction, 0, instruction, 1))
+				removeInstruction(stream, i);
+			else if(instruction->opcode == CMP && flagsAreDead(stream, next))
+				removeInstruction(stream, i);
+			else if((instruction->opcode == JMP || instruction->opcode == BNE) &&
+					jumpTarget(stream, instruction) != NO_INSTRUCTION && nextLiveInstruction(stream, jumpTarget(stream, instruction)) == next)
+				removeInstruction(stream, i);
+			else if((instruction->opcode == INC || instruction->opcode == DEC) && next < stream->instructions_amount &&
+					next_instruction->opcode == (instruction->opcode == INC ? DEC : INC) &&
+					!isLabeled(stream, instruction->start + instruction->length, next_instruction->start) &&
+					sameOperand(stream, instruction, 1, next_instruction, 1) && flagsAreDead(stream, nextLiveInstruction(stream, next+1))){
+				removeInstruction(stream, i);
+				removeInstruction(stream, next);
+			}
+			else
+				continue;
+			changed = TRUE;
+		}
+	}
+}
+
+/*
+* The function: nextLiveInstruction
+*
+* The function returns the first instruction from a given instruction that was not removed.
+*
+* Parameters:
+*	stream - a pointer to the code stream.
+*	index - the index of the instruction to start from.
+*
+* Returns:
+*	The index of the instruction, or the amount of instructions if all the instructions from the index were removed.
+*/
+int nextLiveInstruction(codeStream* stream, int index)
+{
+	while(index < stream->instructions_amount && stream->instructions[index].removed)
+		index++;
+	return index;
+}
+
+/*
+* The function: isLabeled
+*
+* The function checks if a label is defined at the words between two indexes, a label of a removed instruction moves
+* to the instruction after it so the words of the removed instructions are checked too.
+*
+* Parameters:
+*	stream - a pointer to the code stream.
+*	from - the index of the first word.
+*	to - the index of the last word.
+*
+* Returns:
+*	TRUE - if a label is defined at one of the words.
+*	FALSE - otherwise.
+*/
+char isLabeled(codeStream* stream, int from, int to)
+{
+	for(; from <= to; from++){
+		if(stream->labeled[from])
+			return TRUE;
+	}
+	return FALSE;
+}
+
+/*
+* The function: removeInstruction
+*
+* The function removes an instruction from the code: all its words are dropped.
+*
+* Parameters:
+*	stream - a pointer to the code stream.
+*	index - the index of the instruction.
+*/
+void removeInstruction(codeStream* stream, int index)
+{
+	codeInstruction *instruction = &stream->instructions[index];/*The instruction*/
+	short i;/*Counter*/
+
+	instruction->removed = TRUE;
+	for(i = 0; i < instruction->length; i++)
+		stream->dropped[instruction->start+i] = TRUE;
+	stream->words_saved += instruction->length;
+	stream->removed_amount++;
+}
+
+/*
+* The function: operandWord
+*
+* The function returns the index of the word of an operand of an instruction.
+*
+* Parameters:
+*	instruction - a pointer to the instruction.
+*	operand - 0 for the source operand, 1 for the target operand.
+*
+* Returns:
+*	The index of the word in the code image.
+*/
+int operandWord(codeInstruction* instruction, short operand)
+{
+	return instruction->start + operandWordOffset(instruction->types, operand);
+}
+
+/*
+* The function: sameOperand
+*
+* The function checks if two operands are the same: the same register, the same label, or the same number.
+*
+* Parameters:
+*	stream - a pointer to the code stream.
+*	first, second - pointers to the instructions of the operands.
+*	first_operand, second_operand - 0 for the source operand, 1 for the target operand.
+*
+* Returns:
+*	TRUE - if the operands are the same.
+*	FALSE - otherwise.
+*/
+char sameOperand(codeStream* stream, codeInstruction* first, short first_operand, codeInstruction* second, short second_operand)
+{
+	short *words = stream->image->code.words;/*The words of the code*/
+	int first_word = operandWord(first, first_operand), second_word = operandWord(second, second_operand);/*The words of the operands*/
+	short first_value, second_value;/*The registers of the operands*/
+
+	if(first->types[first_operand] != second->types[second_operand])
+		return FALSE;
+	if(first->types[first_operand] == DIRECT_ADDRESSING)/*The same record of a label*/
+		return stream->fixup_at[first_word] != NO_FIXUP && stream->fixup_at[second_word] != NO_FIXUP &&
+			stream->image->fixups[stream->fixup_at[first_word]].symbol == stream->image->fixups[stream->fixup_at[second_word]].symbol;
+	if(first->types[first_operand] == IMMEDIATE_ADDRESSING)
+		return words[first_word] == words[second_word];
+	return decodeOperandWord(words[first_word], first->types[first_operand], first_operand, &first_value) &&
+		decodeOperandWord(words[second_word], second->types[second_operand], second_operand, &second_value) && first_value == second_value;
+}
+
+/*
+* The function: jumpTarget
+*
+* The function returns the instruction that a jump to a label of the code goes to.
+*
+* Parameters:
+*	stream - a pointer to the code stream.
+*	instruction - a pointer to the jump instruction.
+*
+* Returns:
+*	The index of the target instruction (the amount of instructions for the end of the code), or NO_INSTRUCTION if
+*	the target is a register, an extern label or a label that is not defined at the start of an instruction.
+*/
+int jumpTarget(codeStream* stream, codeInstruction* instruction)
+{
+	int fixup_index = stream->fixup_at[operandWord(instruction, 1)];/*The fixup of the target*/
+	symbol *record;/*The record of the label*/
+	int index;/*The index of the word of the label*/
+
+	if(instruction->types[1] != DIRECT_ADDRESSING || fixup_index == NO_FIXUP)
+		return NO_INSTRUCTION;
+	record = &stream->symbols->symbols[stream->image->fixups[fixup_index].symbol];
+	index = record->address - FIRST_MEMORY_CELL;
+	if(record->is_extern || record->defined_type != CODE || index < 0 || index > stream->image->code.words_amount)
+		return NO_INSTRUCTION;
+	return stream->instruction_at[index];
+}
+
+/*
+* The function: flagsAreDead
+*
+* The function checks that the flags are not used from a given instruction: an instruction that sets the flags, or
+* stop, is reached in the straight line code before an instruction that may use them (bne, or a jump that leaves
+* the straight line code).
+*
+* Parameters:
+*	stream - a pointer to the code stream.
+*	index - the index of the instruction to start from.
+*
+* Returns:
+*	TRUE - if the flags are not used.
+*	FALSE - if they may be used.
+*/
+char flagsAreDead(codeStream* stream, int index)
+{
+	codeInstruction *instruction;/*The current instruction*/
+
+	for(index = nextLiveInstruction(stream, index); index < stream->instructions_amount; index = nextLiveInstruction(stream, index+1)){
+		instruction = &stream->instructions[index];
+		if(instruction->opcode == STOP || getOpcodeRule(instruction->opcode)->sets_flags)
+			return TRUE;
+		if(instruction->opcode == BNE || instruction->opcode == JMP || instruction->opcode == JSR || instruction->opcode == RTS)
+			return FALSE;
+	}
+	return TRUE;/*The end of the code*/
+}
+
+/*
+* The function: compactCodeStream
+*
+* The function removes the dropped words from the code image, and moves the fixups and the labels to their new places.
+*
+* Parameters:
+*	stream - a pointer to the code stream.
+*	ic_dc_counter - the amount of code words (cell 0) and data words (cell 1), the amount of code words is updated.
+*/
+void compactCodeStream(codeStream* stream, short* ic_dc_counter)
+{
+	memoryImage *image = stream->image;/*The memory image of the file*/
+	symbol *record;/*The current label*/
+	int words_amount = image->code.words_amount;/*The amount of words before the compaction*/
+	int new_amount = 0, fixups_amount = 0;/*The amounts of words and fixups after the compaction*/
+	int i, index;/*Counter and the index of the word of the current label*/
+
+	if(!stream->words_saved)
+		return;
+
+	/*The new index of every word that is kept, and for a dropped word the new index of the next word that is kept*/
+	for(i = 0; i < words_amount; i++){
+		stream->new_index[i] = new_amount;
+		if(!stream->dropped[i])
+			image->code.words[new_amount++] = image->code.words[i];
+	}
+	stream->new_index[words_amount] = new_amount;
+
+	for(i = 0; i < image->fixups_amount; i++){
+		if(stream->dropped[image->fixups[i].index])
+			continue;
+		image->fixups[fixups_amount] = image->fixups[i];
+		image->fixups[fixups_amount++].index = stream->new_index[image->fixups[i].index];
+	}
+	image->fixups_amount = fixups_amount;
+
+	for(i = 0; i < stream->symbols->symbols_amount; i++){
+		record = &stream->symbols->symbols[i];
+		index = record->address - FIRST_MEMORY_CELL;
+		if(record->defined_type == CODE && index >= 0 && index <= words_amount)
+			record->address = (short)(FIRST_MEMORY_CELL + stream->new_index[index]);
+		else if(record->defined_type == DATA || record->defined_type == STRING)
+			record->address -= (short)stream->words_saved;
+	}
+
+	image->code.words_amount = new_amount;
+	image->instructions_amount -= stream->removed_amount;
+	ic_dc_counter[0] = (short)new_amount;
+}
+
+/********************************************************************* - END OF OPTIMIZER - ***********************************************************************/
@@ -0,0 +1,192 @@
+#include "headers.h"
+
+/*
+* FILE: output.c
+*
+* This file includes the functions of the buffered writer of the output files (.ob, .ext and .ent).
+* The lines of a file are formatted by hand (decimal and octal numbers, names and spaces) into a big buffer,
+* and the buffer is written to the file with a single write call whenever it is full and when the file is closed,
+* instead of a call to fprintf for every word and for every space.
+*
+*/
+
+/*
+* The function: outputOpen
+*
+* The function creates an output file for writing, and allocates the buffer of the file.
+*
+* Parameters:
+*	output - a pointer to the output buffer of the file.
+*	output_file_name - the name of the file to create.
+*
+* Returns:
+*	TRUE - if the file was created.
+*	FALSE - if the file could not be created.
+*	FATAL_ERROR - if a memory allocation failure occurred.
+*/
+char outputOpen(outputBuffer* output, char* output_file_name)
+{
+	output->used = 0;
+	if(!(output->data = (char*)malloc(OUTPUT_BUFFER_SIZE)))
+		return FATAL_ERROR;
+
+	/*The same permissions that fopen gives to a new file*/
+	if((output->fd = open(output_file_name, O_WRONLY | O_CREAT | O_TRUNC, 0666)) < 0){
+		free(output->data);
+		output->data = NULL;
+		return FALSE;
+	}
+	return TRUE;
+}
+
+/*
+* The function: outputFlush
+*
+* The function writes the content of the buffer to the file, and empties the buffer.
+*
+* Parameters:
+*	output - a pointer to the output buffer of the file.
+*/
+void outputFlush(outputBuffer* output)
+{
+	size_t written = 0;/*The amount of bytes that were already written*/
+	ssize_t length;/*The amount of bytes that were written by the last call*/
+
+	while(written < output->used){
+		length = write(output->fd, output->data + written, output->used - written);
+		if(length < 0){
+			if(errno == EINTR)/*Interrupted before anything was written, try again*/
+				continue;
+			break;/*The output is lost, like an error of fprintf that is not checked*/
+		}
+		written += length;
+	}
+	output->used = 0;
+}
+
+/*
+* The function: outputClose
+*
+* The function writes what is left in the buffer, closes the file and releases the buffer.
+*
+* Parameters:
+*	output - a pointer to the output buffer of the file.
+*/
+void outputClose(outputBuffer* output)
+{
+	outputFlush(output);
+	close(output->fd);
+	free(output->data);
+	output->data = NULL;
+}
+
+/*
+* The function: outputChars
+*
+* The function appends characters to the buffer, and writes the buffer to the file when it is full.
+*
+* Parameters:
+*	output - a pointer to the output buffer of the file.
+*	chars - the characters to append.
+*	length - the amount of characters to append.
+*/
+void outputChars(outputBuffer* output, char* chars, size_t length)
+{
+	size_t part;/*The amount of characters that fit in the buffer*/
+
+	while(length){
+		if(output->used == OUTPUT_BUFFER_SIZE)
+			outputFlush(output);
+		part = OUTPUT_BUFFER_SIZE - output->used;
+		if(part > length)
+			part = length;
+		memcpy(output->data + output->used, chars, part);
+		output->used += part;
+		chars += part;
+		length -= part;
+	}
+}
+
+/*
+* The function: outputString
+*
+* The function appends a string to the buffer.
+*
+* Parameters:
+*	output - a pointer to the output buffer of the file.
+*	str - the string to append.
+*/
+void outputString(outputBuffer* output, char* str)
+{
+	outputChars(output, str, strlen(str));
+}
+
+/*
+* The function: outputSpaces
+*
+* The function appends spaces to the buffer, nothing is appended if the amount is not positive.
+*
+* Parameters:
+*	output - a pointer to the output buffer of the file.
+*	amount - the amount of spaces.
+*/
+void outputSpaces(outputBuffer* output, long amount)
+{
+	for(; amount > 0; amount--)
+		outputChars(output, " ", 1);
+}
+
+/*
+* The function: outputDecimal
+*
+* The function appends a decimal number to the buffer, like printf with the format %0<width>d.
+*
+* Parameters:
+*	output - a pointer to the output buffer of the file.
+*	value - the number.
+*	width - the minimum amount of characters, the number is padded with zeros after the sign (0 for no padding).
+*/
+void outputDecimal(outputBuffer* output, long value, short width)
+{
+	char digits[NUMBER_DIGITS_SIZE];/*The digits of the number, filled from the end*/
+	short i = NUMBER_DIGITS_SIZE;/*The index of the first digit*/
+	unsigned long number = (value < 0) ? 0UL - (unsigned long)value : (unsigned long)value;/*The absolute value*/
+
+	if(value < 0){
+		outputChars(output, "-", 1);
+		width--;
+	}
+	do{
+		digits[--i] = (char)('0' + number % 10);
+		number /= 10;
+	}while(number);
+	while(NUMBER_DIGITS_SIZE - i < width && i > 0)
+		digits[--i] = '0';
+	outputChars(output, digits+i, NUMBER_DIGITS_SIZE - i);
+}
+
+/*
+* The function: outputOctal
+*
+* The function appends an octal number to the buffer, like printf with the format %0<width>o.
+*
+* Parameters:
+*	output - a pointer to the output buffer of the file.
+*	value - the number.
+*	width - the minimum amount of digits, the number is padded with zeros.
+*/
+void outputOctal(outputBuffer* output, unsigned long value, short width)
+{
+	char digits[NUMBER_DIGITS_SIZE];/*The digits of the number, filled from the end*/
+	short i = NUMBER_DIGITS_SIZE;/*The index of the first digit*/
+
+	do{
+		digits[--i] = (char)('0' + (value & 07));
+		value >>= 3;
+	}while(value);
+	while(NUMBER_DIGITS_SIZE - i < width && i > 0)
+		digits[--i] = '0';
+	outputChars(output, digits+i, NUMBER_DIGITS_SIZE - i);
+}
+
+/************************************************************************ - END OF OUTPUT - ***********************************************************************/
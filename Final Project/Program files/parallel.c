@@ -0,0 +1,231 @@
+#include "headers.h"
+
+/*
+* FILE: parallel.c
+*
+* This file includes the functions that assemble several input files at the same time (the -j option of the assembler).
+* Every input file is assembled by a child process, so the files do not share any memory, and a memory error in one
+* file stops only the process of that file.
+* The output of every child process is written to a temporary file, and it is printed to the console only when all
+* the files that appear before it in the command line were printed, so the messages are grouped per file in the
+* same order as the files names were received.
+*
+*/
+
+/*
+* The function: runParallelAssembly
+*
+* The main function for managing the assembly of several input files at the same time.
+* The function keeps up to jobs_amount child processes running, and prints the output of every file in the order of the files names.
+*
+* Parameters:
+*	files_names - the names of the input files as received from the user (without the .as suffix).
+*	files_amount - the amount of input files.
+*	options - the options of the assembler, jobs_amount is the maximum amount of files that are assembled at the same time.
+*
+* Returns:
+*	TRUE - if all the files were assembled without fatal errors.
+*	FATAL_ERROR - if there was a fatal error in at least one of the files.
+*/
+char runParallelAssembly(char** files_names, int files_amount, assemblerOptions* options)
+{
+	assemblyJob *jobs;/*The jobs array, a job for every input file*/
+	int next_job = 0;/*The index of the next job to start*/
+	int next_print = 0;/*The index of the next job that its output should be printed*/
+	short running = 0;/*The amount of jobs that are running right now*/
+	char indicator = TRUE;/*Represent if there was a fatal error in one of the files*/
+
+	jobs = (assemblyJob*)calloc(files_amount, sizeof(assemblyJob));
+	if(!jobs){/*If there was an error in allocation*/
+		memoryError("jobs", files_names[0]);
+		return FATAL_ERROR;
+	}
+	/*If SIGCHLD is ignored (it is kept from the parent through exec) the children are reaped without their exit status*/
+	signal(SIGCHLD, SIG_DFL);
+
+	while(next_print < files_amount){
+		/*Start new jobs as long as there are free workers*/
+		while(running < options->jobs_amount && next_job < files_amount){
+			if(startAssemblyJob(&jobs[next_job], files_names[next_job], options))
+				running++;
+			else{/*If a new process could not be created, the file is assembled by this process after all the previous files*/
+				while(running)
+					running -= waitForAssemblyJob(jobs, files_amount);
+				printFinishedJobs(jobs, files_amount, &next_print, &indicator);
+				jobs[next_job].indicator = buildFile(files_names[next_job], options);
+				jobs[next_job].finished = TRUE;
+				jobs[next_job].printed = TRUE;
+				finishJobOutput(&jobs[next_job], files_amount-next_job, &indicator);
+				next_print++;
+			}
+			next_job++;
+		}
+		if(running)/*Wait for one of the running jobs to finish*/
+			running -= waitForAssemblyJob(jobs, files_amount);
+		printFinishedJobs(jobs, files_amount, &next_print, &indicator);
+	}
+
+	/*The children count their use of the build cache in their exit status*/
+	for(next_job = 0; next_job < files_amount && options->cache; next_job++){
+		if(jobs[next_job].cache_result == JOB_CACHE_HIT)
+			options->cache->hits++;
+		else if(jobs[next_job].cache_result == JOB_CACHE_MISS)
+			options->cache->misses++;
+	}
+
+	free(jobs);
+	return indicator;
+}
+
+/*
+* The function: startAssemblyJob
+*
+* The function creates a child process that assembles one input file, and writes its output to a temporary file.
+*
+* Parameters:
+*	job - a pointer to the job of the input file.
+*	file_name - the name of the input file as received from the user.
+*	options - the options of the assembler.
+*
+* Returns:
+*	TRUE - if the child process was created.
+*	FALSE - if the temporary file or the child process could not be created.
+*/
+char startAssemblyJob(assemblyJob* job, char* file_name, assemblerOptions* options)
+{
+	char indicator;/*The result of the assembly in the child process*/
+	long hits = 0, misses = 0;/*The statistics of the build cache before the file*/
+	int status;/*The exit status of the child process*/
+
+	if(!(job->output = tmpfile()))/*If the temporary file could not be created*/
+		return FALSE;
+
+	fflush(stdout);/*So the child process will not print again what is waiting in the buffer*/
+	job->pid = fork();
+	if(job->pid < 0){/*If the child process could not be created*/
+		fclose(job->output);
+		job->output = NULL;
+		return FALSE;
+	}
+
+	if(!job->pid){/*The child process*/
+		dup2(fileno(job->output), STDOUT_FILENO);/*The output of the file is written to the temporary file*/
+		if(options->cache){
+			hits = options->cache->hits;
+			misses = options->cache->misses;
+		}
+		indicator = buildFile(file_name, options);
+		fflush(stdout);
+		status = (indicator == FATAL_ERROR) ? JOB_FATAL_ERROR : (indicator ? JOB_SUCCESS : JOB_ERROR);
+		if(options->cache && options->cache->hits > hits)
+			status += JOB_CACHE_HIT;
+		else if(options->cache && options->cache->misses > misses)
+			status += JOB_CACHE_MISS;
+		_exit(status);
+	}
+
+	return TRUE;
+}
+
+/*
+* The function: waitForAssemblyJob
+*
+* The function waits for one of the child processes to finish, and saves its result in its job.
+* If the wait fails for a reason other than a signal, the results of the running jobs can not be known any more, so
+* all of them are finished as fatal errors.
+*
+* Parameters:
+*	jobs - the jobs array.
+*	files_amount - the amount of jobs in the array.
+*
+* Returns:
+*	The amount of jobs that finished.
+*/
+short waitForAssemblyJob(assemblyJob* jobs, int files_amount)
+{
+	int status;/*The exit status of the child process*/
+	int i;/*Counter*/
+	short finished = 0;/*The amount of jobs that were finished after a failed wait*/
+	pid_t pid;/*The id of the child process that finished*/
+
+	while((pid = wait(&status)) < 0){
+		if(errno == EINTR)
+			continue;
+		for(i = 0; i < files_amount; i++){
+			if(jobs[i].pid > 0 && !jobs[i].finished){
+				jobs[i].finished = TRUE;
+				jobs[i].indicator = FATAL_ERROR;
+				finished++;
+			}
+		}
+		return finished;
+	}
+	for(i = 0; i < files_amount; i++){
+		if(jobs[i].pid == pid && !jobs[i].finished){
+			jobs[i].finished = TRUE;
+			/*A child process that was stopped by a signal is treated as a fatal error of its file*/
+			if(WIFEXITED(status))
+				jobs[i].cache_result = WEXITSTATUS(status) & (JOB_CACHE_HIT | JOB_CACHE_MISS);
+			if(!WIFEXITED(status) || (WEXITSTATUS(status) & ~jobs[i].cache_result) == JOB_FATAL_ERROR)
+				jobs[i].indicator = FATAL_ERROR;
+			else
+				jobs[i].indicator = ((WEXITSTATUS(status) & ~jobs[i].cache_result) == JOB_SUCCESS) ? TRUE : FALSE;
+			return 1;
+		}
+	}
+	return 1;
+}
+
+/*
+* The function: printFinishedJobs
+*
+* The function prints the output of the finished jobs, as long as all the jobs before them were already printed.
+*
+* Parameters:
+*	jobs - the jobs array.
+*	files_amount - the amount of jobs in the array.
+*	next_print - a pointer to the index of the next job that its output should be printed.
+*	indicator - a pointer to the indicator that is set to FATAL_ERROR if one of the files had a fatal error.
+*/
+void printFinishedJobs(assemblyJob* jobs, int files_amount, int* next_print, char* indicator)
+{
+	char buffer[BUFSIZ];/*A buffer for copying the output of the job*/
+	size_t length;/*The amount of characters that was read to the buffer*/
+	assemblyJob *job;/*The current job*/
+
+	while(*next_print < files_amount && jobs[*next_print].finished){
+		job = &jobs[*next_print];
+		if(!job->printed && job->output){
+			rewind(job->output);
+			while((length = fread(buffer, sizeof(char), BUFSIZ, job->output)) > 0)
+				fwrite(buffer, sizeof(char), length, stdout);
+			fclose(job->output);
+			job->output = NULL;
+		}
+		job->printed = TRUE;
+		finishJobOutput(job, files_amount-(*next_print), indicator);
+		(*next_print)++;
+	}
+	fflush(stdout);
+}
+
+/*
+* The function: finishJobOutput
+*
+* The function prints the messages that follow the output of a file, after the output of the file was printed.
+*
+* Parameters:
+*	job - a pointer to the job of the file.
+*	remain_files - the amount of files that were not printed yet, including the current file.
+*	indicator - a pointer to the indicator that is set to FATAL_ERROR if the file had a fatal error.
+*/
+void finishJobOutput(assemblyJob* job, int remain_files, char* indicator)
+{
+	if(job->indicator == FATAL_ERROR){/*Only the current file is stopped, the other files are still assembled*/
+		printf("--- Memory error, the program stopped assembling this file. ---\n");
+		*indicator = FATAL_ERROR;
+	}
+	checkIfRemainMoreFile(remain_files);
+}
+
+/********************************************************************** - END OF PARALLEL - ***********************************************************************/
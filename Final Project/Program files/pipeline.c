@@ -0,0 +1,387 @@
+#include "headers.h"
+
+/*
+* FILE: pipeline.c
+*
+* This file runs the stages of the assembler on one input file: the pre processor, the first pass and the second pass.
+* It is shared by the assembler and by the benchmark, and it collects the statistics of every file: the wall time of every
+* stage and the amounts of the lines, the macro calls, the instructions, the words, the labels, the fixups and the allocations.
+* The statistics are printed as one JSON object per file with --stats, and they are summed by the benchmark.
+*
+*/
+
+/*
+* The function: assembleFile
+*
+* The function runs all the stages of the assembler on one input file, from the pre processor to the creation of the output files.
+* All the memory that was allocated for the file is released before the function returns, so the function can be called for
+* several files one after the other, or from different processes at the same time. If the options hold a workspace (--server),
+* its tables are only emptied, and their memory is used again by the next file.
+* The statistics of the file are printed if --stats was given, and they are added to the statistics of the options if it holds any.
+*
+* Parameters:
+*	file_name - the name of the input file as received from the user (without the .as suffix).
+*	options - the options of the assembler.
+*
+* Returns:
+*	-1 (FATAL_ERROR) - if there was a memory error or a file opening error, the work on the file was stopped.
+*	0 (FALSE) - if errors were found in the input file.
+*	1 (TRUE) - if the output files were created.
+*/
+char assembleFile(char* file_name, assemblerOptions* options)
+{
+	sourceFile input_file;/*The reader of the input file, the lines of the file are used until the end of the assembly*/
+	short ic_dc_counter[2]; /*The first cell represents the number of instructions to execute in the file,
+				 *the second cell represents the number of data instructions in the file*/
+	char indicator;/*Represnt if there is errors ( -1 - fatal error
+							0 - error
+							1 - no error )*/
+	char *input_file_name = NULL;/*Represent file with the .as sufix*/
+	char *output_file_name = NULL;/*Represent file with the .am sufix*/
+	assemblerWorkspace local_workspace;/*The tables of the file, when they are not kept from file to file*/
+	assemblerWorkspace *work = options->workspace;/*The tables of the file: the arena, the name pool, the macro and symbol tables, the lines and the memory image*/
+	char keep_workspace = (options->workspace != NULL);/*TRUE if the tables are kept for the next file*/
+	assemblyStats stats = {{0}};/*The statistics of the file*/
+	double start_time = wallTime();/*The start time of the current stage*/
+	size_t heap_before;/*The heap use of the tables before the file, they are kept from earlier files with --server*/
+
+	printf("--- Start reading file: %s ---\n",file_name);
+	/*Allocate memory for the input file name*/
+	input_file_name = (char*)malloc(sizeof(char) * (strlen(file_name)+INPUT_FILE_SIZE));
+	if(!input_file_name){/*If there was an error in allocation*/
+		memoryError("input_file_name", file_name);
+		return FATAL_ERROR;
+	}
+	/*Allocate memory for the output file name*/
+	output_file_name = (char*)malloc(sizeof(char) * (strlen(file_name)+OUTPUT_FILE_SIZE));
+	if(!output_file_name){/*If there was an error in allocation*/
+		memoryError("output_file_name", file_name);
+		free(input_file_name);
+		return FATAL_ERROR;
+	}
+
+	strcpy(input_file_name, file_name);
+	strcat(input_file_name, ".as");
+	/*Opening new input(.as) file*/
+	if((indicator = sourceOpen(&input_file, input_file_name)) != TRUE){/*If there was an error opening the input file*/
+		if(indicator == FATAL_ERROR)
+			memoryError("input_file", file_name);
+		else
+			printf("--- Error: file %s does not exist. ---\n", input_file_name);
+		free(input_file_name);
+		free(output_file_name);
+		return indicator;
+	}
+
+	strcpy(output_file_name, file_name);
+	strcat(output_file_name, ".am");
+	if(!keep_workspace){
+		work = &local_workspace;
+		workspaceInit(work);
+	}
+	heap_before = workspaceHeapBytes(work);
+
+/******************************************************************* - STAGE 2: PRE-PROCESSOR - *******************************************************************/
+
+	if(!(indicator = macrosLayout(&input_file, input_file_name, &work->macros, &work->kept_lines, &work->expanded_source, &work->file_arena))){/*If there where errors in pre processor stage*/
+		if(options->emit_am)
+			printf("--- The program didn't create .am file for: %s ---\n", file_name);
+		addStageTime(&stats, PRE_PROCESSOR_STAGE, &start_time);
+		collectAssemblyStats(&stats, &input_file, work, heap_before);
+		reportAssemblyStats(file_name, &stats, FALSE, options);
+		free(output_file_name);
+		mainGeneralFree(&input_file, input_file_name, work, keep_workspace);
+		return FALSE;
+	}
+	if(indicator == FATAL_ERROR){/*If there was memory error in pre processor stage*/
+		free(output_file_name);
+		mainGeneralFree(&input_file, input_file_name, work, keep_workspace);
+		return FATAL_ERROR;
+	}
+
+	addStageTime(&stats, PRE_PROCESSOR_STAGE, &start_time);
+
+	/*Writing the .am file, only when it was asked for. The messages of the next stages refer to the lines of the .as file*/
+	if(options->emit_am && writeAmFile(output_file_name, file_name, &work->expanded_source) == FATAL_ERROR){
+		free(output_file_name);
+		mainGeneralFree(&input_file, input_file_name, work, keep_workspace);
+		return FATAL_ERROR;
+	}
+	free(output_file_name);
+
+/******************************************************************** - STAGE 3: FIRST PASS - ********************************************************************/
+
+	/*The expanded source is passed to the first pass in memory*/
+	start_time = wallTime();
+	indicator= firstPass(&work->expanded_source, input_file_name, ic_dc_counter, &work->macros, &work->image, &work->symbols, &work->file_arena);/*Set the values according if there was errors in first pass*/
+
+	/*The optimizations run on the code before the labels are resolved, their time is a part of the first pass*/
+	if(indicator == TRUE && options->optimizations)
+		indicator = optimizeCode(file_name, ic_dc_counter, &work->image, &work->symbols, options->optimizations, &work->file_arena) == FATAL_ERROR ? FATAL_ERROR : TRUE;
+
+	addStageTime(&stats, FIRST_PASS_STAGE, &start_time);
+	if(indicator == FATAL_ERROR){/*If there was memory error in first pass stage*/
+		mainGeneralFree(&input_file, input_file_name, work, keep_workspace);
+		return FATAL_ERROR;
+	}
+
+/******************************************************************** - STAGE 4: SECOND PASS - ********************************************************************/
+
+	if(!(indicator = secondPass(file_name, input_file_name, ic_dc_counter, &work->image, &work->symbols, indicator, options->emit_object, &stats)))/*If there were errors in second pass stage*/
+		printf("--- The program will not create an object file for: %s ---\n", file_name);
+	if(indicator != FATAL_ERROR){
+		collectAssemblyStats(&stats, &input_file, work, heap_before);
+		reportAssemblyStats(file_name, &stats, indicator, options);
+	}
+
+	mainGeneralFree(&input_file, input_file_name, work, keep_workspace);
+
+	return indicator;
+}
+
+/*
+* The function: workspaceInit
+*
+* The function initializes the empty tables of a file.
+*
+* Parameters:
+*	work - a pointer to the tables of the file.
+*/
+void workspaceInit(assemblerWorkspace* work)
+{
+	arenaInit(&work->file_arena);
+	namePoolInit(&work->names);
+	symbolTableInit(&work->symbols, &work->names);
+	macroTableInit(&work->macros, &work->names);
+	work->kept_lines.lines = NULL;
+	work->kept_lines.lines_amount = 0;
+	work->kept_lines.lines_size = 0;
+	work->expanded_source = work->kept_lines;
+	memoryImageInit(&work->image);
+}
+
+/*
+* The function: resetWorkspace
+*
+* The function empties the tables of a file, and keeps their memory for the next file.
+*
+* Parameters:
+*	work - a pointer to the tables of the file.
+*/
+void resetWorkspace(assemblerWorkspace* work)
+{
+	arenaReset(&work->file_arena);
+	resetNamePool(&work->names);
+	resetSymbolTable(&work->symbols);
+	macroTableInit(&work->macros, &work->names);/*The macros were allocated from the arena*/
+	work->kept_lines.lines_amount = 0;
+	work->expanded_source.lines_amount = 0;
+	resetMemoryImage(&work->image);
+}
+
+/*
+* The function: freeWorkspace
+*
+* The function releases all the memory of the tables of a file.
+*
+* Parameters:
+*	work - a pointer to the tables of the file.
+*/
+void freeWorkspace(assemblerWorkspace* work)
+{
+	freeSourceLines(&work->kept_lines);
+	freeSourceLines(&work->expanded_source);
+	freeSymbolTable(&work->symbols);
+	freeNamePool(&work->names);
+	freeMemoryImage(&work->image);
+	arenaFree(&work->file_arena);
+}
+
+/*
+* The function: wallTime
+*
+* The function returns the time of a monotonic clock, for measuring the wall time of the stages.
+*
+* Returns:
+*	The time in seconds.
+*/
+double wallTime(void)
+{
+	struct timespec now;/*The current time of the clock*/
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/*
+* The function: addStageTime
+*
+* The function adds the time that passed since the start of a stage to the time of the stage, and starts the next stage.
+*
+* Parameters:
+*	stats - a pointer to the statistics of the file, nothing is done if it is NULL.
+*	stage - the stage that ended.
+*	start_time - a pointer to the start time of the stage, it is set to the current time.
+*/
+void addStageTime(assemblyStats* stats, short stage, double* start_time)
+{
+	double now;/*The end time of the stage*/
+
+	if(!stats)
+		return;
+	now = wallTime();
+	stats->seconds[stage] += now - *start_time;
+	*start_time = now;
+}
+
+/*
+* The function: collectAssemblyStats
+*
+* The function reads the amounts of the statistics from the structures of the file, before they are released.
+* The arrays and the arena of the file only grow until the end of the file, so their growth during the file is its peak heap use.
+* With --server the tables keep their size from the earlier files, so only what the file added to them is counted.
+*
+* Parameters:
+*	stats - a pointer to the statistics of the file.
+*	input_file - a pointer to the reader of the input file.
+*	work - a pointer to the tables of the file.
+*	heap_before - the heap use of the tables before the file (see workspaceHeapBytes).
+*/
+void collectAssemblyStats(assemblyStats* stats, sourceFile* input_file, assemblerWorkspace* work, size_t heap_before)
+{
+	size_t heap_bytes = workspaceHeapBytes(work) - heap_before;/*The bytes that the file added to the arena and to the arrays*/
+
+	stats->lines_amount = input_file->lines_amount;
+	stats->macros_expanded = work->macros.calls_amount;
+	stats->instructions_amount = work->image.instructions_amount;
+	stats->code_words = work->image.code.words_amount;
+	stats->data_words = work->image.data.words_amount;
+	stats->labels_amount = work->symbols.symbols_amount;
+	stats->fixups_amount = work->image.fixups_amount;
+	stats->allocations_amount = work->file_arena.allocations_amount;
+
+	if(!input_file->is_mapped)
+		heap_bytes += input_file->length;
+	stats->heap_bytes = (long)heap_bytes;
+}
+
+/*
+* The function: workspaceHeapBytes
+*
+* The function calculates the heap use of the tables of a file: the blocks of the arena and the allocated size of the arrays.
+*
+* Parameters:
+*	work - a pointer to the tables of the file.
+*
+* Returns:
+*	The amount of bytes.
+*/
+size_t workspaceHeapBytes(assemblerWorkspace* work)
+{
+	size_t heap_bytes = work->file_arena.blocks_bytes;/*The bytes of the arena and of the arrays*/
+
+	heap_bytes += sizeof(lineView) * (work->kept_lines.lines_size + work->expanded_source.lines_size);
+	heap_bytes += sizeof(char*) * work->names.names_size + sizeof(int) * work->names.slots_size;
+	heap_bytes += sizeof(symbol) * work->symbols.symbols_size + sizeof(int) * (work->symbols.by_name_size + work->symbols.entries_size);
+	heap_bytes += sizeof(short) * (work->image.code.words_size + work->image.data.words_size) + sizeof(fixup) * work->image.fixups_size;
+	return heap_bytes;
+}
+
+/*
+* The function: reportAssemblyStats
+*
+* The function prints the statistics of the file if --stats was given, and adds them to the statistics of the options.
+*
+* Parameters:
+*	file_name - the name of the input file as received from the user.
+*	stats - a pointer to the statistics of the file.
+*	indicator - TRUE if the output files were created, FALSE if errors were found in the file.
+*	options - the options of the assembler.
+*/
+void reportAssemblyStats(char* file_name, assemblyStats* stats, char indicator, assemblerOptions* options)
+{
+	if(options->print_stats)
+		printAssemblyStats(file_name, stats, indicator, FALSE);
+	if(options->stats)
+		addAssemblyStats(options->stats, stats);
+}
+
+/*
+* The function: addAssemblyStats
+*
+* The function adds the statistics of one file to the statistics of several files, the heap use is the largest of the files.
+*
+* Parameters:
+*	total - a pointer to the statistics of several files.
+*	stats - a pointer to the statistics of the file.
+*/
+void addAssemblyStats(assemblyStats* total, assemblyStats* stats)
+{
+	int i;/*Counter*/
+
+	for(i = 0; i < STAGES_AMOUNT; i++)
+		total->seconds[i] += stats->seconds[i];
+	total->lines_amount += stats->lines_amount;
+	total->macros_expanded += stats->macros_expanded;
+	total->instructions_amount += stats->instructions_amount;
+	total->code_words += stats->code_words;
+	total->data_words += stats->data_words;
+	total->labels_amount += stats->labels_amount;
+	total->fixups_amount += stats->fixups_amount;
+	total->allocations_amount += stats->allocations_amount;
+	if(stats->heap_bytes > total->heap_bytes)
+		total->heap_bytes = stats->heap_bytes;
+}
+
+/*
+* The function: printAssemblyStats
+*
+* The function prints the statistics of the file as one JSON object in a single line, for example:
+* {"file":"ps","result":"ok","cached":false,"seconds":{"pre_processor":0.000021,...},"lines":31,...}
+* A file that was restored from the build cache has the same keys, with "cached":true and zero amounts.
+*
+* Parameters:
+*	file_name - the name of the input file as received from the user.
+*	stats - a pointer to the statistics of the file.
+*	indicator - TRUE if the output files were created, FALSE if errors were found in the file.
+*	cached - TRUE if the file was restored from the build cache.
+*/
+void printAssemblyStats(char* file_name, assemblyStats* stats, char indicator, char cached)
+{
+	char *stages_names[STAGES_AMOUNT] = {"pre_processor", "first_pass", "second_pass", "output"};/*The names of the stages*/
+	int i;/*Counter*/
+
+	printf("{\"file\":");
+	printJsonString(file_name);
+	printf(",\"result\":\"%s\",\"cached\":%s,\"seconds\":{", indicator ? "ok" : "errors", cached ? "true" : "false");
+	for(i = 0; i < STAGES_AMOUNT; i++)
+		printf("%s\"%s\":%.9f", i ? "," : "", stages_names[i], stats->seconds[i]);
+	printf("},\"lines\":%ld,\"macros_expanded\":%ld,\"instructions\":%ld,\"code_words\":%ld,\"data_words\":%ld",
+		stats->lines_amount, stats->macros_expanded, stats->instructions_amount, stats->code_words, stats->data_words);
+	printf(",\"labels\":%ld,\"fixups\":%ld,\"allocations\":%ld,\"peak_heap_bytes\":%ld}\n",
+		stats->labels_amount, stats->fixups_amount, stats->allocations_amount, stats->heap_bytes);
+}
+
+/*
+* The function: printJsonString
+*
+* The function prints a string as a JSON string, with the quotes, the backslashes and the control characters escaped.
+*
+* Parameters:
+*	str - the string.
+*/
+void printJsonString(char* str)
+{
+	putchar('"');
+	for(; *str; str++){
+		if(*str == '"' || *str == '\\')
+			printf("\\%c", *str);
+		else if((unsigned char)*str < ' ')
+			printf("\\u%04x", (unsigned char)*str);
+		else
+			putchar(*str);
+	}
+	putchar('"');
+}
+
+/********************************************************************** - END OF PIPELINE - **********************************************************************/
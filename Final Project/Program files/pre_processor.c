@@ -3,38 +3,52 @@
 /*
 * The function: macrosLayout
 *
-* The main function for managing the processes of finding macros declarations and printing the macros commands to the output file in the appropriate place.
+* The main function for managing the processes of finding macros declarations and adding the macros commands to the expanded source in the appropriate place.
+* The input file is read only once: the macros are collected and the other lines are kept in memory during the same scan,
+* and then the lines are expanded from memory, so a macro may still be used before the line where it is defined.
+* The expanded source is kept in memory and is passed straight to the first pass, it is written to the .am file only when asked to.
 * 
 * Parameters:
-*	input_file - a pointer to a FILE that is open for reading.
+*	input_file - a pointer to the reader of the input file.
 *	input_file_name - The name of the file that is open for reading with the suffix.
-*	output_file_name - The name of the file that will be opened for writing the content of the macros.
-*	file_name - The name of the file as received from the user.
-*	macros_list - The head of the linked list that will hold the contents of the macros.
+*	macros - The macro table that will hold the contents of the macros.
+*	source_lines - The lines of the input file that are kept during the scan (not comments, empty lines or macros definitions).
+*	expanded_source - The lines of the source after the macros were spread.
+*	file_arena - The arena of the file, the macros are allocated from it.
 *
 * Returns:
 *	TRUE - if the process finished and no errors were detected.
 *	FALSE - if an error is detected.
 *	FATAL_ERROR - If a memory error occurred.  
 */
-char macrosLayout(FILE* input_file, char* input_file_name, char* output_file_name, char* file_name, macroNode** macros_list)
+char macrosLayout(sourceFile* input_file, char* input_file_name,macroTable* macros, sourceLines* source_lines, sourceLines* expanded_source, arena* file_arena)
 {			
-	FILE *output_file; /* A pointer to a the file that will be opened for writing. */
-	char line[MAX_LENGTH_OF_LINE]; /* An array to receive a line from the input file. */
-	macroNode *new_macro = NULL; /* A pointer that will hold the last macro found each time. */
+	char line[MAX_LENGTH_OF_LINE]; /* An array to receive a copy of a line from the input file, for checking it. */
+	lineView view; /* The current line in the input file. */
+	char indicator;/* The result of reading a macro definition. */
 	char error_str[150] = { '\0' }; /* An array that stores the cause of the error that was found. */
 	unsigned int line_num = 1; /* A variable to count the line number in the input file. */
+	sourceLines temp_lines; /* Used for swapping the kept lines and the expanded source. */
+	int i; /* Counter. */
 									
 	/* Scaning the file line by line until eof reached. */
-	while(fgets(line, MAX_LENGTH_OF_LINE, input_file)){
+	while(sourceNextLine(input_file, &view)){
+		viewToLine(view, line);
 		if(isValidLine(line, error_str)){ /* Checking that the line is not too long and that no additional characters appear before the sign: ';'. */																	
 			if(isStartMacroDeclaration(line, error_str) == TRUE){ /* Detecting the existence of starting a macro definition. */
-				new_macro = readNewMacro(line, &line_num, input_file, new_macro, macros_list, error_str); /* Creating a new node for the macro. */
-				if(!new_macro){ /* Checking that all memory allocations were successful. */
+				indicator = readNewMacro(line, &line_num, input_file, macros, file_arena, error_str); /* Creating a new node for the macro. */
+				if(indicator == FATAL_ERROR){ /* Checking that all memory allocations were successful. */
 					memoryError(error_str, input_file_name);
 					return FATAL_ERROR; 				
 				}
 			}
+			else if(!error_str[0] && line[0] != ';' && !isWhiteSpaceString(line)){ /* Keeping the line, skipping comment lines and empty lines. */
+				skipViewWhiteChar(&view); /* The line is kept as a view to the input file, without the white characters at its beginning. */
+				if(!addSourceLine(source_lines, view, error_str)){
+					memoryError(error_str, input_file_name);
+					return FATAL_ERROR;
+				}
+			}
 		}
 		if(error_str[0]){ /* If an error is found, the reason for the error is printed appropriately. */
 			generalError(input_file_name, line_num, error_str);
@@ -43,26 +57,22 @@ char macrosLayout(FILE* input_file, char* input_file_name, char* output_file_nam
 		line_num++; /* Increase the line counter by oneIncrease the row counter by one. */
 	}
 	
-	rewind(input_file);		
-	if(!(output_file = fopen(output_file_name, "w"))){ /* Opening a new file to write the contents of the macros. */
-		newFileOpenError(output_file_name, file_name); /* Checking that the file was opened successfully. */
-		return FATAL_ERROR;
+	if(!macros->macros_amount){ /* If there are no macros, the lines are already the expanded source. */
+		temp_lines = *expanded_source; /* The arrays are swapped, so both are kept for the next file. */
+		*expanded_source = *source_lines;
+		*source_lines = temp_lines;
+		return TRUE;
 	}
-	/* A second scan of the input file and searching for mentions of macro names. */
-	while(fgets(line, MAX_LENGTH_OF_LINE, input_file)){
-		if(line[0] != ';' && !isWhiteSpaceString(line)){ /* Skipping comment lines and empty lines. */
-			skipWhiteChar(line); /* Skip white characters at the beginning of the line. */
-			/* Skipping macro definition lines. */
-			if(isStartMacroDeclaration(line, error_str)){ 
-				while(!isEndMacroDeclaration(line, error_str))
-					fgets(line, MAX_LENGTH_OF_LINE, input_file);							
-				continue;
-			}
-			printLineToFile(output_file, line, *macros_list); /* Detects if there is a mention of a macro name and prints the appropriate lines. */
+	
+	/* Searching the kept lines for mentions of macro names. */
+	for(i = 0; i < source_lines->lines_amount; i++){
+		/* Detects if there is a mention of a macro name and adds the appropriate lines. */
+		if(!addLineToSource(expanded_source, source_lines->lines[i], macros, error_str)){
+			memoryError(error_str, input_file_name);
+			return FATAL_ERROR;
 		}
 	}
 
-	fclose(output_file); /* closing the output file. */		
 	return TRUE;
 }
 
@@ -70,84 +80,71 @@ char macrosLayout(FILE* input_file, char* input_file_name, char* output_file_nam
 * The function: readNewMacro
 *
 * The main function for managing the processes of identifying the data of the macro, checking their correctness, 
-* creating a new macroNode and concatenation of the new node into the linked list.
+* creating a new macroNode and inserting the new node into the macro table.
 * 
 * Parameters:
 *	line - a pointer to a string that holds the current line read from the input file.
 *	line_num - The line number counter.
-*	input_file - a pointer to a FILE that is opened for reading.
-*	curr_macro - The pointer to the current last node of the linked list of macros.
-*	macros_list - a pointer to the head of the linked list.
+*	input_file - a pointer to the reader of the input file.
+*	macros - a pointer to the macro table.
+*	file_arena - a pointer to the arena that the new macro is allocated from.
 *	error_str - A pointer to a string, so that if an error is found, it will store the reason for the error.
 *
 * Returns:
-*	A pointer to the new macroNode, or NULL if an error occurs during the process.  
+*	TRUE if the macro was added to the macro table.
+*	FALSE if an error was found in the macro definition.
+*	FATAL_ERROR if a memory allocation failure occurred.  
 */
-macroNode* readNewMacro(char* line, unsigned int* line_num, FILE* input_file, macroNode* curr_macro, macroNode** macros_list, char* error_str)
+char readNewMacro(char* line, unsigned int* line_num, sourceFile* input_file,macroTable* macros, arena* file_arena, char* error_str)
 {	
 	macroNode *new_macro = NULL; /* A pointer to the new node where the data will be inserted. */
 	char indicator;
 	
-	new_macro = creatMacroNode(error_str); /* Allocate memory to the new node. */
+	new_macro = creatMacroNode(file_arena, error_str); /* Allocate memory to the new node. */
 	if(!new_macro) /* Check that the memory allocation was successful. */				
-		return NULL;
+		return FATAL_ERROR;
 	/* Identifying the data from the input file, and inserting it into the new macro node. */
-	indicator = getMacroData(line, line_num, input_file, new_macro, *macros_list, error_str);
-	if(indicator == FATAL_ERROR)		
-		return NULL;
-	
-	if(!indicator && curr_macro)
-		return curr_macro;
+	indicator = getMacroData(line, line_num, input_file, new_macro, macros, file_arena, error_str);
+	if(indicator != TRUE)		
+		return indicator;
 	
-	if(!(*macros_list)) /* Setting the head of the linked list if not already set. */
-		*macros_list = new_macro;
-		
-	if(curr_macro)
-		curr_macro->next = new_macro; /* Appending the new node to the end of the linked list. */
-
-	curr_macro = new_macro; /* Update of the last node in the linked list. */
+	if(!addMacro(macros, new_macro, file_arena, error_str)) /* Inserting the new node into the macro table. */
+		return FATAL_ERROR;
 	
-	return new_macro;
+	return TRUE;
 }
 
 /*
 * The function: creatMacroNode
 *
-* The function Allocates and initializes a new macroNode structure..
+* The function Allocates and initializes a new macroNode structure from the arena of the file.
 * 
 * Parameters:
+*	file_arena - A pointer to the arena that the new node is allocated from.
 *	error_str - A pointer to a string to store the name of the variable for which the memory allocation failed.
 *
 * Returns:
 *	A pointer to the new macroNode, or NULL if a memory allocation failure occurred.  
 */
-macroNode* creatMacroNode(char* error_str)
+macroNode* creatMacroNode(arena* file_arena, char* error_str)
 {	
 	macroNode *new_macro; /* A pointer for the new macro node. */
 	
 	/* Allocate memory for the macroNode structure. */
-	new_macro = (macroNode*)malloc(sizeof(macroNode));
+	new_macro = (macroNode*)arenaAlloc(file_arena, sizeof(macroNode));
 	if(!new_macro){ /* Check that the memory allocation was successful. */
 		strcpy(error_str, "new macroNode");
 		return NULL;
 	}
-	/* Allocate memory for the macro name. */		
-	new_macro->name = (char*)malloc(sizeof(char) * MAX_LENGTH_OF_LINE);
-	if(!new_macro->name){
-		free(new_macro); 
-		strcpy(error_str, "new macroNode->name");
-		return NULL;
-	}
-	/* Allocate memory for the commands array. */		
-	new_macro->commands = (char**)malloc(sizeof(char*) * BUFFER);
+	/* Allocate memory for the commands array. */
+	new_macro->commands = (lineView*)arenaAlloc(file_arena, sizeof(lineView) * BUFFER);
 	if(!new_macro->commands){
-		free(new_macro);
-		free(new_macro->name);
 		strcpy(error_str, "new macroNode->commands");
 		return NULL;
 	}			
-	new_macro->next = NULL; /* Initialize the next node to NULL. */
-	
+	new_macro->name = NULL; /* The name is taken from the name pool when it is read from the line. */
+	new_macro->commands_amount = 0;
+
 	return new_macro;	
 }
 
@@ -159,9 +156,10 @@ macroNode* creatMacroNode(char* error_str)
 * Parameters:
 *   line - A pointer to the current line from the input file.
 *   line_num - The line number counter.
-*   input_file - A pointer to the file being read.
+*   input_file - A pointer to the reader of the input file.
 *   new_macro - A pointer to the macroNode where the data will be stored.
-*   macros_list - A pointer to the head of the linked list of macros.
+*   macros - A pointer to the macro table.
+*   file_arena - A pointer to the arena that the name and the commands of the macro are allocated from.
 *   error_str - A pointer to a string to store error messages if validation fails.
 *
 * Returns:
@@ -169,33 +167,38 @@ macroNode* creatMacroNode(char* error_str)
 *   FALSE if an error was found in one of the data.
 *	FATAL_ERROR if a memory allocation failure occurred. 
 */
-char getMacroData(char* line, unsigned int* line_num, FILE* input_file, macroNode* new_macro, macroNode* macros_list, char* error_str)
+char getMacroData(char* line, unsigned int* line_num, sourceFile* input_file,macroNode* new_macro, macroTable* macros, arena* file_arena, char* error_str)
 {	
 	char tmp_error_str[ERROR_MESSAGE_SIZE];
-	
+	char macro_name[MAX_LENGTH_OF_LABEL]; /* The name of the macro, before it is stored in the name pool. */
+	int id; /* The id of the macro name in the name pool. */
+	lineView view; /* The current line of the macro definition in the input file. */
+
 	/* Skip the word 'macr' and extract the macro name. */
 	skipWord(line);	
-	if(!getMacroName(line, new_macro->name, error_str))
+	if(!getMacroName(line, macro_name, error_str))
 		return FALSE; 
 	/* Checks that the macro name is not a keyword. */	
-	if(!isValidName(new_macro->name, tmp_error_str)){
+	if(!isValidName(macro_name, tmp_error_str)){
 		strcpy(error_str, "Invalid macro name, ");
 		strcat(error_str, tmp_error_str);
 		return FALSE;
 	}
 	/* Checks that the macro name has not already been previously defined in the current file. */
-	if(isMacroNameExists(new_macro->name, macros_list)){
+	if(findMacro(macros, macro_name)){
 		strcpy(error_str, "The macro name has already been defined in the current file.");
 		return FALSE;
 	}
-	
-	fgets(line, MAX_LENGTH_OF_LINE, input_file); /* Advance the input file pointer to the next line. */
-	(*line_num)++;
-	if(!isValidLine(line, error_str))
-		return FALSE;	
-	
+	if((id = internName(macros->names, macro_name, file_arena, error_str)) == NO_NAME)
+		return FATAL_ERROR;
+	new_macro->name = macros->names->names[id];
+
+	/* Advance to the next line. */
+	if(!readMacroLine(input_file, &view, line, line_num, error_str))
+		return FALSE;
+
 	/*Extracts the commands in the macro content, and store them in the new macro node. */
-	return getCommands(line, input_file, line_num, new_macro, error_str);
+	return getCommands(line, &view, input_file, line_num, new_macro, file_arena, error_str);
 }
 
 /*
@@ -240,67 +243,84 @@ char getMacroName(char* line, char* macro_name, char* error_str)
 *
 * The function extracts the command lines from the input file, stores them in the new macro node,
 * and verifies the correctness of the end line of the macro definition.
-* 
+* The commands are stored as views to the input file, they are not copied.
+*
 * Parameters:
-*	line - A pointer to the current line from the input file.
-*   input_file - A pointer to the file being read.
+*	line - A pointer to a copy of the current line from the input file.
+*   view - A pointer to the view of the current line in the input file.
+*   input_file - A pointer to the reader of the input file.
 *   line_num - The line number counter.
 *   new_macro - A pointer to the macroNode where the commands will be stored.
+*   file_arena - A pointer to the arena that the commands array is allocated from.
 *   error_str - A pointer to a string to store error messages if an error occurs.
 *
 * Returns:
 *   TRUE if the commands were extracted successfully.
 *   FALSE if a validation error occurs.
-*   FATAL_ERROR if a memory allocation failure occurred.  
+*   FATAL_ERROR if a memory allocation failure occurred.
 */
-char getCommands(char* line, FILE* input_file, unsigned int* line_num, macroNode* new_macro, char* error_str)
-{	
+char getCommands(char* line, lineView* view, sourceFile* input_file, unsigned int* line_num, macroNode* new_macro, arena* file_arena, char* error_str)
+{
 	int i = 0, buffer = BUFFER;
-	char **temp_commands;
-	
+	lineView *temp_commands;
+
 	/* Loop to read and store commands until the end of the macro definition is detected. */
 	while(!isEndMacroDeclaration(line, error_str)){
-		/* Reallocate memory if necessary. */
+		/* Move the commands to a bigger array if necessary, the arena does not reallocate so the array is doubled. */
 		if(i >= buffer){
-			buffer += BUFFER;
-			temp_commands = (char**)realloc(new_macro->commands, sizeof(char*) * buffer);
+			buffer *= 2;
+			temp_commands = (lineView*)arenaAlloc(file_arena, sizeof(lineView) * buffer);
 			if(!temp_commands){
 				strcpy(error_str, "reallocate macroNode->commands");
-				freeMacrosList(new_macro);
-				return FATAL_ERROR;			
+				return FATAL_ERROR;
 			}
+			memcpy(temp_commands, new_macro->commands, sizeof(lineView) * i);
 			new_macro->commands = temp_commands;
 		}
-		/* Allocate memory for the current command. */
-		new_macro->commands[i] = (char*)malloc(sizeof(char) * MAX_LENGTH_OF_LINE);
-		if(!(new_macro->commands[i])){
-			sprintf(error_str, "new macroNode->commands[%d]", i);
-			freeMacrosList(new_macro);
-			return FATAL_ERROR;			
-		}					
-		strcpy(new_macro->commands[i++], line); /* Storing the current command into the commands array of the new macro node. */
-		
+		/* Storing the current command into the commands array of the new macro node. */
+		new_macro->commands[i++] = *view;
+
 		/* Read the next line from the input file and validate it. */
-		fgets(line, MAX_LENGTH_OF_LINE, input_file); 
-		(*line_num)++;
-		if(!isValidLine(line, error_str))
-			return FALSE;		
+		if(!readMacroLine(input_file, view, line, line_num, error_str))
+			return FALSE;
 	}
 	/* Checking that the end line of the macro definition is correct. */
 	if(isEndMacroDeclaration(line, error_str) < 0)
 		return FALSE;
-	
-	/* Adjust memory allocation to fit the actual number of commands and one more cell to mark the end of the array. */		
-	temp_commands = (char**)realloc(new_macro->commands, sizeof(char*) * (i + 1));
-	if(!temp_commands){
-		strcpy(error_str, "reallocate macroNode->commands");
-		freeMacrosList(new_macro);
-		return FATAL_ERROR;	
+
+	new_macro->commands_amount = i;
+
+	return TRUE;
+}
+
+/*
+* The function: readMacroLine
+*
+* The function reads the next line of a macro definition from the input file and checks that the line is correct.
+*
+* Parameters:
+*	input_file - A pointer to the reader of the input file.
+*   view - A pointer to the view that receives the line, without the white characters at its beginning.
+*   line - A pointer to the buffer that receives a copy of the line, for checking it.
+*   line_num - The line number counter.
+*   error_str - A pointer to a string to store error messages if an error occurs.
+*
+* Returns:
+*   TRUE if the line was read and no errors were found.
+*   FALSE if the file ended before the end of the macro definition, or if an error was found in the line.
+*/
+char readMacroLine(sourceFile* input_file, lineView* view, char* line, unsigned int* line_num, char* error_str)
+{
+	if(!sourceNextLine(input_file, view)){
+		strcpy(error_str, "The file ended before the end of the macro declaration.");
+		return FALSE;
 	}
-	new_macro->commands = temp_commands;			
-	new_macro->commands[i] = NULL;
-	
-	return TRUE;		
+	(*line_num)++;
+	viewToLine(*view, line);
+	if(!isValidLine(line, error_str))
+		return FALSE;
+	skipViewWhiteChar(view);
+	return TRUE;
 }
 
 /*
@@ -410,112 +430,146 @@ char isValidLine(char* line, char* error_str)
 }
 
 /*
-* The function: isMacroNameExists
+* The function: addLineToSource
 *
-* The function searches the linked list of macros for a macro with the given variable name.
+* The function manages the adding of a line to the expanded source, 
+* If the line starts with a macro name it adds the corresponding macro's commands instead of the line.
 * 
 * Parameters:
-*	variable_name - A pointer to the string containing a name of variable to search for.
-*   macros_list - A pointer to the head of the linked list of macros.
+*	expanded_source - A pointer to the lines of the expanded source.
+*   line - The view of the line to be added, the line is not copied.
+*   macros - A pointer to the macro table.
+*   error_str - A pointer to a string to store the name of the variable for which the memory allocation failed.
 *
 * Returns:
-*	A pointer to the macroNode if the macro name exists in the list.
-*   NULL if the name is not found. 
+*	TRUE if the line was added.
+*	FALSE if a memory allocation failure occurred.
 */
-macroNode* isMacroNameExists(char* variable_name, macroNode* macros_list)
+char addLineToSource(sourceLines* expanded_source, lineView line, macroTable* macros, char* error_str)
 {
-	macroNode* temp_node = macros_list;
+	macroNode *temp_node;
+	char macro_name[MAX_LENGTH_OF_LINE];
+	short i = 0;
+
+	/* Extract the first word from the line, assuming it could be a macro name. */
+	while(i < (short)line.length && !isspace((unsigned char)line.start[i]) && line.start[i]){
+		macro_name[i] = line.start[i];
+		i++;
+	}
+	macro_name[i] = '\0';
+	
+	/* Check if the word is a macro name and add the lines accordingly. */
+	temp_node = findMacro(macros, macro_name);					
+	if(temp_node){
+		macros->calls_amount++;
+		return addMacroCommands(temp_node, expanded_source, error_str);
+	}
 	
-	/* Iterate through the linked list to find the macro name. */
-	while(temp_node){
-		/* Compare the current node's name with the given variable name. */
-		if(!strcmp(variable_name, temp_node->name))
-			return temp_node;
-		/* Move to the next node in the list. */			
-		temp_node = temp_node->next;
-	}	
-	return NULL;
+	return addSourceLine(expanded_source, line, error_str);
 }
 
 /*
-* The function: printLineToFile
+* The function: addMacroCommands
 *
-* The function manages the printing process to the output file, 
-* If the line starts with a macro name it prints the corresponding macro's commands instead of the line.
+* The function adds the commands of the specified macro to the expanded source.
+* The commands are views to the input file, so only the views are added.
 * 
 * Parameters:
-*	output_file - A pointer to the FILE where the line or macro commands will be written.
-*   line - A pointer to the string containing the line to be printed.
-*   macros_list - A pointer to the head of the linked list of macros.	  
+*	macro - A pointer to the macroNode containing the commands to be added.
+*   expanded_source - A pointer to the lines of the expanded source.
+*   error_str - A pointer to a string to store the name of the variable for which the memory allocation failed.
+*
+* Returns:
+*	TRUE if the commands were added.
+*	FALSE if a memory allocation failure occurred.
 */
-void printLineToFile(FILE* output_file, char* line, macroNode* macros_list)
-{
-	macroNode *temp_node;
-	char macro_name[MAX_LENGTH_OF_LINE];
-	short i = 0;
-	
-	/* Extract the first word from the line, assuming it could be a macro name. */
-	while(!isspace(line[i]) && line[i] != '\n' && line[i]){
-		macro_name[i] = line[i];
-		i++;	
+char addMacroCommands(macroNode* macro, sourceLines* expanded_source, char* error_str)
+{	
+	int i;
+
+	/* Adds the commands of the macro to the expanded source. */
+	for(i = 0; i < macro->commands_amount; i++){
+		if(!addSourceLine(expanded_source, macro->commands[i], error_str))
+			return FALSE;
 	}
-	macro_name[i] = '\0';
-	
-	/* Check if the word is a macro name and print accordingly. */
-	temp_node = isMacroNameExists(macro_name, macros_list);					
-	if(!temp_node)
-		fputs(line, output_file);				
-	else
-		printMacroCommands(temp_node, output_file);	
+	return TRUE;
 }
 
 /*
-* The function: printMacroCommands
+* The function: addSourceLine
 *
-* The function writes the commands of the specified macro to the output file.
+* The function appends a line to the end of the expanded source, and enlarges the lines array when it is full.
 * 
 * Parameters:
-*	macro - A pointer to the macroNode containing the commands to be printed.
-*   output_file - A pointer to the FILE where the commands will be written.	  
+*	expanded_source - A pointer to the lines of the expanded source.
+*   line - The view of the line to append, the line itself is not copied.
+*   error_str - A pointer to a string to store the name of the variable for which the memory allocation failed.
+*
+* Returns:
+*	TRUE if the line was appended.
+*	FALSE if a memory allocation failure occurred.
 */
-void printMacroCommands(macroNode* macro, FILE* output_file)
-{	
-	int i = 0;
+char addSourceLine(sourceLines* expanded_source, lineView line, char* error_str)
+{
+	lineView *temp_lines;
 	
-	/* Prints the commands of the macro to the output file. */
-	while(macro->commands[i]){
-		fputs(macro->commands[i], output_file);
-		i++;
-	}		
+	if(expanded_source->lines_amount == expanded_source->lines_size){
+		expanded_source->lines_size = expanded_source->lines_size ? expanded_source->lines_size*2 : SOURCE_LINES_SIZE;
+		temp_lines = (lineView*)realloc(expanded_source->lines, sizeof(lineView) * expanded_source->lines_size);
+		if(!temp_lines){
+			strcpy(error_str, "expanded source lines");
+			return FALSE;
+		}
+		expanded_source->lines = temp_lines;
+	}
+	expanded_source->lines[expanded_source->lines_amount++] = line;
+	return TRUE;
 }
 
 /*
-* The function: freeMacrosList
+* The function: writeAmFile
 *
-* The function Frees all memory allocated for a linked list of macroNode structures, including each macro's name and commands.
+* The function writes the expanded source to the .am file (when the option --emit-am is used).
 * 
 * Parameters:
-*	macros_list - A pointer to the head of the linked list of macros to be freed.  
+*	output_file_name - The name of the .am file.
+*	file_name - The name of the file as received from the user.
+*   expanded_source - A pointer to the lines of the expanded source.
+*
+* Returns:
+*	TRUE if the file was written.
+*	FATAL_ERROR if the file could not be opened.
 */
-void freeMacrosList(macroNode* macros_list)
+char writeAmFile(char* output_file_name, char* file_name, sourceLines* expanded_source)
 {
+	FILE *output_file; /* A pointer to a the file that will be opened for writing. */
 	int i;
-	macroNode* temp;
 	
-	/* Iterate through the linked list, freeing memory for each macroNode. */			
-	while(macros_list){
-		i = 0;				
-		free(macros_list->name);/* Free the memory allocated for the macro's name. */
-		
-		/* Free the memory allocated for each command in the macro. */		
-		while(macros_list->commands[i])
-			free(macros_list->commands[i++]);
-			
-		free(macros_list->commands);/* Free the memory allocated for the commands array. */		
-		temp = macros_list->next; /* Move to the next node in the list. */
-		free(macros_list); /* Free the current macroNode. */
-		macros_list = temp; /* Update the head of the list. */
+	if(!(output_file = fopen(output_file_name, "w"))){ /* Opening a new file to write the expanded source. */
+		newFileOpenError(output_file_name, file_name); /* Checking that the file was opened successfully. */
+		return FATAL_ERROR;
 	}
+	for(i = 0; i < expanded_source->lines_amount; i++)
+		fwrite(expanded_source->lines[i].start, sizeof(char), expanded_source->lines[i].length, output_file);
+	
+	fclose(output_file); /* closing the output file. */
+	return TRUE;
+}
+
+/*
+* The function: freeSourceLines
+*
+* The function releases the lines array of the expanded source (the lines themselves belong to the input file).
+* 
+* Parameters:
+*	expanded_source - A pointer to the lines of the expanded source.
+*/
+void freeSourceLines(sourceLines* expanded_source)
+{
+	free(expanded_source->lines);
+	expanded_source->lines = NULL;
+	expanded_source->lines_amount = 0;
+	expanded_source->lines_size = 0;
 }
 
 /******************************End of pre_processor**********************************************/
@@ -9,12 +9,13 @@
 * 
 * Parameters:
 *	files_name - the name of the output files without the suffix.
-*	error_file_name - the name of the input file with the suffix .am.
+*	error_file_name - the name of the input file with the suffix .as.
 *	ic_dc_counter - contain the amount of ic(cell 0) and dc(cell 1) from first pass.
-*	instructions_list - a list of instructionNode.	 
-*	data_list - a pointer to list of dataNode.	
-*	declarations_list - a pointer to list of declarationNode.
+*	image - a pointer to the memory image of the file (the code and data words, and the fixups of the labels).
+*	symbols - a pointer to the symbol table.
 *	indicator - present if there was an error(value 0) or no-error(value 1) in first pass.
+*	emit_object - TRUE if the binary object file (.obj) should be created too.
+*	stats - a pointer to the statistics of the file, the time of the second pass and of the output files is added to it.
 *
 * Returns:
 * 	-1 (FATAL_ERROR) - if there was fatal error(memory/files opening).
@@ -22,110 +23,77 @@
 *	1 (TRUE) - if successfully completed second pass.
 *  
 */
-char secondPass(char* files_name, char* error_file_name, short* ic_dc_counter, instructionNode** instructions_list, dataNode* data_list, declarationNode* declarations_list, char indicator)
+char secondPass(char* files_name, char* error_file_name, short* ic_dc_counter, memoryImage* image, symbolTable* symbols, char indicator, char emit_object, assemblyStats* stats)
 {
 	short ent_is_length[2] = {FALSE,0};/*If there is at least 1 entry(cell 0).The length of longest entry(cell 1)*/
 	short ext_is_length[2] = {FALSE,0};/*If there is at least 1 extern(cell 0).The length of longest extern(cell 1)*/
+	double start_time = wallTime();/*The start time of the current stage*/
 	
-	if(!isEntriesDefined(error_file_name, declarations_list))/*If the function return FALSE(which mean that there is an error) */
+	if(!isEntriesDefined(error_file_name, symbols, ent_is_length))/*If the function return FALSE(which mean that there is an error) */
 		indicator = FALSE;
 
-    	if(!fillingMissingBMCofLabel(error_file_name, instructions_list, declarations_list, ent_is_length, ext_is_length))/*If the function return FALSE(which mean that there is an error) */
+    	if(!fillingMissingBMCofLabel(error_file_name, image, symbols, ext_is_length))/*If the function return FALSE(which mean that there is an error) */
     		indicator = FALSE;
+	addStageTime(stats, SECOND_PASS_STAGE, &start_time);
     		
 	if(indicator)/*If there were no errors in second pass or in first pass*/
 	{	
-		if( FATAL_ERROR == createObAndExtFiles(files_name, ic_dc_counter, instructions_list, data_list, ext_is_length) )/*If there is memory error in the function*/
+		if( FATAL_ERROR == createObAndExtFiles(files_name, ic_dc_counter, image, symbols, ext_is_length))/*If there is memory error in the function*/
 		 	return FATAL_ERROR;
 	 	
-		if(ent_is_length[0] && FATAL_ERROR == createEntFile(files_name, declarations_list, ent_is_length))/*If there is an entry label in the input file and there is memory error in the function*/
+		if(ent_is_length[0] && FATAL_ERROR == createEntFile(files_name, symbols, ent_is_length))/*If there is an entry label in the input file and there is memory error in the function*/
+			return FATAL_ERROR;
+
+		if(emit_object && FATAL_ERROR == createObjFile(files_name, ic_dc_counter, image, symbols))/*If the binary object was asked and there is memory error in the function*/
 			return FATAL_ERROR;
 	}
+	addStageTime(stats, OUTPUT_STAGE, &start_time);
 	return indicator;
 }
 
 /*   
 * The function: fillingMissingBMCofLabel
 *
-* The function cheecks for errors in the labels at declarationNode list, and if it's
-* proper, it's enter the binary value of the label, except of the binary value of extern label.
+* The function goes over the fixups of the code image, and if the label of a fixup is proper, it's enter the binary
+* value of the label to the word of the operand, or the value of an extern label. The other words are not touched.
 * 
 * Parameters:
-*	file_name - the name of the input file with the suffix .am.
-*	instructions_list - a list of instructionNode.
-*	declarations_list - a pointer to list of declarationNode.
-*	ent_is_length - cell 0 indicate if there is at least 1 entry, cell 1 present the length of longest entry.
+*	file_name - the name of the input file with the suffix .as, that the errors refer to.
+*	image - a pointer to the memory image of the file.
+*	symbols - a pointer to the symbol table.
 *	ext_is_length - cell 0 indicate if there is at least 1 extern, cell 1 present the length of longest extern.
 *
 * Returns:
 *	0 (FALSE) - if there was an error and there is an undefined label.
 *	1 (TRUE) - if successfully enter all the binary values of the labels in their place.
 */
-char fillingMissingBMCofLabel(char* file_name, instructionNode** instructions_list, declarationNode* declarations_list, short* ent_is_length, short* ext_is_length)
+char fillingMissingBMCofLabel(char* file_name, memoryImage* image, symbolTable* symbols, short* ext_is_length)
 {
-	char found_label_name;/*Represent if the name of the label was found */
-	char curr_declared_entry;/*Represent if the label name was declared as entry for the current node*/
-	char curr_declared_extern;/*Represent if the label name was declared as extern for the current node*/
-	char curr_declared_dsc;/*Represent if the label name was declared as data/string/code for the current node*/
-	char no_error = TRUE;/*Represent if there are errors while going throw the instructions_list nodes*/
+	char no_error = TRUE;/*Represent if there are errors while going throw the fixups*/
 	char error_str[ERROR_MESSAGE_SIZE] = { '\0' };/*Include the content of the error, if there is an error*/
-	short curr_ins_da; /*Represent the value of the decimal address(da) for the current node */
-	instructionNode *curr_ins = *instructions_list;/*The current instruction node */
-	declarationNode *curr_dec = declarations_list;/*The current declaration node*/
+	int i;/*Counter*/
+	symbol *record;/*The record of the label of the current fixup*/
+	fixup *curr_fixup;/*The current fixup*/
 	
-	while(curr_ins)/*If curr_ins not empty*/
+	for(i = 0; i < image->fixups_amount; i++)/*The fixups in the order of the code image*/
 	{
-		/*Reset the variables:*/
-		found_label_name = FALSE;
-		curr_declared_entry = FALSE;
-		curr_declared_extern = FALSE;
-		curr_declared_dsc = FALSE;
-		if(curr_ins->line)/*If bmc was not defined,which mean that there is a label to check */
+		curr_fixup = &image->fixups[i];
+		record = &symbols->symbols[curr_fixup->symbol];
+		if(record->is_extern)/*If the label is extern*/
 		{
-			while( curr_dec && (!curr_declared_extern) && (!(curr_declared_entry && curr_declared_dsc)) ) /*If didnt passed on all the declaration list and not extern or not entered all the 'if' conditions inside*/
-			{
-				if(!strcmp(curr_ins->type.name,curr_dec->label))/*If as the same label name */
-				{
-					found_label_name = TRUE;/*There is label with the same name*/	
-					if(curr_dec->type == EXTERN)/*If the label is extern*/
-					{	
-						curr_declared_extern = TRUE;/*The label is extern*/
-						curr_ins->line = EXTERN;/*Mark the label as extern*/
-						ext_is_length[0] = TRUE;/*Generally there is an extern label*/
-						if(ext_is_length[1] < strlen(curr_dec->label) )/*Check longest extern*/
-							ext_is_length[1] = strlen(curr_dec->label);/*Save the longest extern*/
-					}
-					else if( (!curr_declared_entry) && (curr_dec->type == ENTRY) ) /*If not enterd in yet && and the label is entry*/
-					{
-						curr_declared_entry = TRUE;/*The label is entry*/
-						ent_is_length[0] = TRUE;/*Generally there is an entry label*/
-						if(ent_is_length[1] < strlen(curr_dec->label) )/*Check longest entry*/
-							ent_is_length[1] = strlen(curr_dec->label);/*Save the longest entry*/
-					}
-					else if(!curr_declared_dsc)/*If not enterd in yet, and it is a definition node */
-					{
-						curr_declared_dsc = TRUE;/*The label is data/string/code*/
-						curr_ins_da = curr_dec->decimal_address;
-					}	
-				}
-				curr_dec = curr_dec->next;/*Pass to the next node*/
-			}
-			
-			if(!found_label_name)/*if the name of the label was not found in the declaration list*/
-			{
-				no_error = FALSE;/*Error was founded*/
-				sprintf(error_str,"The label: %s is illegal, it was not defined or declared as extern.", curr_ins->type.name);
-				generalError(file_name, curr_ins->line, error_str);
-			}
-			if(!curr_declared_extern)/*If the label is not type extern*/
-			{
-				free(curr_ins->type.name);
-				getRelocatableBMC(curr_ins_da,&curr_ins->type.bmc);/*Enter the bmc value of the label*/
-				curr_ins->line = HAVE_BMC;/*Update that the BMC of the node has been defined*/
-			}
-			curr_dec = declarations_list;/*Return curr_dec back to the first node*/
+			image->code.words[curr_fixup->index] = EXTERN_VALUE;/*Set the value of EXTERN label*/
+			ext_is_length[0] = TRUE;/*Generally there is an extern label*/
+			if(ext_is_length[1] < strlen(record->name) )/*Check longest extern*/
+				ext_is_length[1] = strlen(record->name);/*Save the longest extern*/
+		}
+		else if(record->defined_type != NO_TYPE || record->is_entry)/*The label is defined, or it's an entry that was not defined and the error was already found*/
+			getRelocatableBMC(record->address, &image->code.words[curr_fixup->index]);/*Enter the bmc value of the label*/
+		else/*The label was only mentioned in operands*/
+		{
+			no_error = FALSE;/*Error was founded*/
+			sprintf(error_str,"The label: %s is illegal, it was not defined or declared as extern.", record->name);
+			generalError(file_name, curr_fixup->line, error_str);
 		}
-		curr_ins = curr_ins->next;/*Pass to the next node*/
 	}
 	return no_error;
 }
@@ -134,42 +102,32 @@ char fillingMissingBMCofLabel(char* file_name, instructionNode** instructions_li
 * The function: isEntriesDefined
 *
 * The function cheecks that every label which was declared has entry, in addition it was also defined
-* has entry.
+* in the file, and finds the length of the longest entry.
 * 
 * Parameters:
-*	file_name - the name of the input file with the suffix .am.
-*	declarations_list - a pointer to list of declarationNode.
+*	file_name - the name of the input file with the suffix .as, that the errors refer to.
+*	symbols - a pointer to the symbol table.
+*	ent_is_length - cell 0 indicate if there is at least 1 entry, cell 1 present the length of longest entry.
 *
 * Returns:
 *	0 (FALSE) - if there is an entry that was declared but not defined.
 *	1 (TRUE) - if every entry was declared and defined.
 */
-char isEntriesDefined(char* file_name, declarationNode* declarations_list)
+char isEntriesDefined(char* file_name, symbolTable* symbols, short* ent_is_length)
 {
-
-	declarationNode *curr_dec = declarations_list;/*Represent the current declaraton node*/
-	declarationNode *temp;/*Represent the second declaration node to be compared by the first declaration node*/
-	char indicator;/*Represent if found a matching label */
+	int i;/*Counter*/
+	symbol *record;/*Represent the record of the current entry*/
 	char error_str[ERROR_MESSAGE_SIZE] = { '\0' };/*Include the content of the error, if there is an error*/
 	
-	while(curr_dec){/*If curr_dec not empty*/
-		if(curr_dec->type == ENTRY){/*If the label is entry*/
-			temp = declarations_list;
-			indicator = FALSE;/*Reset the variable*/
-			while(temp){/*if temp not empty*/
-				if(!strcmp(curr_dec->label, temp->label) && (temp->type != ENTRY)){/*If has the same name and is not entry type*/
-					 indicator = TRUE;
-					 curr_dec->decimal_address = temp->decimal_address;
-					 break;/*Found matching label, so can finish the while*/
-				}
-				temp = temp->next;/*Pass to the next node*/
-			}
-			if(indicator == FALSE){/*If didnt found matching label*/
-				sprintf(error_str, "No definition was found for the entry: %s", curr_dec->label);
-				generalError(file_name, curr_dec->decimal_address, error_str);
-			}				
+	for(i = 0; i < symbols->entries_amount; i++){/*The entries in the order of their declaration*/
+		record = &symbols->symbols[symbols->entries[i]];
+		if(record->defined_type == NO_TYPE){/*If didnt found a definition of the entry*/
+			sprintf(error_str, "No definition was found for the entry: %s", record->name);
+			generalError(file_name, record->line, error_str);
 		}
-		curr_dec = curr_dec->next;/*Pass to the next node*/
+		ent_is_length[0] = TRUE;/*Generally there is an entry label*/
+		if(ent_is_length[1] < strlen(record->name))/*Check longest entry*/
+			ent_is_length[1] = strlen(record->name);/*Save the longest entry*/
 	}
 	if(error_str[0])/*If there are errors*/
 		return FALSE;
@@ -188,9 +146,7 @@ char isEntriesDefined(char* file_name, declarationNode* declarations_list)
 */
 void getRelocatableBMC(short decimal_value, short* bmc)
 {	
-	*bmc = HAVE_BMC; /*reset the value of bmc to 0*/
-	turnOnBit(bmc, R_ADDRESSING_METHOD);
-	insertBinaryValueByData(decimal_value, bmc, ADDRESS_START_POSITION);
+	*bmc = encodeOperand(decimal_value, R_ADDRESSING_METHOD);/*The address and the 'R' bit*/
 }
 
 /********************************************************************* - PRINTING FUNCTIONS - *********************************************************************/
@@ -204,23 +160,23 @@ void getRelocatableBMC(short decimal_value, short* bmc)
 * Parameters:
 *	file_name - the name of the output file without the suffix.
 *	ic_dc_counter - contain the amount of ic(cell 0) and dc(cell 1) from first pass.
-*	instructions_list - a list of instructionNode.	 
-*	data_list - a pointer to list of dataNode.
-*	ext_is_length - cell 0 indicate if there is at least 1 extern, cell 1 present the length of longest extern.
+*	image - a pointer to the memory image of the file.
+*	symbols - a pointer to the symbol table.
+*	ext_is_length- cell 0 indicate if there is at least 1 extern, cell 1 present the length of longest extern.
 *
 * Returns:
 *	-1(FATAL_ERROR) - if there was fatal error(memory/files opening).
 *	1(TRUE) - if there was no error.
 */
-char createObAndExtFiles(char* file_name, short* ic_dc_counter, instructionNode** instructions_list, dataNode* data_list, short* ext_is_length)
+char createObAndExtFiles(char* file_name, short* ic_dc_counter, memoryImage* image, symbolTable* symbols, short* ext_is_length)
 {
-	FILE *ob_file, *ext_file;/*Pointers to the ob and ext files*/
+	outputBuffer ob_file, ext_file;/*The buffered writers of the ob and ext files*/
+	char indicator;/*The result of creating a file*/
 	char* ob_file_name = NULL;/*Represent the ob file name*/
 	char* ext_file_name = NULL;/*Represent the external file name*/
-	
-	instructionNode *curr_ins = *instructions_list;/*Represent the current instruction node */
-	dataNode *curr_data = data_list;/*Represent the current data node */
-	
+	short ic = FIRST_MEMORY_CELL + ic_dc_counter[0];/*The decimal address of the first data word*/
+	int i;/*Counter*/
+
 	/*Allocate memory for the new ob file name*/
 	ob_file_name = (char*)malloc(sizeof(char) * (strlen(file_name)+OB_FILE_SIZE));
 	if(!ob_file_name)/*If there was an error in allocation*/
@@ -247,9 +203,12 @@ char createObAndExtFiles(char* file_name, short* ic_dc_counter, instructionNode*
 	}
 	
 	/*Create new ob file*/
-	if(!(ob_file = fopen(ob_file_name, "w")))/*If there was an error opening the ob file*/
+	if((indicator = outputOpen(&ob_file, ob_file_name)) != TRUE)/*If there was an error opening the ob file*/
 	{
-		newFileOpenError("ob_file", file_name);
+		if(indicator == FATAL_ERROR)
+			memoryError("ob_file", file_name);
+		else
+			newFileOpenError("ob_file", file_name);
 		free(ob_file_name);
 		if(ext_is_length[0])/*If there is extern label in the input file*/
 			free(ext_file_name);
@@ -257,36 +216,35 @@ char createObAndExtFiles(char* file_name, short* ic_dc_counter, instructionNode*
 	}
 	
 	/*Create new ext file*/
-	if(ext_is_length[0] && (!(ext_file = fopen(ext_file_name, "w"))) )/*If there is extern label in the input file and there was an error creating the ext file*/
+	if(ext_is_length[0] && (indicator = outputOpen(&ext_file, ext_file_name)) != TRUE)/*If there is extern label in the input file and there was an error creating the ext file*/
 	{
-		newFileOpenError("ext_file", file_name);
+		if(indicator == FATAL_ERROR)
+			memoryError("ext_file", file_name);
+		else
+			newFileOpenError("ext_file", file_name);
 		free(ob_file_name);
 		free(ext_file_name);
-		fclose(ob_file);
+		outputClose(&ob_file);
 		return FATAL_ERROR;
 	}
 	
 	/*Print to the output files*/
-	printfObIcDcNumbersLine(ob_file, ic_dc_counter);
-	while(curr_ins)/* Print instructionNode list */
-	{
-		if(curr_ins->line)/*If there is a value of an extern label */
-			printfExtOutputLine(ext_file, curr_ins, ext_is_length);/*Print to the extern file*/
-			
-		fprintf(ob_file, "%04d %05o\n", curr_ins->ic,curr_ins->type.bmc);/*Print to the ob file*/
-		curr_ins = curr_ins->next;/*Pass to the next node*/	
-	}
-	while(curr_data)/* Print dataNode list*/
+	printfObIcDcNumbersLine(&ob_file, ic_dc_counter);
+	for(i = 0; i < image->code.words_amount; i++)/* Print the code image */
+		printfObOutputLine(&ob_file, FIRST_MEMORY_CELL + i, image->code.words[i]);/*Print to the ob file*/
+	for(i = 0; i < image->data.words_amount; i++)/* Print the data image, after the code image */
+		printfObOutputLine(&ob_file, ic + i, image->data.words[i]);/*Print to the ob file*/
+	for(i = 0; i < image->fixups_amount; i++)/* Print the operands of extern labels */
 	{
-		fprintf(ob_file, "%04d %05o\n", curr_data->dc, curr_data->bmc);/*Print to the ob file*/
-		curr_data = curr_data->next;/*Print to the ob file*/
+		if(symbols->symbols[image->fixups[i].symbol].is_extern)
+			printfExtOutputLine(&ext_file, &symbols->symbols[image->fixups[i].symbol], FIRST_MEMORY_CELL + image->fixups[i].index, ext_is_length);/*Print to the extern file*/
 	}
 
-	fclose(ob_file);
+	outputClose(&ob_file);
 	free(ob_file_name);
 	if(ext_is_length[0])/*If there is extern label in the input file*/
 	{
-		fclose(ext_file);
+		outputClose(&ext_file);
 		free(ext_file_name);
 	}
 	return TRUE;
@@ -299,18 +257,19 @@ char createObAndExtFiles(char* file_name, short* ic_dc_counter, instructionNode*
 * 
 * Parameters:
 *	file_name - the name of the output file without the suffix.
-*	declarations_list - a pointer to list of declarationNods.
+*	symbols - a pointer to the symbol table.
 *	ent_is_length - cell 0 indicate if there is at least 1 entry, cell 1 present the length of longest entry.
 *
 * Returns:
 *	-1(FATAL_ERROR) - if there was fatal error(memory/files opening).
 *	1(TRUE) - if there was no error.
 */
-char createEntFile(char* file_name, declarationNode* declarations_list, short* ent_is_length)
+char createEntFile(char* file_name, symbolTable* symbols, short* ent_is_length)
 {
-	FILE* ent_file;/*Pointer to the ent file*/
+	outputBuffer ent_file;/*The buffered writer of the ent file*/
+	char indicator;/*The result of creating the file*/
 	char* ent_file_name = NULL;/*Represent the ent file name*/
-	declarationNode *curr_dec = declarations_list;/*Represent the current declaration node*/
+	int i;/*Counter*/
 	
 	/*Allocate memory for the new ent file name*/
 	ent_file_name = (char*)malloc(sizeof(char) * (strlen(file_name)+ENT_FILE_SIZE));
@@ -323,37 +282,113 @@ char createEntFile(char* file_name, declarationNode* declarations_list, short* e
 	strcat(ent_file_name, ".ent");
 	
 	/*Create new ent file*/
-	if(!(ent_file = fopen(ent_file_name, "w")))/*If there was an error opening the ent file*/
+	if((indicator = outputOpen(&ent_file, ent_file_name)) != TRUE)/*If there was an error opening the ent file*/
 	{
-		newFileOpenError("ent_file", file_name);
+		if(indicator == FATAL_ERROR)
+			memoryError("ent_file", file_name);
+		else
+			newFileOpenError("ent_file", file_name);
 		free(ent_file_name);
 		return FATAL_ERROR;
 	}
 	
-	while(curr_dec)/*If curr_dec not empty*/
-	{
-		if(curr_dec->type == ENTRY)/*If the label is entry */	
-			printfEntOutputLine(ent_file, curr_dec, ent_is_length);/*Print to the ent file*/
-		curr_dec = curr_dec->next;/*Pass to the next node*/
-	}
-	fclose(ent_file);
+	for(i = 0; i < symbols->entries_amount; i++)/*The entries in the order of their declaration*/
+		printfEntOutputLine(&ent_file, &symbols->symbols[symbols->entries[i]], ent_is_length);/*Print to the ent file*/
+	outputClose(&ent_file);
 	free(ent_file_name);
 	return TRUE;
 }
 
+/* 
+* The function: createObjFile
+*
+* The function creates the binary object output file, with the same words, entries and externs as the text files.
+* 
+* Parameters:
+*	file_name - the name of the output file without the suffix.
+*	ic_dc_counter - contain the amount of ic(cell 0) and dc(cell 1) from first pass.
+*	image - a pointer to the memory image of the file.
+*	symbols - a pointer to the symbol table.
+*
+* Returns:
+*	-1(FATAL_ERROR) - if there was fatal error(memory/files opening).
+*	1(TRUE) - if there was no error.
+*/
+char createObjFile(char* file_name, short* ic_dc_counter, memoryImage* image, symbolTable* symbols)
+{
+	objectImage object;/*The bytes of the binary object*/
+	objectSymbol *entries = NULL;/*The entry records of the object*/
+	objectSymbol *externs = NULL;/*The extern records of the object*/
+	int externs_amount = 0;/*The amount of extern records*/
+	char* obj_file_name = NULL;/*Represent the obj file name*/
+	char indicator = TRUE;/*The result of creating the file*/
+	int i;/*Counter*/
+
+	/*Allocate memory for the new obj file name and the records, one more cell so nothing is allocated with size 0*/
+	obj_file_name = (char*)malloc(sizeof(char) * (strlen(file_name)+EXT_FILE_SIZE));
+	entries = (objectSymbol*)malloc(sizeof(objectSymbol) * (symbols->entries_amount+1));
+	externs = (objectSymbol*)malloc(sizeof(objectSymbol) * (image->fixups_amount+1));
+	if(!obj_file_name || !entries || !externs)/*If there was an error in allocation*/
+	{
+		memoryError("obj_file", file_name);
+		free(obj_file_name);
+		free(entries);
+		free(externs);
+		return FATAL_ERROR;
+	}
+	strcpy(obj_file_name, file_name);
+	strcat(obj_file_name, ".obj");
+
+	for(i = 0; i < symbols->entries_amount; i++)/*The entries in the order of their declaration*/
+	{
+		entries[i].name = symbols->symbols[symbols->entries[i]].name;
+		entries[i].address = symbols->symbols[symbols->entries[i]].address;
+	}
+	for(i = 0; i < image->fixups_amount; i++)/*The operands of extern labels, in the order of the code image*/
+	{
+		if(symbols->symbols[image->fixups[i].symbol].is_extern)
+		{
+			externs[externs_amount].name = symbols->symbols[image->fixups[i].symbol].name;
+			externs[externs_amount++].address = FIRST_MEMORY_CELL + image->fixups[i].index;
+		}
+	}
+
+	if(buildObjectImage(&object, image->code.words, ic_dc_counter[0], image->data.words, ic_dc_counter[1], entries, symbols->entries_amount, externs, externs_amount) != TRUE)
+	{
+		memoryError("obj_file", file_name);
+		indicator = FATAL_ERROR;
+	}
+	else
+	{
+		if((indicator = writeObjectFile(&object, obj_file_name)) != TRUE)/*If there was an error opening the obj file*/
+		{
+			if(indicator == FATAL_ERROR)
+				memoryError("obj_file", file_name);
+			else
+				newFileOpenError("obj_file", file_name);
+			indicator = FATAL_ERROR;
+		}
+		freeObjectImage(&object);
+	}
+
+	free(obj_file_name);
+	free(entries);
+	free(externs);
+	return indicator;
+}
+
 /*   
 * The function: printfObIcDcNumbersLine
 *
 * The function prints the first line of the object file that includes the numbers of ic and dc lines.
 * 
 * Parameters:
-*	oc_file - the object file to be printed on.
+*	ob_file - the buffered writer of the object file.
 *	ic_dc_counter - contain the numbers of ic(cell 0) and dc(cell 1).
 */
-void printfObIcDcNumbersLine(FILE* ob_file,short* ic_dc_counter)
+void printfObIcDcNumbersLine(outputBuffer* ob_file,short* ic_dc_counter)
 {
 	short space_length = 3;/*Represent the max length of space between the ic numbers to start of the line*/
-	short i;/*Counter*/
 	short ic_digits = ic_dc_counter[0];/*Represent the number of ic lines */
 	const short SINGLE_DIGIT_NUMBER = 9;/*Represent the 1 digit number*/
 	while(ic_digits > SINGLE_DIGIT_NUMBER)/*If ic_digits is bigger then 1 digit number*/
@@ -361,10 +396,31 @@ void printfObIcDcNumbersLine(FILE* ob_file,short* ic_dc_counter)
 		ic_digits/=10;/*Make the number smaller by dividing it by 10*/
 		space_length--;/*Reduce the space length*/
 	}
-	for(i=0 ; i<space_length; i++)/*Make space according to the needed space length*/
-		fprintf(ob_file, " ");
+	outputSpaces(ob_file, space_length);/*Make space according to the needed space length*/
 		
-	fprintf(ob_file, "%d %d\n", ic_dc_counter[0], ic_dc_counter[1]);/*Print the ic dc number*/
+	/*Print the ic dc number*/
+	outputDecimal(ob_file, ic_dc_counter[0], 0);
+	outputChars(ob_file, " ", 1);
+	outputDecimal(ob_file, ic_dc_counter[1], 0);
+	outputChars(ob_file, "\n", 1);
+}
+
+/*   
+* The function: printfObOutputLine
+*
+* The function prints a line of the object file that includes a decimal address (4 digits) and a word in octal (5 digits).
+* 
+* Parameters:
+*	ob_file - the buffered writer of the object file.
+*	address - the decimal address of the word.
+*	bmc - the binary machine code of the word.
+*/
+void printfObOutputLine(outputBuffer* ob_file, short address, short bmc)
+{
+	outputDecimal(ob_file, address, 4);
+	outputChars(ob_file, " ", 1);
+	outputOctal(ob_file, (unsigned int)bmc, 5);/*The word is printed like an int in printf*/
+	outputChars(ob_file, "\n", 1);
 }
 
 /*   
@@ -373,19 +429,19 @@ void printfObIcDcNumbersLine(FILE* ob_file,short* ic_dc_counter)
 * The function prints a line to the entry file that includes the entry name and decimal address.
 * 
 * Parameters:
-*	ent_file - the entry file to be printed on.
-*	curr_dec - current declaration node that include the entry label name and decimal address.
+*	ent_file - the buffered writer of the entry file.
+*	record - the record of the entry label in the symbol table, that include the label name and decimal address.
 *	ent_is_length - contain the length of the longest entry(in cell 1).
 */
-void printfEntOutputLine(FILE* ent_file, declarationNode* curr_dec, short* ent_is_length)
+void printfEntOutputLine(outputBuffer* ent_file, symbol* record, short* ent_is_length)
 {
-	short i;/*Counter*/
-	fprintf(ent_file, "%s", curr_dec->label);/*Print the label name*/
+	outputString(ent_file, record->name);/*Print the label name*/
 
-	for(i=0 ; i < (ent_is_length[1]-strlen(curr_dec->label)+1 ) ; i++ )/*Make space between the labels name to their decimal address according to the needed space length*/
-		fprintf(ent_file, " ");
+	/*Make space between the labels name to their decimal address according to the needed space length*/
+	outputSpaces(ent_file, ent_is_length[1]-(short)strlen(record->name)+1);
 		
-	fprintf(ent_file, "%04d\n", curr_dec->decimal_address);/*Print their decimal address*/
+	outputDecimal(ent_file, record->address, 4);/*Print their decimal address*/
+	outputChars(ent_file, "\n", 1);
 }
 
 /*   
@@ -394,22 +450,20 @@ void printfEntOutputLine(FILE* ent_file, declarationNode* curr_dec, short* ent_i
 * The function prints a line to the extern file that includes the extern name and decimal address.
 * 
 * Parameters:
-*	ext_file - the extern file to be printed on.
-*	curr_ins - current instruction node that include the extern label name and decimal address.
+*	ext_file - the buffered writer of the extern file.
+*	record - the record of the extern label in the symbol table.
+*	address - the decimal address of the word of the operand.
 *	ext_is_length - contain the length of the longest extern(in cell 1).
 */
-void printfExtOutputLine(FILE* ext_file, instructionNode* curr_ins, short* ext_is_length)
+void printfExtOutputLine(outputBuffer* ext_file, symbol* record, short address, short* ext_is_length)
 {
-	int i;/*Counter*/
-	fprintf(ext_file, "%s", curr_ins->type.name);/*Print the label name*/
+	outputString(ext_file, record->name);/*Print the label name*/
 	
-	for(i=0 ; i < (ext_is_length[1]-strlen(curr_ins->type.name)+2 ) ; i++ )/*Make space between the labels name to their decimal address according to the needed space length*/
-		fprintf(ext_file, " ");
+	/*Make space between the labels name to their decimal address according to the needed space length*/
+	outputSpaces(ext_file, ext_is_length[1]-(long)strlen(record->name)+2);
 	
-	free(curr_ins->type.name);
-	curr_ins->type.bmc = EXTERN_VALUE;/*Set the value of EXTERN label*/
-	curr_ins->line = HAVE_BMC;/*Update that the BMC of the node has been defined*/
-	fprintf(ext_file, "%04d\n", curr_ins->ic);/*Print their decimal address*/
+	outputDecimal(ext_file, address, 4);/*Print their decimal address*/
+	outputChars(ext_file, "\n", 1);
 }
 
 
@@ -0,0 +1,153 @@
+#include "headers.h"
+
+/*
+* FILE: server.c
+*
+* This file runs the assembler as a server (--server), for build systems that assemble many files.
+* The assembler stays resident and reads assemble requests from the standard input, one request in every line:
+*	[--emit-am] [--obj] [--thread-jumps] [--dce] [--peephole] [--stats] file_name
+* The options of a request are added to the options of the command line, and the file name is the rest of the line
+* (without the .as suffix, it may include spaces). For every request the server prints the messages of the file as usual,
+* and then one status line:
+*	--- status: ok ---			the output files were created.
+*	--- status: errors ---			errors were found in the file (or it does not exist), the messages describe them.
+*	--- status: fatal ---			a memory error or a file opening error stopped the work on the file.
+*	--- status: bad request ---		the line is not a valid request, it was not assembled.
+* The standard output is flushed after every status line, so a client can wait for it. Empty lines are ignored, and the
+* server ends at the end of the input. The tables, the arena and the lines arrays are kept from request to request.
+* With --cache the requests go through the build cache, it is trimmed after every CACHE_TRIM_MISSES new entries and
+* at the end of the input, and its statistics are printed at the end.
+* Only a local client can talk to the server, through the pipes of its standard input and output, no network is used.
+*
+*/
+
+/*
+* The function: runAssemblerServer
+*
+* The function reads the requests from the standard input until its end, and assembles the file of every request.
+*
+* Parameters:
+*	options - the options of the assembler from the command line, every request starts from them.
+*
+* Returns:
+*	TRUE - when the end of the input was reached.
+*	FATAL_ERROR - if a memory error stopped one of the requests.
+*/
+char runAssemblerServer(assemblerOptions* options)
+{
+	assemblerWorkspace workspace;/*The tables that are kept from request to request*/
+	assemblerOptions request;/*The options of the current request*/
+	char line[SERVER_LINE_SIZE];/*The current request line*/
+	char *file_name;/*The file name of the current request*/
+	char result = TRUE;/*FATAL_ERROR if one of the requests was stopped by a memory error*/
+	char indicator;/*The result of the current request*/
+	long trimmed_misses = 0;/*The misses of the build cache when it was trimmed last*/
+	int c;/*A character of a line that is too long*/
+
+	workspaceInit(&workspace);
+	while(fgets(line, SERVER_LINE_SIZE, stdin)){
+		if(!strchr(line, '\n') && !feof(stdin)){/*The line is too long, the rest of it is skipped*/
+			while((c = getchar()) != '\n' && c != EOF)
+				;
+			printServerStatus("bad request");
+			continue;
+		}
+
+		request = *options;
+		request.workspace = &workspace;
+		if(!readServerRequest(line, &request, &file_name)){
+			printServerStatus("bad request");
+			continue;
+		}
+		if(!file_name)/*An empty line*/
+			continue;
+
+		indicator = buildFile(file_name, &request);
+		if(options->cache && options->cache->misses - trimmed_misses >= CACHE_TRIM_MISSES){
+			trimBuildCache(options->cache);
+			trimmed_misses = options->cache->misses;
+		}
+		if(indicator == FATAL_ERROR)
+			result = FATAL_ERROR;
+		printServerStatus((indicator == FATAL_ERROR) ? "fatal" : (indicator ? "ok" : "errors"));
+	}
+	freeWorkspace(&workspace);
+	if(options->cache){
+		trimBuildCache(options->cache);
+		printCacheStats(options->cache);
+		fflush(stdout);
+	}
+	return result;
+}
+
+/*
+* The function: readServerRequest
+*
+* The function reads the options and the file name of a request line.
+*
+* Parameters:
+*	line - the request line, it is changed: the end of the file name is marked with '\0'.
+*	request - a pointer to the options of the request, the options of the line are added to it.
+*	file_name - a pointer that receives the file name inside the line, or NULL if the line is empty.
+*
+* Returns:
+*	TRUE - if the request is valid, or the line is empty.
+*	FALSE - if an option is unknown, or there is no file name after the options.
+*/
+char readServerRequest(char* line, assemblerOptions* request, char** file_name)
+{
+	char *end;/*The end of the current word, or of the file name*/
+
+	*file_name = NULL;
+	while(isspace((unsigned char)*line))
+		line++;
+	if(!*line)
+		return TRUE;
+
+	/*Read the options that appear before the file name*/
+	while(line[0] == '-' && line[1] == '-'){
+		for(end = line; *end && !isspace((unsigned char)*end); end++)
+			;
+		if(end - line == (int)strlen("--emit-am") && !strncmp(line, "--emit-am", end - line))
+			request->emit_am = TRUE;
+		else if(end - line == (int)strlen("--obj") && !strncmp(line, "--obj", end - line))
+			request->emit_object = TRUE;
+		else if(end - line == (int)strlen("--thread-jumps") && !strncmp(line, "--thread-jumps", end - line))
+			request->optimizations |= JUMP_THREADING;
+		else if(end - line == (int)strlen("--dce") && !strncmp(line, "--dce", end - line))
+			request->optimizations |= DEAD_CODE_ELIMINATION;
+		else if(end - line == (int)strlen("--peephole") && !strncmp(line, "--peephole", end - line))
+			request->optimizations |= PEEPHOLE_OPTIMIZATION;
+		else if(end - line == (int)strlen("--stats") && !strncmp(line, "--stats", end - line))
+			request->print_stats = TRUE;
+		else
+			return FALSE;
+		for(line = end; isspace((unsigned char)*line); line++)
+			;
+	}
+	if(!*line)
+		return FALSE;
+
+	/*The file name is the rest of the line, without the white characters at its end*/
+	for(end = line + strlen(line); isspace((unsigned char)end[-1]); end--)
+		;
+	*end = '\0';
+	*file_name = line;
+	return TRUE;
+}
+
+/*
+* The function: printServerStatus
+*
+* The function prints the status line that ends the reply to a request, and sends the reply to the client.
+*
+* Parameters:
+*	status - the status of the request.
+*/
+void printServerStatus(char* status)
+{
+	printf("--- status: %s ---\n", status);
+	fflush(stdout);
+}
+
+/*********************************************************************** - END OF SERVER - ***********************************************************************/
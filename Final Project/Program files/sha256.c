@@ -0,0 +1,165 @@
+#include "headers.h"
+
+/*
+* FILE: sha256.c
+*
+* This file includes the SHA-256 hash function (FIPS 180-4), that the build cache uses for the keys of its entries.
+* The words of the hash are 32 bits, they are kept in unsigned long variables and masked after every addition and
+* shift, so the function gives the same hash on every system.
+*
+*/
+
+/*
+* The function: sha256Init
+*
+* The function starts a new hash.
+*
+* Parameters:
+*	context - a pointer to the state of the hash.
+*/
+void sha256Init(sha256Context* context)
+{
+	static const unsigned long initial_state[8] = {0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL,
+						0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL};/*The first 32 bits of the square roots of the first 8 primes*/
+	int i;/*Counter*/
+
+	for(i = 0; i < 8; i++)
+		context->state[i] = initial_state[i];
+	context->bytes_amount = 0;
+	context->block_used = 0;
+}
+
+/*
+* The function: sha256Block
+*
+* The function adds a full block of 64 bytes to the hash.
+*
+* Parameters:
+*	context - a pointer to the state of the hash.
+*	block - the block.
+*/
+void sha256Block(sha256Context* context, unsigned char* block)
+{
+	static const unsigned long k[64] = {
+		0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+		0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+		0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+		0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+		0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+		0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+		0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+		0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL};/*The round constants*/
+	unsigned long w[64];/*The message schedule*/
+	unsigned long a, b, c, d, e, f, g, h;/*The working variables*/
+	unsigned long s0, s1, temp1, temp2;/*The values of a round*/
+	int i;/*Counter*/
+
+	for(i = 0; i < 16; i++)
+		w[i] = ((unsigned long)block[i*4] << 24) | ((unsigned long)block[i*4+1] << 16) | ((unsigned long)block[i*4+2] << 8) | block[i*4+3];
+	for(i = 16; i < 64; i++){
+		s0 = SHA256_ROTR(w[i-15], 7) ^ SHA256_ROTR(w[i-15], 18) ^ (w[i-15] >> 3);
+		s1 = SHA256_ROTR(w[i-2], 17) ^ SHA256_ROTR(w[i-2], 19) ^ (w[i-2] >> 10);
+		w[i] = (w[i-16] + s0 + w[i-7] + s1) & 0xFFFFFFFFUL;
+	}
+
+	a = context->state[0];
+	b = context->state[1];
+	c = context->state[2];
+	d = context->state[3];
+	e = context->state[4];
+	f = context->state[5];
+	g = context->state[6];
+	h = context->state[7];
+	for(i = 0; i < 64; i++){
+		s1 = SHA256_ROTR(e, 6) ^ SHA256_ROTR(e, 11) ^ SHA256_ROTR(e, 25);
+		temp1 = (h + s1 + ((e & f) ^ (~e & g)) + k[i] + w[i]) & 0xFFFFFFFFUL;
+		s0 = SHA256_ROTR(a, 2) ^ SHA256_ROTR(a, 13) ^ SHA256_ROTR(a, 22);
+		temp2 = (s0 + ((a & b) ^ (a & c) ^ (b & c))) & 0xFFFFFFFFUL;
+		h = g;
+		g = f;
+		f = e;
+		e = (d + temp1) & 0xFFFFFFFFUL;
+		d = c;
+		c = b;
+		b = a;
+		a = (temp1 + temp2) & 0xFFFFFFFFUL;
+	}
+	context->state[0] = (context->state[0] + a) & 0xFFFFFFFFUL;
+	context->state[1] = (context->state[1] + b) & 0xFFFFFFFFUL;
+	context->state[2] = (context->state[2] + c) & 0xFFFFFFFFUL;
+	context->state[3] = (context->state[3] + d) & 0xFFFFFFFFUL;
+	context->state[4] = (context->state[4] + e) & 0xFFFFFFFFUL;
+	context->state[5] = (context->state[5] + f) & 0xFFFFFFFFUL;
+	context->state[6] = (context->state[6] + g) & 0xFFFFFFFFUL;
+	context->state[7] = (context->state[7] + h) & 0xFFFFFFFFUL;
+}
+
+/*
+* The function: sha256Update
+*
+* The function adds bytes to the hash, the full blocks are hashed and the rest is kept for the next bytes.
+*
+* Parameters:
+*	context - a pointer to the state of the hash.
+*	data - the bytes.
+*	length - the amount of bytes.
+*/
+void sha256Update(sha256Context* context, unsigned char* data, size_t length)
+{
+	size_t part;/*The amount of bytes that are copied to the current block*/
+
+	context->bytes_amount += length;
+	while(length){
+		if(!context->block_used && length >= SHA256_BLOCK_SIZE){/*A full block is hashed without copying it*/
+			sha256Block(context, data);
+			data += SHA256_BLOCK_SIZE;
+			length -= SHA256_BLOCK_SIZE;
+			continue;
+		}
+		part = SHA256_BLOCK_SIZE - context->block_used;
+		if(part > length)
+			part = length;
+		memcpy(context->block + context->block_used, data, part);
+		context->block_used += (int)part;
+		data += part;
+		length -= part;
+		if(context->block_used == SHA256_BLOCK_SIZE){
+			sha256Block(context, context->block);
+			context->block_used = 0;
+		}
+	}
+}
+
+/*
+* The function: sha256Final
+*
+* The function pads the last block with the length of the bytes, and writes the hash as a hexadecimal string.
+*
+* Parameters:
+*	context - a pointer to the state of the hash.
+*	hex - a buffer of at least SHA256_HEX_SIZE characters, it receives the hash.
+*/
+void sha256Final(sha256Context* context, char* hex)
+{
+	unsigned long high = (context->bytes_amount >> 29) & 0xFFFFFFFFUL;/*The high 32 bits of the length in bits*/
+	unsigned long low = (context->bytes_amount << 3) & 0xFFFFFFFFUL;/*The low 32 bits of the length in bits*/
+	int i;/*Counter*/
+
+	context->block[context->block_used++] = 0x80;
+	if(context->block_used > SHA256_BLOCK_SIZE - 8){/*There is no room for the length in the current block*/
+		memset(context->block + context->block_used, 0, SHA256_BLOCK_SIZE - context->block_used);
+		sha256Block(context, context->block);
+		context->block_used = 0;
+	}
+	memset(context->block + context->block_used, 0, SHA256_BLOCK_SIZE - 8 - context->block_used);
+	for(i = 0; i < 4; i++){
+		context->block[SHA256_BLOCK_SIZE-8+i] = (unsigned char)((high >> (24 - i*8)) & 0xFF);
+		context->block[SHA256_BLOCK_SIZE-4+i] = (unsigned char)((low >> (24 - i*8)) & 0xFF);
+	}
+	sha256Block(context, context->block);
+
+	for(i = 0; i < 8; i++)
+		sprintf(hex + i*8, "%08lx", context->state[i]);
+}
+
+/*********************************************************************** - END OF SHA-256 - ***********************************************************************/
@@ -0,0 +1,477 @@
+#include "headers.h"
+
+/*
+* FILE: simulator.c
+*
+* This file is the simulator program, that runs an assembled program on the 15 bits machine.
+* Usage (the name of the program is without the suffix):
+*	./simulator [--max-steps N] [--registers] program
+* The program is read from its binary object file (.obj) if it exists, and otherwise from its text object files, and it
+* is loaded at FIRST_MEMORY_CELL: the code words and then the data words. The machine has MEMORY_SIZE cells, the
+* registers r0-r7, the PC and the PSW (the zero and the negative flags), and a stack of SIM_STACK_SIZE return addresses
+* for jsr and rts. The program runs from its first code word until stop.
+* The instructions:
+*	mov, add, sub - the target gets the source, the sum or the difference.
+*	cmp - sets the flags by source - target, nothing is written.	lea - the target gets the address of the label.
+*	clr, not, inc, dec - change the target.				red - the target gets the next character of the input (-1 at its end).
+*	jmp - jumps to the target.					bne - jumps to the target if the zero flag is clear.
+*	jsr - keeps the return address and jumps.			rts - returns to the kept address.
+*	prn - prints the target as a signed decimal number.		stop - ends the program.
+* The arithmetic instructions set the flags by their result. A label operand is a memory cell, *rX is the cell whose
+* address is in rX, and the target of a jump is the address of the label or the address in the register.
+*
+* The instructions are decoded once: before the run every instruction of the code is decoded to a dispatch record (the
+* function of its opcode, and pointers to its operands: a register, a memory cell, or a value that is kept in the record),
+* and the run only calls the function of the record at the PC. A write to a memory cell clears the records that include
+* the cell, they are decoded again if they run (a program that changes its own code still runs correctly).
+* At the end the amount of instructions and their rate are printed to the standard error, so the output of the program
+* can be compared between runs.
+*
+*/
+
+/* The function of every opcode, in the order of the opcode enum */
+static void (*sim_handlers[OPCODES_AMOUNT])(simulator*, simInstruction*) = {
+	simMov, simCmp, simAdd, simSub, simLea, simClr, simNot, simInc,
+	simDec, simJmp, simBne, simRed, simPrn, simJsr, simRts, simStop
+};
+
+int main(int argc, char *argv[])
+{
+	simulator *sim;/*The machine*/
+	long max_steps = SIM_MAX_STEPS;/*The limit of the amount of instructions*/
+	char print_registers = FALSE;/*TRUE if the registers should be printed at the end*/
+	double start_time, seconds;/*The time of the run*/
+	char indicator;/*The result of loading the program*/
+	int i = 1;/*The current argument number*/
+
+	/*Read the options that appear before the name of the program*/
+	while(i < argc && argv[i][0] == '-'){
+		if(!strcmp(argv[i], "--max-steps") && i+1 < argc){/*The limit of the amount of instructions*/
+			if((max_steps = atol(argv[++i])) < 1){
+				printf("--- Error: the option --max-steps must be followed by a positive number. ---\n");
+				return EXIT_FAILURE;
+			}
+		}
+		else if(!strcmp(argv[i], "--registers"))/*Print the registers at the end*/
+			print_registers = TRUE;
+		else{
+			printf("--- Error: unknown option %s. ---\n", argv[i]);
+			return EXIT_FAILURE;
+		}
+		i++;
+	}
+	if(i != argc-1){
+		printf("--- Usage: simulator [--max-steps N] [--registers] program ---\n");
+		return EXIT_FAILURE;
+	}
+
+	if(!(sim = (simulator*)malloc(sizeof(simulator)))){
+		memoryError("simulator", argv[i]);
+		return EXIT_FAILURE;
+	}
+	if((indicator = loadSimProgram(sim, argv[i])) != TRUE){
+		free(sim);
+		return EXIT_FAILURE;
+	}
+
+	start_time = wallTime();
+	runSimulator(sim, max_steps);
+	seconds = wallTime() - start_time;
+
+	if(print_registers)
+		printSimRegisters(sim);
+	fflush(stdout);
+	fprintf(stderr, "--- Simulated %ld instructions in %.6f seconds (%.0f instructions per second) ---\n",
+		sim->steps, seconds, (seconds > 0) ? sim->steps / seconds : 0.0);
+	indicator = (sim->state == SIM_STOPPED);
+	free(sim);
+	return indicator ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*
+* The function: loadSimProgram
+*
+* The function loads a program to the memory of the machine, resets the registers, and decodes the instructions of the code.
+*
+* Parameters:
+*	sim - a pointer to the machine.
+*	program_name - the name of the program, without the suffix.
+*
+* Returns:
+*	TRUE - if the program was loaded.
+*	FALSE - if its object does not exist or it is not valid, or it does not fit in the memory.
+*	FATAL_ERROR - if a memory allocation failure occurred.
+*/
+char loadSimProgram(simulator* sim, char* program_name)
+{
+	objectImage object;/*The object of the program*/
+	long words_amount;/*The amount of words of the program*/
+	short address;/*The address of the current instruction*/
+	char indicator;/*The result of loading the program*/
+	int i;/*Counter*/
+
+	if((indicator = loadObject(&object, program_name)) != TRUE)
+		return indicator;
+
+	memset(sim, 0, sizeof(simulator));
+	sim->code_end = (short)(FIRST_MEMORY_CELL + readObjectField(&object, OBJECT_CODE_WORDS_FIELD, 2));
+	words_amount = (long)readObjectField(&object, OBJECT_CODE_WORDS_FIELD, 2) + (long)readObjectField(&object, OBJECT_DATA_WORDS_FIELD, 2);
+	if(FIRST_MEMORY_CELL + words_amount > MEMORY_SIZE){
+		printf("--- Error: the program %s does not fit in the memory. ---\n", program_name);
+		freeObjectImage(&object);
+		return FALSE;
+	}
+	for(i = 0; i < words_amount; i++)
+		sim->memory[FIRST_MEMORY_CELL + i] = (short)(getObjectWord(&object, i) & WORD_MASK);
+	freeObjectImage(&object);
+
+	sim->pc = FIRST_MEMORY_CELL;
+	sim->state = SIM_RUNNING;
+
+	/*Decode the code once, an instruction that can not be decoded is decoded again (and reported) only if it runs*/
+	for(address = FIRST_MEMORY_CELL; address < sim->code_end && !decodeSimInstruction(sim, address); address = sim->decoded[address].next)
+		;
+	return TRUE;
+}
+
+/*
+* The function: decodeSimInstruction
+*
+* The function decodes the instruction at an address to its dispatch record, with the same fields that the encoder
+* uses: the opcode, the addressing types of the operands, the registers and the 'A', 'R' and 'E' bits.
+*
+* Parameters:
+*	sim - a pointer to the machine.
+*	address - the address of the first word of the instruction.
+*
+* Returns:
+*	NULL - if the instruction was decoded.
+*	The description of the error - if the words are not a valid instruction.
+*/
+char* decodeSimInstruction(simulator* sim, short address)
+{
+	simInstruction *instruction = &sim->decoded[address];/*The record of the instruction*/
+	short opcode;/*The opcode of the instruction*/
+	short types[2];/*The addressing types of the source and the target, or NO_TYPE*/
+	short **slots[2];/*The operands of the record*/
+	short operand_address;/*The address of the word of the current operand*/
+	short are;/*The 'A', 'R' or 'E' bit of the word of the current operand*/
+	short i;/*Counter*/
+
+	if(!decodeFirstWord(sim->memory[address], &opcode, types))
+		return "the word is not a valid instruction";
+
+	instruction->valid = FALSE;
+	instruction->handler = sim_handlers[opcode];
+	instruction->source = instruction->target = NULL;
+	instruction->source_indirect = instruction->target_indirect = FALSE;
+	slots[0] = &instruction->source;
+	slots[1] = &instruction->target;
+
+	for(i = 0; i < 2; i++){
+		if(types[i] == NO_TYPE)
+			continue;
+		if((operand_address = address + operandWordOffset(types, i)) >= MEMORY_SIZE)
+			return "the instruction passes the end of the memory";
+		if(!(are = decodeOperandWord(sim->memory[operand_address], types[i], i, &instruction->operands[i])))
+			return "the operand word of the instruction is not valid";
+		if(types[i] >= INDIRECT_REGISTER_ADDRESSING)
+			decodeSimRegister(sim, instruction, i, types[i], instruction->operands[i]);
+		else if(types[i] == IMMEDIATE_ADDRESSING)
+			*slots[i] = &instruction->operands[i];
+		else if(are == (1 << E_ADDRESSING_METHOD))
+			return "the instruction refers to an extern label, the program must be linked first";
+		else if((i == 0 && opcode == LEA) || (i == 1 && (opcode == JMP || opcode == BNE || opcode == JSR)))/*The address of the label*/
+			*slots[i] = &instruction->operands[i];
+		else/*The memory cell of the label*/
+			*slots[i] = &sim->memory[instruction->operands[i]];
+	}
+	instruction->next = address + instructionLength(types);
+	instruction->valid = TRUE;
+	return NULL;
+}
+
+/*
+* The function: decodeSimRegister
+*
+* The function sets a register operand of a dispatch record. The target of a jump with *rX is the address in the
+* register, so it is not indirect.
+*
+* Parameters:
+*	sim - a pointer to the machine.
+*	instruction - the record of the instruction.
+*	operand - 0 for the source operand, 1 for the target operand.
+*	type - the addressing type of the operand.
+*	reg - the number of the register.
+*/
+void decodeSimRegister(simulator* sim, simInstruction* instruction, short operand, short type, short reg)
+{
+	char is_jump = (instruction->handler == simJmp || instruction->handler == simBne || instruction->handler == simJsr);/*TRUE for a jump*/
+
+	if(operand){
+		instruction->target = &sim->registers[reg];
+		instruction->target_indirect = (type == INDIRECT_REGISTER_ADDRESSING && !is_jump);
+	}
+	else{
+		instruction->source = &sim->registers[reg];
+		instruction->source_indirect = (type == INDIRECT_REGISTER_ADDRESSING);
+	}
+}
+
+/*
+* The function: runSimulator
+*
+* The function runs the machine from its PC until stop, an error, or the limit of the amount of instructions.
+*
+* Parameters:
+*	sim - a pointer to the machine.
+*	max_steps - the limit of the amount of instructions.
+*/
+void runSimulator(simulator* sim, long max_steps)
+{
+	simInstruction *instruction;/*The record of the current instruction*/
+	char *error;/*The error of decoding the instruction*/
+
+	while(sim->state == SIM_RUNNING){
+		sim->address = sim->pc;
+		if(sim->pc >= MEMORY_SIZE){
+			simError(sim, "the PC left the memory");
+			break;
+		}
+		instruction = &sim->decoded[sim->pc];
+		if(!instruction->valid && (error = decodeSimInstruction(sim, sim->pc))){
+			simError(sim, error);
+			break;
+		}
+		if(sim->steps == max_steps){
+			simError(sim, "the limit of the amount of instructions was reached");
+			break;
+		}
+		sim->steps++;
+		sim->pc = instruction->next;
+		instruction->handler(sim, instruction);
+	}
+}
+
+/*
+* The function: simError
+*
+* The function stops the machine with an error, and prints the error with the address of the current instruction.
+*
+* Parameters:
+*	sim - a pointer to the machine.
+*	message - the description of the error.
+*
+* Returns:
+*	FALSE.
+*/
+char simError(simulator* sim, char* message)
+{
+	fflush(stdout);
+	fprintf(stderr, "--- Error: at address %04d after %ld instructions: %s. ---\n", sim->address, sim->steps, message);
+	sim->state = SIM_ERROR;
+	return FALSE;
+}
+
+/*
+* The function: simOperand
+*
+* The function returns the cell of an operand: the memory cell whose address is in the register for *rX, and the
+* register, the memory cell or the value of the record otherwise.
+*
+* Parameters:
+*	sim - a pointer to the machine.
+*	slot - the operand of the record.
+*	indirect - TRUE if the operand is *rX.
+*
+* Returns:
+*	A pointer to the cell of the operand.
+*/
+short* simOperand(simulator* sim, short* slot, char indirect)
+{
+	if(!indirect)
+		return slot;
+	if(*slot >= MEMORY_SIZE){
+		simError(sim, "the address in the register is outside the memory");
+		return &sim->scratch;
+	}
+	return &sim->memory[*slot];
+}
+
+/*
+* The function: simWrite
+*
+* The function writes a value to the cell of a target operand, and sets the flags by the value. A write to a memory
+* cell clears the dispatch records of the instructions that may include the cell.
+*
+* Parameters:
+*	sim - a pointer to the machine.
+*	cell - the cell of the target operand.
+*	value - the value, it is cut to the 15 bits of the machine.
+*	set_flags - TRUE if the flags should be set by the value.
+*/
+void simWrite(simulator* sim, short* cell, long value, char set_flags)
+{
+	long address = cell - sim->memory;/*The address of the cell, if it is a memory cell*/
+	short i;/*Counter*/
+
+	*cell = (short)(value & WORD_MASK);
+	if(set_flags)
+		sim->psw = (short)((*cell ? 0 : SIM_ZERO_FLAG) | ((*cell & SIGN_BIT) ? SIM_NEGATIVE_FLAG : 0));
+	if(address >= 0 && address < MEMORY_SIZE){
+		for(i = 0; i < SIM_MAX_INSTRUCTION_WORDS && address - i >= 0; i++)
+			sim->decoded[address - i].valid = FALSE;
+	}
+}
+
+/*
+* The function: simJump
+*
+* The function moves the PC to the target of a jump.
+*
+* Parameters:
+*	sim - a pointer to the machine.
+*	address - the address of the target.
+*/
+void simJump(simulator* sim, short address)
+{
+	if(address >= MEMORY_SIZE)
+		simError(sim, "the target of the jump is outside the memory");
+	else
+		sim->pc = address;
+}
+
+/*
+* The functions of the opcodes: every function runs an instruction of its opcode, with the operands of its record.
+*
+* Parameters:
+*	sim - a pointer to the machine.
+*	instruction - the record of the instruction.
+*/
+void simMov(simulator* sim, simInstruction* instruction)
+{
+	short value = *simOperand(sim, instruction->source, instruction->source_indirect);/*The value of the source*/
+
+	simWrite(sim, simOperand(sim, instruction->target, instruction->target_indirect), value, FALSE);
+}
+
+void simCmp(simulator* sim, simInstruction* instruction)
+{
+	long value = *simOperand(sim, instruction->source, instruction->source_indirect) - (long)*simOperand(sim, instruction->target, instruction->target_indirect);/*source - target*/
+
+	value &= WORD_MASK;
+	sim->psw = (short)((value ? 0 : SIM_ZERO_FLAG) | ((value & SIGN_BIT) ? SIM_NEGATIVE_FLAG : 0));
+}
+
+void simAdd(simulator* sim, simInstruction* instruction)
+{
+	short value = *simOperand(sim, instruction->source, instruction->source_indirect);/*The value of the source*/
+	short *target = simOperand(sim, instruction->target, instruction->target_indirect);/*The cell of the target*/
+
+	simWrite(sim, target, (long)*target + value, TRUE);
+}
+
+void simSub(simulator* sim, simInstruction* instruction)
+{
+	short value = *simOperand(sim, instruction->source, instruction->source_indirect);/*The value of the source*/
+	short *target = simOperand(sim, instruction->target, instruction->target_indirect);/*The cell of the target*/
+
+	simWrite(sim, target, (long)*target - value, TRUE);
+}
+
+void simLea(simulator* sim, simInstruction* instruction)
+{
+	simWrite(sim, simOperand(sim, instruction->target, instruction->target_indirect), *instruction->source, FALSE);
+}
+
+void simClr(simulator* sim, simInstruction* instruction)
+{
+	simWrite(sim, simOperand(sim, instruction->target, instruction->target_indirect), 0, TRUE);
+}
+
+void simNot(simulator* sim, simInstruction* instruction)
+{
+	short *target = simOperand(sim, instruction->target, instruction->target_indirect);/*The cell of the target*/
+
+	simWrite(sim, target, ~(long)*target, TRUE);
+}
+
+void simInc(simulator* sim, simInstruction* instruction)
+{
+	short *target = simOperand(sim, instruction->target, instruction->target_indirect);/*The cell of the target*/
+
+	simWrite(sim, target, (long)*target + 1, TRUE);
+}
+
+void simDec(simulator* sim, simInstruction* instruction)
+{
+	short *target = simOperand(sim, instruction->target, instruction->target_indirect);/*The cell of the target*/
+
+	simWrite(sim, target, (long)*target - 1, TRUE);
+}
+
+void simJmp(simulator* sim, simInstruction* instruction)
+{
+	simJump(sim, *instruction->target);
+}
+
+void simBne(simulator* sim, simInstruction* instruction)
+{
+	if(!(sim->psw & SIM_ZERO_FLAG))
+		simJump(sim, *instruction->target);
+}
+
+void simRed(simulator* sim, simInstruction* instruction)
+{
+	int c = getchar();/*The next character of the input*/
+
+	simWrite(sim, simOperand(sim, instruction->target, instruction->target_indirect), (c == EOF) ? -1 : c, FALSE);
+}
+
+void simPrn(simulator* sim, simInstruction* instruction)
+{
+	printf("%ld\n", signedWord(*simOperand(sim, instruction->target, instruction->target_indirect)));
+}
+
+void simJsr(simulator* sim, simInstruction* instruction)
+{
+	if(sim->stack_used == SIM_STACK_SIZE){
+		simError(sim, "the stack of the return addresses is full");
+		return;
+	}
+	sim->stack[sim->stack_used++] = sim->pc;
+	simJump(sim, *instruction->target);
+}
+
+void simRts(simulator* sim, simInstruction* instruction)
+{
+	if(!sim->stack_used){
+		simError(sim, "rts without a return address");
+		return;
+	}
+	sim->pc = sim->stack[--sim->stack_used];
+}
+
+void simStop(simulator* sim, simInstruction* instruction)
+{
+	sim->state = SIM_STOPPED;
+}
+
+/*
+* The function: printSimRegisters
+*
+* The function prints the registers of the machine, as signed decimal numbers.
+*
+* Parameters:
+*	sim - a pointer to the machine.
+*/
+void printSimRegisters(simulator* sim)
+{
+	int i;/*Counter*/
+
+	for(i = 0; i < REGISTERS_AMOUNT; i++)
+		printf("r%d=%ld ", i, signedWord(sim->registers[i]));
+	printf("PC=%04d PSW=%d\n", sim->pc, sim->psw);
+}
+
+/********************************************************************** - END OF SIMULATOR - **********************************************************************/
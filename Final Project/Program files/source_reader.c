@@ -0,0 +1,190 @@
+#include "headers.h"
+
+/*
+* FILE: source_reader.c
+*
+* This file includes the functions of the reader of the input (.as) file.
+* The whole file is mapped to the memory with mmap (or read to one buffer with read, when the input can not be mapped,
+* for example a pipe), and the lines are handed out as views: a pointer to the start of the line in the file and its length.
+* The views stay valid until the file is closed, so the pre processor keeps the lines of the expanded source and the
+* commands of the macros as views to the file, instead of copying every line.
+*
+*/
+
+/*
+* The function: sourceOpen
+*
+* The function opens an input file and maps all of its content to the memory.
+*
+* Parameters:
+*	input_file - a pointer to the reader of the file.
+*	input_file_name - the name of the file.
+*
+* Returns:
+*	TRUE - if the file is ready for reading.
+*	FALSE - if the file could not be opened.
+*	FATAL_ERROR - if a memory allocation failure occurred.
+*/
+char sourceOpen(sourceFile* input_file, char* input_file_name)
+{
+	int fd;/*The file descriptor of the file*/
+	struct stat file_stat;/*The information of the file*/
+	char indicator;/*The result of reading the file*/
+
+	input_file->text = NULL;
+	input_file->length = 0;
+	input_file->position = 0;
+	input_file->is_mapped = FALSE;
+	input_file->lines_amount = 0;
+
+	if((fd = open(input_file_name, O_RDONLY)) < 0)
+		return FALSE;
+
+	/*A regular file is mapped, an empty file has nothing to map*/
+	if(!fstat(fd, &file_stat) && S_ISREG(file_stat.st_mode)){
+		if(!file_stat.st_size){
+			close(fd);
+			return TRUE;
+		}
+		input_file->text = (char*)mmap(NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(input_file->text != (char*)MAP_FAILED){
+			input_file->length = (size_t)file_stat.st_size;
+			input_file->is_mapped = TRUE;
+			close(fd);
+			return TRUE;
+		}
+		input_file->text = NULL;
+	}
+
+	indicator = sourceReadAll(input_file, fd);
+	close(fd);
+	return indicator;
+}
+
+/*
+* The function: sourceReadAll
+*
+* The function reads all the content of a file that could not be mapped into one buffer.
+*
+* Parameters:
+*	input_file - a pointer to the reader of the file.
+*	fd - the file descriptor of the file.
+*
+* Returns:
+*	TRUE - if the file was read.
+*	FALSE - if there was an error reading the file.
+*	FATAL_ERROR - if a memory allocation failure occurred.
+*/
+char sourceReadAll(sourceFile* input_file, int fd)
+{
+	size_t size = 0;/*The allocated size of the buffer*/
+	ssize_t length;/*The amount of bytes that were read by the last call*/
+	char *temp_text;/*The buffer after reallocation*/
+
+	while(TRUE){
+		if(input_file->length == size){/*Enlarge the buffer*/
+			size = size ? size*2 : SOURCE_BUFFER_SIZE;
+			if(!(temp_text = (char*)realloc(input_file->text, size))){
+				sourceClose(input_file);
+				return FATAL_ERROR;
+			}
+			input_file->text = temp_text;
+		}
+		length = read(fd, input_file->text + input_file->length, size - input_file->length);
+		if(!length)/*End of file*/
+			return TRUE;
+		if(length < 0){
+			if(errno == EINTR)
+				continue;
+			sourceClose(input_file);
+			return FALSE;
+		}
+		input_file->length += length;
+	}
+}
+
+/*
+* The function: sourceNextLine
+*
+* The function hands out the next line of the file as a view, the view includes the '\n' at the end of the line
+* (the last line of the file may have no '\n').
+*
+* Parameters:
+*	input_file - a pointer to the reader of the file.
+*	line - a pointer to the view that receives the line.
+*
+* Returns:
+*	TRUE - if a line was read.
+*	FALSE - if the end of the file was reached.
+*/
+char sourceNextLine(sourceFile* input_file, lineView* line)
+{
+	char *end;/*The end of the line*/
+	size_t remain = input_file->length - input_file->position;/*The amount of characters that were not read yet*/
+
+	if(!remain)
+		return FALSE;
+
+	line->start = input_file->text + input_file->position;
+	end = (char*)memchr(line->start, '\n', remain);
+	line->length = end ? (size_t)(end - line->start) + 1 : remain;
+	input_file->position += line->length;
+	line->number = (unsigned int)++input_file->lines_amount;
+	return TRUE;
+}
+
+/*
+* The function: sourceClose
+*
+* The function releases the content of the file, all the views to the file are not valid anymore.
+*
+* Parameters:
+*	input_file - a pointer to the reader of the file.
+*/
+void sourceClose(sourceFile* input_file)
+{
+	if(input_file->is_mapped)
+		munmap(input_file->text, input_file->length);
+	else
+		free(input_file->text);
+	input_file->text = NULL;
+	input_file->length = 0;
+	input_file->position = 0;
+	input_file->is_mapped = FALSE;
+}
+
+/*
+* The function: viewToLine
+*
+* The function copies a line view to a line buffer, like fgets does: at most MAX_LENGTH_OF_LINE-1 characters are copied,
+* so a line that is too long is cut, and it is detected by isValidLine.
+*
+* Parameters:
+*	view - the view of the line.
+*	line - the buffer of the line, at least MAX_LENGTH_OF_LINE characters.
+*/
+void viewToLine(lineView view, char* line)
+{
+	size_t length = (view.length < MAX_LENGTH_OF_LINE-1) ? view.length : MAX_LENGTH_OF_LINE-1;/*The amount of characters to copy*/
+
+	memcpy(line, view.start, length);
+	line[length] = '\0';
+}
+
+/*
+* The function: skipViewWhiteChar
+*
+* The function moves the start of a line view to the first non-white character, like skipWhiteChar does for a line.
+*
+* Parameters:
+*	view - a pointer to the view of the line.
+*/
+void skipViewWhiteChar(lineView* view)
+{
+	while(view->length && isspace((unsigned char)*view->start)){
+		view->start++;
+		view->length--;
+	}
+}
+
+/******************************************************************** - END OF SOURCE READER - ********************************************************************/
@@ -0,0 +1,239 @@
+#include "headers.h"
+
+/*
+* FILE: symbol_table.c
+*
+* This file includes the functions of the symbol table of the assembler.
+* The symbol table holds one record for every label name that was defined or declared in the file, the record holds
+* the type of the definition, if the label was declared as entry or as extern, and the decimal address of the label.
+* The names of the labels are kept in the name pool of the file, and the records are found by the id of the name in an
+* array, so defining a label, checking for duplicates and resolving a label in the second pass are done in O(1) expected
+* time, no matter how many labels the file has.
+*
+*/
+
+/*
+* The function: symbolTableInit
+*
+* The function initializes an empty symbol table.
+*
+* Parameters:
+*	table - a pointer to the symbol table to initialize.
+*	names - a pointer to the name pool of the file, that the names of the labels are kept in.
+*/
+void symbolTableInit(symbolTable* table, namePool* names)
+{
+	table->names = names;
+	table->symbols = NULL;
+	table->symbols_amount = 0;
+	table->symbols_size = 0;
+	table->by_name = NULL;
+	table->by_name_size = 0;
+	table->entries = NULL;
+	table->entries_amount = 0;
+	table->entries_size = 0;
+}
+
+/*
+* The function: findSymbol
+*
+* The function searches the symbol table for the record of a label name.
+*
+* Parameters:
+*	table - a pointer to the symbol table.
+*	name - the label name to search for.
+*
+* Returns:
+*	The index of the record of the label in the symbols array, or NO_SYMBOL if the label is not in the table.
+*/
+int findSymbol(symbolTable* table, char* name)
+{
+	int id = findName(table->names, name);/*The id of the name in the name pool*/
+
+	if(id == NO_NAME || id >= table->by_name_size)
+		return NO_SYMBOL;
+	return table->by_name[id];
+}
+
+/*
+* The function: growSymbolsByName
+*
+* The function enlarges the array of the records by the ids of the names, so it has a cell for the given id.
+*
+* Parameters:
+*	table - a pointer to the symbol table.
+*	id - the id of a name in the name pool.
+*
+* Returns:
+*	TRUE - if the array has a cell for the id.
+*	FALSE - if a memory allocation failure occurred.
+*/
+char growSymbolsByName(symbolTable* table, int id)
+{
+	int *new_by_name;/*The array after reallocation*/
+	int new_size = table->by_name_size ? table->by_name_size : SYMBOL_TABLE_SIZE;/*The size of the new array*/
+	int i;/*Counter*/
+
+	if(id < table->by_name_size)
+		return TRUE;
+	while(new_size <= id)
+		new_size *= 2;
+
+	new_by_name = (int*)realloc(table->by_name, sizeof(int) * new_size);
+	if(!new_by_name)
+		return FALSE;
+	for(i = table->by_name_size; i < new_size; i++)
+		new_by_name[i] = NO_SYMBOL;
+
+	table->by_name = new_by_name;
+	table->by_name_size = new_size;
+	return TRUE;
+}
+
+/*
+* The function: addSymbol
+*
+* The function returns the record of a label name, and creates a new empty record if the label is not in the table yet.
+*
+* Parameters:
+*	table - a pointer to the symbol table.
+*	name - the label name.
+*	file_arena - a pointer to the arena that a new name is copied to.
+*	error_str - a pointer to a buffer where an error message will be stored if memory allocation fails.
+*
+* Returns:
+*	The index of the record in the symbols array, or NO_SYMBOL if a memory allocation failure occurred.
+*/
+int addSymbol(symbolTable* table, char* name, arena* file_arena, char* error_str)
+{
+	int index;/*The index of the record*/
+	int id;/*The id of the name in the name pool*/
+	symbol *temp_symbols;/*The symbols array after reallocation*/
+
+	if((id = internName(table->names, name, file_arena, error_str)) == NO_NAME)
+		return NO_SYMBOL;
+	if(!growSymbolsByName(table, id)){
+		strcpy(error_str, "symbol table names");
+		return NO_SYMBOL;
+	}
+	if(table->by_name[id] != NO_SYMBOL)
+		return table->by_name[id];
+
+	if(table->symbols_amount == table->symbols_size){/*Enlarge the symbols array*/
+		table->symbols_size = table->symbols_size ? table->symbols_size*2 : SYMBOL_TABLE_SIZE;
+		temp_symbols = (symbol*)realloc(table->symbols, sizeof(symbol) * table->symbols_size);
+		if(!temp_symbols){
+			strcpy(error_str, "symbol table records");
+			return NO_SYMBOL;
+		}
+		table->symbols = temp_symbols;
+	}
+
+	index = table->symbols_amount;
+	table->symbols[index].name = table->names->names[id];
+	table->symbols[index].address = 0;
+	table->symbols[index].line = 0;
+	table->symbols[index].defined_type = NO_TYPE;
+	table->symbols[index].first_type = NO_TYPE;
+	table->symbols[index].is_entry = FALSE;
+	table->symbols[index].is_extern = FALSE;
+	table->symbols_amount++;
+	table->by_name[id] = index;
+
+	return index;
+}
+
+/*
+* The function: declareSymbol
+*
+* The function records a definition or a declaration of a label in the symbol table.
+* The function does not check for conflicts, it is done before by checkIfLabelNameAlreadyDeclared.
+*
+* Parameters:
+*	table - a pointer to the symbol table.
+*	name - the label name.
+*	type - the type of the line: DATA, STRING or CODE for a definition, ENTRY or EXTERN for a declaration.
+*	value - the IC\DC counter for a definition, or the line number for a declaration.
+*	file_arena - a pointer to the arena that a new name is copied to.
+*	error_str - a pointer to a buffer where an error message will be stored if memory allocation fails.
+*
+* Returns:
+*	TRUE - if the label was recorded.
+*	FATAL_ERROR - if a memory allocation failure occurred.
+*/
+char declareSymbol(symbolTable* table, char* name, char type, short value, arena* file_arena, char* error_str)
+{
+	int index;/*The index of the record of the label*/
+	symbol *record;/*The record of the label*/
+	int *temp_entries;/*The entries array after reallocation*/
+
+	if((index = addSymbol(table, name, file_arena, error_str)) == NO_SYMBOL)
+		return FATAL_ERROR;
+	record = &table->symbols[index];
+
+	if(record->first_type == NO_TYPE)
+		record->first_type = type;
+
+	if(type == EXTERN){
+		if(!record->is_extern)
+			record->line = value;
+		record->is_extern = TRUE;
+	}
+	else if(type == ENTRY){
+		if(!record->is_entry){/*The entries are kept in the order of their first declaration, for the .ent file*/
+			if(table->entries_amount == table->entries_size){
+				table->entries_size = table->entries_size ? table->entries_size*2 : SYMBOL_TABLE_SIZE;
+				temp_entries = (int*)realloc(table->entries, sizeof(int) * table->entries_size);
+				if(!temp_entries){
+					strcpy(error_str, "symbol table entries");
+					return FATAL_ERROR;
+				}
+				table->entries = temp_entries;
+			}
+			table->entries[table->entries_amount++] = index;
+			record->line = value;
+		}
+		record->is_entry = TRUE;
+	}
+	else{
+		record->defined_type = type;
+		record->address = value;
+	}
+	return TRUE;
+}
+
+/*
+* The function: resetSymbolTable
+*
+* The function empties the symbol table, and keeps its arrays for the labels of the next file.
+*
+* Parameters:
+*	table - a pointer to the symbol table.
+*/
+void resetSymbolTable(symbolTable* table)
+{
+	int i;/*Counter*/
+
+	for(i = 0; i < table->by_name_size; i++)
+		table->by_name[i] = NO_SYMBOL;
+	table->symbols_amount = 0;
+	table->entries_amount = 0;
+}
+
+/*
+* The function: freeSymbolTable
+*
+* The function releases the arrays of the symbol table (the names belong to the name pool of the file).
+*
+* Parameters:
+*	table - a pointer to the symbol table.
+*/
+void freeSymbolTable(symbolTable* table)
+{
+	free(table->symbols);
+	free(table->by_name);
+	free(table->entries);
+	symbolTableInit(table, table->names);
+}
+
+/******************************************************************** - END OF SYMBOL TABLE - ********************************************************************/
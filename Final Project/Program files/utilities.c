@@ -10,87 +10,305 @@
 
 /***************************************************************** - RESERVED KEYWORD FUNCTIONS - *****************************************************************/
 
+/* The reserved words of the assembler, every word with its kind and its number (opcode number, register number or instruction type). */
+static reservedWord reserved_words[] = {
+	{"mov", OPCODE_WORD, MOV}, {"cmp", OPCODE_WORD, CMP}, {"add", OPCODE_WORD, ADD}, {"sub", OPCODE_WORD, SUB},
+	{"lea", OPCODE_WORD, LEA}, {"clr", OPCODE_WORD, CLR}, {"not", OPCODE_WORD, NOT}, {"inc", OPCODE_WORD, INC},
+	{"dec", OPCODE_WORD, DEC}, {"jmp", OPCODE_WORD, JMP}, {"bne", OPCODE_WORD, BNE}, {"red", OPCODE_WORD, RED},
+	{"prn", OPCODE_WORD, PRN}, {"jsr", OPCODE_WORD, JSR}, {"rts", OPCODE_WORD, RTS}, {"stop", OPCODE_WORD, STOP},
+	{"r0", REGISTER_WORD, 0}, {"r1", REGISTER_WORD, 1}, {"r2", REGISTER_WORD, 2}, {"r3", REGISTER_WORD, 3},
+	{"r4", REGISTER_WORD, 4}, {"r5", REGISTER_WORD, 5}, {"r6", REGISTER_WORD, 6}, {"r7", REGISTER_WORD, 7},
+	{"PSW", REGISTER_WORD, 8}, {"PC", REGISTER_WORD, 9},
+	{".data", INSTRUCTION_WORD, DATA}, {".string", INSTRUCTION_WORD, STRING},
+	{".entry", INSTRUCTION_WORD, ENTRY}, {".extern", INSTRUCTION_WORD, EXTERN}
+};
+
+/* The operands of every opcode: their amount, and the addressing types that the source and the target may have (a bit for every type),
+ * and whether the instruction sets the flags of the PSW by its result. */
+static opcodeRule opcode_rules[] = {
+	{2, ANY_ADDRESSING, WRITABLE_ADDRESSING, FALSE}, {2, ANY_ADDRESSING, ANY_ADDRESSING, TRUE}, {2, ANY_ADDRESSING, WRITABLE_ADDRESSING, TRUE},
+	{2, ANY_ADDRESSING, WRITABLE_ADDRESSING, TRUE}, {2, 1 << DIRECT_ADDRESSING, WRITABLE_ADDRESSING, FALSE},
+	{1, 0, WRITABLE_ADDRESSING, TRUE}, {1, 0, WRITABLE_ADDRESSING, TRUE}, {1, 0, WRITABLE_ADDRESSING, TRUE}, {1, 0, WRITABLE_ADDRESSING, TRUE},
+	{1, 0, JUMP_ADDRESSING, FALSE}, {1, 0, JUMP_ADDRESSING, FALSE}, {1, 0, WRITABLE_ADDRESSING, FALSE}, {1, 0, ANY_ADDRESSING, FALSE},
+	{1, 0, JUMP_ADDRESSING, FALSE}, {0, 0, 0, FALSE}, {0, 0, 0, FALSE}
+};
+
 /*
-* The function: isOpcode
+* The function: hashReservedWord
 *
-* The function checks if the provided string matches any of the predefined opcodes. 
+* The function calculates the slot of a word in the reserved words hash table.
+* The hash uses the length, the first two characters and the last character of the word, its constants were
+* found by a search so that every reserved word gets a slot of its own (a perfect hash), so a lookup needs
+* a single probe and a single string comparison. The constants must be searched again if a word is added to the table,
+* findReservedWord stops the program if two words get the same slot.
 *
 * Parameters:
-*   word - A pointer to a string containing the word to be checked.
+*   word - A pointer to the word, at least 2 characters long.
+*   length - The length of the word.
 *
 * Returns:
-*   The index of the matched opcode which represents the opcode number.
-*   NO_OPCODE if the provided word does not match any of the predefined opcodes.
+*   The slot of the word, between 0 and RESERVED_WORDS_SLOTS-1.
 */
-short isOpcode(char* word)
+short hashReservedWord(char* word, short length)
 {
-	short i = 0; /* Index for iterating through the opcodes array. */
-	/* The list of the opcodes that defined in the system. */
-	const char *opcodes[] = {"mov", "cmp", "add", "sub", "lea", "clr", "not", "inc", "dec", "jmp", "bne", "red", "prn", "jsr", "rts", "stop", '\0'};
-		
-	/* Iterate through the opcodes array to find a match. */
-	while(opcodes[i]){
-		if(!strcmp(word, opcodes[i]))
-			return i;
-		i++;	
-	}
-	return NO_OPCODE;
+	return (short)((length + (unsigned char)word[0] + 12*(unsigned char)word[1] + 21*(unsigned char)word[length-1]) & (RESERVED_WORDS_SLOTS-1));
 }
 
 /*
-* The function: isRegister
+* The function: findReservedWord
 *
-* The function checks if the provided string matches any of the predefined registers.
+* The function checks if the provided string is one of the reserved words of the assembler (an opcode, a register or an instruction).
+* The hash table of the reserved words is built from the reserved words table on the first call. If two reserved words
+* get the same slot one of them could not be found, so the program is stopped (the constants of hashReservedWord must
+* be searched again).
 *
 * Parameters:
 *   word - A pointer to a string containing the word to be checked.
 *
 * Returns:
-*   The index of the matched register which represents the register number.
-*   NO_REGISTER if the provided word does not match any of the predefined registers.
+*   A pointer to the entry of the word in the reserved words table, or NULL if the word is not a reserved word.
 */
-short isRegister(char* word)
+reservedWord* findReservedWord(char* word)
 {
-	short i = 0; /* Index for iterating through the registers array. */
-	/* The list of registers that defined in the system. */
-	const char *registers[] = {"r0", "r1", "r2", "r3", "r4", "r5", "r6", "r7", "PSW", "PC", '\0'};
+	static signed char slots[RESERVED_WORDS_SLOTS]; /* Every slot holds an index in the reserved words table or NO_RESERVED_WORD. */
+	static char slots_ready = FALSE; /* TRUE after the hash table was built. */
+	short length = 0; /* The length of the word. */
+	short slot; /* The slot of a reserved word. */
+	short i; /* Counter. */
 	
-	/* Iterate through the registers array to find a match. */
-	while(registers[i]){
-		if(!strcmp(word, registers[i]))
-			return i;
-		i++;	
+	if(!slots_ready){ /* Building the hash table. */
+		for(i = 0; i < RESERVED_WORDS_SLOTS; i++)
+			slots[i] = NO_RESERVED_WORD;
+		for(i = 0; i < (short)(sizeof(reserved_words)/sizeof(reserved_words[0])); i++){
+			slot = hashReservedWord(reserved_words[i].name, (short)strlen(reserved_words[i].name));
+			if(slots[slot] != NO_RESERVED_WORD){
+				printf("--- Internal error: the reserved words %s and %s have the same hash slot. ---\n", reserved_words[slots[slot]].name, reserved_words[i].name);
+				exit(EXIT_FAILURE);
+			}
+			slots[slot] = (signed char)i;
+		}
+		slots_ready = TRUE;
 	}
-	return NO_REGISTER;
+	
+	/* Words that are shorter or longer than all the reserved words are rejected without reading them to the end. */
+	while(word[length] && length <= MAX_RESERVED_WORD_LENGTH)
+		length++;
+	if(length < MIN_RESERVED_WORD_LENGTH || length > MAX_RESERVED_WORD_LENGTH)
+		return NULL;
+	
+	i = slots[hashReservedWord(word, length)];
+	if(i == NO_RESERVED_WORD || strcmp(word, reserved_words[i].name))
+		return NULL;
+	return &reserved_words[i];
 }
 
 /*
-* The function: isInstruction
+* The function: getReservedWordId
 *
-* The function checks if the provided string matches any of the predefined instruction types.
+* The function checks if the provided string is a reserved word of the given kind.
 *
 * Parameters:
 *   word - A pointer to a string containing the word to be checked.
+*   kind - The kind of the reserved word: OPCODE_WORD, REGISTER_WORD or INSTRUCTION_WORD.
 *
 * Returns:
-*   The index of the matched instruction type which represents the instruction number.
-*   NO_TYPE if the provided word does not match any of the predefined instruction types.
+*   The number of the reserved word (the opcode number, the register number or the instruction type).
+*   -1 (NO_OPCODE, NO_REGISTER or NO_TYPE) if the word is not a reserved word of the given kind.
 */
-short isInstruction(char* word)
+short getReservedWordId(char* word, char kind)
 {
-	short i = 0; /* Index for iterating through the instructions array. */
-	/* The list of instruction types that defined in the system. */
-	const char *instructions[] = {".data", ".string", ".entry", ".extern", '\0'};
+	reservedWord *reserved = findReservedWord(word); /* The entry of the word in the reserved words table. */
 	
-	/* Iterate through the instructions array to find a match. */
-	while(instructions[i]){
-		if(!strcmp(word, instructions[i]))
-			return i;
-		i++;	
+	if(!reserved || reserved->kind != kind)
+		return -1;
+	return reserved->id;
+}
+
+/*
+* The function: getOpcodeName
+*
+* The function returns the name of an opcode.
+*
+* Parameters:
+*   opcode - The number of the opcode.
+*
+* Returns:
+*   A pointer to the name of the opcode.
+*/
+char* getOpcodeName(short opcode)
+{
+	return reserved_words[opcode].name;
+}
+
+/*
+* The function: getOpcodeRule
+*
+* The function returns the operands rule of an opcode, the same rules that the first pass checks.
+*
+* Parameters:
+*   opcode - The number of the opcode.
+*
+* Returns:
+*   A pointer to the rule of the opcode.
+*/
+opcodeRule* getOpcodeRule(short opcode)
+{
+	return &opcode_rules[opcode];
+}
+
+/*
+* The function: decodeOperandType
+*
+* The function returns the addressing type of an operand from its bits in the first word of an instruction (a bit for every type).
+*
+* Parameters:
+*   bits - The 4 bits of the operand.
+*
+* Returns:
+*   The addressing type, or NO_TYPE if no bit or more than one bit is set.
+*/
+short decodeOperandType(short bits)
+{
+	short type;/*The current type*/
+
+	for(type = IMMEDIATE_ADDRESSING; type <= DIRECT_REGISTER_ADDRESSING; type++){
+		if(bits == (1 << type))
+			return type;
 	}
 	return NO_TYPE;
 }
 
+/*
+* The function: decodeFirstWord
+*
+* The function decodes the first word of an instruction with the fields that the encoder uses, and checks it against
+* the operands rule of its opcode.
+*
+* Parameters:
+*   word - The first word of the instruction.
+*   opcode - A pointer to where the opcode will be stored.
+*   types - An array where the addressing types of the source and the target will be stored (NO_TYPE for a missing operand).
+*
+* Returns:
+*   TRUE - if the word is the first word of a valid instruction.
+*   FALSE - otherwise.
+*/
+char decodeFirstWord(short word, short* opcode, short* types)
+{
+	opcodeRule *rule;/*The operands rule of the opcode*/
+	short bits[2];/*The bits of the source and the target*/
+	short i;/*Counter*/
+
+	*opcode = (short)((word >> OPCODE_START_POSITION) & (OPCODES_AMOUNT-1));
+	rule = getOpcodeRule(*opcode);
+	bits[0] = (short)((word >> SOURCE_START_POSITION) & TYPES_MASK);
+	bits[1] = (short)((word >> TARGET_START_POSITION) & TYPES_MASK);
+	if((word & ARE_MASK) != (1 << A_ADDRESSING_METHOD))
+		return FALSE;
+
+	/*The target is the operand of an instruction with one operand*/
+	for(i = 0; i < 2; i++){
+		types[i] = decodeOperandType(bits[i]);
+		if(rule->operands_amount > 1-i){
+			if(types[i] == NO_TYPE || !((i ? rule->target_types : rule->source_types) & (1 << types[i])))
+				return FALSE;
+		}
+		else if(bits[i])
+			return FALSE;
+	}
+	return TRUE;
+}
+
+/*
+* The function: decodeOperandWord
+*
+* The function decodes the word of an operand, with the 'A', 'R' and 'E' bits that the encoder gives to its type.
+*
+* Parameters:
+*   word - The word of the operand (the shared word of two registers is decoded once for every register).
+*   type - The addressing type of the operand.
+*   operand - 0 for the source operand, 1 for the target operand.
+*   value - A pointer to where the value will be stored: the number, the address of the label (0 for an extern label) or the register.
+*
+* Returns:
+*   The 'A', 'R' or 'E' bit of the word, or 0 if the word is not valid for the type.
+*/
+short decodeOperandWord(short word, short type, short operand, short* value)
+{
+	short are = (short)(word & ARE_MASK);/*The 'A', 'R' and 'E' bits*/
+
+	if(type == DIRECT_ADDRESSING){
+		if(are != (1 << R_ADDRESSING_METHOD) && are != (1 << E_ADDRESSING_METHOD))
+			return 0;
+		*value = (short)((word >> ADDRESS_START_POSITION) & ADDRESS_MASK);
+		return are;
+	}
+	if(are != (1 << A_ADDRESSING_METHOD))
+		return 0;
+	if(type == IMMEDIATE_ADDRESSING){/*The value is 12 bits, it is extended to the 15 bits of the machine*/
+		*value = (short)((word >> ADDRESS_START_POSITION) & ADDRESS_MASK);
+		if(*value & IMMEDIATE_SIGN_BIT)
+			*value |= WORD_MASK & ~ADDRESS_MASK;
+	}
+	else
+		*value = (short)((word >> (operand ? TARGET_REGISTER_START_POSITION : SOURCE_REGISTER_START_POSITION)) & REGISTER_MASK);
+	return are;
+}
+
+/*
+* The function: instructionLength
+*
+* The function returns the amount of words of an instruction: the first word and a word for every operand, but two
+* register operands share one word.
+*
+* Parameters:
+*   types - The addressing types of the source and the target (NO_TYPE for a missing operand).
+*
+* Returns:
+*   The amount of words.
+*/
+short instructionLength(short* types)
+{
+	return (short)(1 + operandWordOffset(types, 1) - (types[1] == NO_TYPE));
+}
+
+/*
+* The function: operandWordOffset
+*
+* The function returns the place of the word of an operand in its instruction, after the first word. The word of the
+* target comes after the word of the source, unless both operands are registers and they share one word.
+*
+* Parameters:
+*   types - The addressing types of the source and the target (NO_TYPE for a missing operand).
+*   operand - 0 for the source operand, 1 for the target operand.
+*
+* Returns:
+*   The offset of the word from the first word of the instruction.
+*/
+short operandWordOffset(short* types, short operand)
+{
+	if(!operand || types[0] == NO_TYPE)
+		return 1;
+	if(types[0] >= INDIRECT_REGISTER_ADDRESSING && types[1] >= INDIRECT_REGISTER_ADDRESSING)/*Two registers share one word*/
+		return 1;
+	return 2;
+}
+
+/*
+* The function: signedWord
+*
+* The function returns the signed value of a machine word.
+*
+* Parameters:
+*   word - The word, 15 bits in two's complement.
+*
+* Returns:
+*   The value.
+*/
+long signedWord(short word)
+{
+	return (word & SIGN_BIT) ? (long)word - (WORD_MASK + 1) : (long)word;
+}
 
 /*
 * The function: isValidName
@@ -108,22 +326,19 @@ short isInstruction(char* word)
 */
 char isValidName(char* name, char* error_str)
 {	
-	/* Check if the name is used as an opcode. */
-	if(isOpcode(name) != NO_OPCODE){
+	reservedWord *reserved = findReservedWord(name); /* The entry of the name in the reserved words table. */
+	
+	if(!reserved)
+		return TRUE;
+	
+	/* The name is used as an opcode, a register or an instruction. */
+	if(reserved->kind == OPCODE_WORD)
 		sprintf(error_str, "the word: %s is used as an opcode.", name);
-		return FALSE;
-	}
-	/* Check if the name is used as a register. */
-	if(isRegister(name) != NO_REGISTER){
+	else if(reserved->kind == REGISTER_WORD)
 		sprintf(error_str, "the word: %s is used as an register.", name);
-		return FALSE;
-	}
-	/* Check if the name is used as an instruction. */
-	if(isInstruction(name) != NO_TYPE){
+	else
 		sprintf(error_str, "the word: %s is used as an instruction.", name);
-		return FALSE;
-	}
-	return TRUE;
+	return FALSE;
 }
 
 /**************************************************************** - STRING MANIPULATION FUNCTIONS - ****************************************************************/
@@ -226,68 +441,121 @@ void getWord(char* line, char* word)
 */
 void continueTo(char* line, short i)
 {
-	char temp[MAX_LENGTH_OF_LINE]; /* A temporary buffer to store the modified line. */
-	
 	if(i < 1)
 		return; /* Return without modifying if the index is less than 1. */
 	
-	strcpy(temp, line+i); /* Copy the portion of the line starting from index i to the temporary buffer. */
-	strcpy(line, temp);	/* Copy the modified string back to the original line. */
+	memmove(line, line+i, strlen(line+i)+1); /* Move the portion of the line starting from index i (and its null terminator) to the start of the line. */
 }
 
 /********************************************************************* - BITWISE FUNCTIONS - *********************************************************************/
 
+/*
+* The fields of a machine word, every field is shifted to its place in the 15 bits word in advance,
+* so encoding a word is only an or of the fields.
+*/
+static const short opcode_fields[] = {
+	MOV << OPCODE_START_POSITION, CMP << OPCODE_START_POSITION, ADD << OPCODE_START_POSITION, SUB << OPCODE_START_POSITION,
+	LEA << OPCODE_START_POSITION, CLR << OPCODE_START_POSITION, NOT << OPCODE_START_POSITION, INC << OPCODE_START_POSITION,
+	DEC << OPCODE_START_POSITION, JMP << OPCODE_START_POSITION, BNE << OPCODE_START_POSITION, RED << OPCODE_START_POSITION,
+	PRN << OPCODE_START_POSITION, JSR << OPCODE_START_POSITION, RTS << OPCODE_START_POSITION, STOP << OPCODE_START_POSITION
+};
+static const short source_type_fields[] = {
+	1 << (SOURCE_START_POSITION + IMMEDIATE_ADDRESSING), 1 << (SOURCE_START_POSITION + DIRECT_ADDRESSING),
+	1 << (SOURCE_START_POSITION + INDIRECT_REGISTER_ADDRESSING), 1 << (SOURCE_START_POSITION + DIRECT_REGISTER_ADDRESSING)
+};
+static const short target_type_fields[] = {
+	1 << (TARGET_START_POSITION + IMMEDIATE_ADDRESSING), 1 << (TARGET_START_POSITION + DIRECT_ADDRESSING),
+	1 << (TARGET_START_POSITION + INDIRECT_REGISTER_ADDRESSING), 1 << (TARGET_START_POSITION + DIRECT_REGISTER_ADDRESSING)
+};
+static const short source_register_fields[] = {
+	0 << SOURCE_REGISTER_START_POSITION, 1 << SOURCE_REGISTER_START_POSITION, 2 << SOURCE_REGISTER_START_POSITION, 3 << SOURCE_REGISTER_START_POSITION,
+	4 << SOURCE_REGISTER_START_POSITION, 5 << SOURCE_REGISTER_START_POSITION, 6 << SOURCE_REGISTER_START_POSITION, 7 << SOURCE_REGISTER_START_POSITION
+};
+static const short target_register_fields[] = {
+	0 << TARGET_REGISTER_START_POSITION, 1 << TARGET_REGISTER_START_POSITION, 2 << TARGET_REGISTER_START_POSITION, 3 << TARGET_REGISTER_START_POSITION,
+	4 << TARGET_REGISTER_START_POSITION, 5 << TARGET_REGISTER_START_POSITION, 6 << TARGET_REGISTER_START_POSITION, 7 << TARGET_REGISTER_START_POSITION
+};
+static const short are_fields[] = {1 << E_ADDRESSING_METHOD, 1 << R_ADDRESSING_METHOD, 1 << A_ADDRESSING_METHOD};
+
 /* 
-* The function: insertBinaryValueByKeyWords
+* The function: encodeFirstWord
 *
-* The function receive a value of a decimal number that represent saved key words (opcodes
-* and registers) and enter it's value inside the wanted bits on a short variable.
+* The function encodes the first word of an instruction: the opcode, the addressing types of the operands and the 'A' bit.
 * 
 * Parameters:
-*	decimal_value - number that represent the value we want to enter.
-*	bmc - a pointer that represent the number that we would like to change.
-*	start - the index of the first bit that we want to change on variable num.
+*	opcode - the opcode number.
+*	source_operand_type - the addressing type of the source operand, or NO_TYPE if there is no source operand.
+*	target_operand_type - the addressing type of the target operand, or NO_TYPE if there is no target operand.
+*
+* Returns:
+*	The binary machine code of the first word.
 */
-void insertBinaryValueByKeyWords(short decimal_value, short* bmc, short start)
+short encodeFirstWord(short opcode, short source_operand_type, short target_operand_type)
 {
-	short bit_position = (short)pow(2, start);/*represent the bit in the wanted index*/
-	for(; decimal_value; bit_position <<= ONE_BIT, decimal_value >>= ONE_BIT){
-		if(decimal_value & 01)
-			*bmc |= bit_position;
-	}
+	short bmc = opcode_fields[opcode] | are_fields[A_ADDRESSING_METHOD];/*The opcode and the 'A' bit*/
+	
+	if(source_operand_type != NO_TYPE)
+		bmc |= source_type_fields[source_operand_type];
+	if(target_operand_type != NO_TYPE)
+		bmc |= target_type_fields[target_operand_type];
+	return bmc;
 }
 
 /* 
-* The function: insertBinaryValueByData
+* The function: encodeRegisters
 *
-* The function receive a value of an integer decimal number and enter it's value inside the wanted
-* bits on a short variable.
+* The function encodes a word of register operands: the source register, the target register and the 'A' bit.
 * 
 * Parameters:
-*	decimal_value - number that represent the value we want to enter.
-*	bmc - a pointer that represent the number that we would like to change.
-*	start - the index of the first bit that we want to change on variable num.
+*	source_register - the number of the source register, or NO_REGISTER if there is no source register.
+*	target_register - the number of the target register, or NO_REGISTER if there is no target register.
+*
+* Returns:
+*	The binary machine code of the word.
 */
-void insertBinaryValueByData(short decimal_value, short* bmc, short start)
+short encodeRegisters(short source_register, short target_register)
 {
-	short decimal_with_start = (decimal_value << start);/*move the decimal number to left by the value of start*/
-	*bmc |= decimal_with_start;
-	*bmc &= (short)(pow(2,16)-1);/* turn off the 16 bit of short, which mean it keeps over only 15 bits of short*/	
+	short bmc = are_fields[A_ADDRESSING_METHOD];/*The 'A' bit*/
+	
+	/*A register field is 3 bits wide*/
+	if(source_register != NO_REGISTER)
+		bmc |= source_register_fields[source_register & REGISTER_MASK];
+	if(target_register != NO_REGISTER)
+		bmc |= target_register_fields[target_register & REGISTER_MASK];
+	return bmc;
 }
 
 /* 
-* The function: turnOnBit
+* The function: encodeOperand
 *
-* The function receive a number, and turn the value of the bit in the wanted index to 1.
+* The function encodes a word of an immediate number or an address, the value is kept in the 12 bits above the ARE bits.
 * 
 * Parameters:
-*	num - a pointer that represent the number that we would like to change.
-*	start - the index of the bit that we want to change on variable num.
+*	value - the number or the address.
+*	addressing_method - A_ADDRESSING_METHOD, R_ADDRESSING_METHOD or E_ADDRESSING_METHOD.
+*
+* Returns:
+*	The binary machine code of the word.
+*/
+short encodeOperand(short value, short addressing_method)
+{
+	return (short)((((unsigned short)value << OPERAND_START_POSITION) & WORD_MASK) | are_fields[addressing_method]);
+}
+
+/* 
+* The function: encodeData
+*
+* The function encodes a word of data, a negative number is kept in two's complement in the 15 bits of the word.
+* 
+* Parameters:
+*	value - the number.
+*
+* Returns:
+*	The binary machine code of the word.
 */
-void turnOnBit(short* num, short start)
+short encodeData(short value)
 {
-	short bit_position = (short)pow(2, start);/*represent the bit in the wanted index*/
-	*num |= bit_position;
+	return (short)(value & WORD_MASK);
 }
 
 /******************************************************************* - GENERAL FUNCTIONS - *******************************************************************/
@@ -295,33 +563,23 @@ void turnOnBit(short* num, short start)
 /* 
 * The function: mainGeneralFree
 *
-* The function receives the main variables of this program and check if they take memory in
-* the system,and if yes, it's free their memory.
+* The function receives the main variables of this program and free their memory.
+* All the nodes of the file (macros and the names of the labels and the macros) are released at once with the arena of the file.
 * 
 * Parameters:
-*	input_file - a pointer for the input file.
+*	input_file - a pointer for the reader of the input file.
 *	input_file_name -a pointer for the input file name. 
-*	macros_list - a pointer for the macros node list.
-*	declarations_list -a pointer for the declarations node list.
-*	data_list - a pointer for the data node list.
-*	instructions_list - a pointer for the instructions node list.
+*	workspace - a pointer for the tables of the file (the arena, the name pool, the tables, the lines and the memory image).
+*	keep_workspace - TRUE if the workspace is only emptied and its memory is kept for the next file (--server).
 */
-void mainGeneralFree(FILE* input_file, char* input_file_name, macroNode* macros_list, declarationNode* declarations_list, dataNode* data_list, instructionNode* instructions_list)    
+void mainGeneralFree(sourceFile* input_file, char* input_file_name, assemblerWorkspace* workspace, char keep_workspace)
 {
-	fclose(input_file);
+	sourceClose(input_file);
 	free(input_file_name);
-	
-	if(macros_list)
-		freeMacrosList(macros_list);
-	
-	if(declarations_list)
-		freeDeclarationsList(declarations_list);
-	
-	if(data_list)
-		freeDataList(data_list);
-	
-	if(instructions_list)
-		freeInstructionsList(instructions_list);
+	if(keep_workspace)
+		resetWorkspace(workspace);
+	else
+		freeWorkspace(workspace);
 }
 
 /*